@@ -0,0 +1,241 @@
+#include "ddl_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+#include <takatori/document/region.h>
+
+#include <takatori/statement/create_table.h>
+#include <takatori/statement/create_index.h>
+
+#include <takatori/util/downcast.h>
+#include <takatori/util/string_builder.h>
+
+#include <yugawara/binding/extract.h>
+
+#include <yugawara/storage/configurable_provider.h>
+#include <yugawara/storage/table.h>
+#include <yugawara/storage/index.h>
+
+#include <mizugaki/analyzer/sql_analyzer.h>
+
+#include "ddl_interpreter.h"
+
+namespace mizugaki::examples::explain_cli {
+
+using ::takatori::util::sequence_view;
+using ::takatori::util::string_builder;
+using ::takatori::util::unsafe_downcast;
+
+using result_kind = analyzer::sql_analyzer_result_kind;
+
+namespace {
+
+class engine {
+public:
+    engine(
+            sequence_view<std::unique_ptr<ast::statement::statement> const> statements,
+            ast::compilation_unit const& source,
+            analyzer::sql_analyzer_options const& options,
+            ::yugawara::variable::provider const& variables,
+            std::size_t threads) :
+        statements_ { statements },
+        source_ { source },
+        options_ { options },
+        variables_ { variables },
+        threads_ { std::max(threads, std::size_t { 1 }) },
+        results_ ( statements.size() )
+    {}
+
+    [[nodiscard]] std::vector<ddl_batch_entry> process() {
+        // tables never depend on the other statements in this batch
+        auto limit = statements_.size();
+        analyze_all(ast::statement::kind::table_definition, limit);
+        limit = apply_tables(limit);
+
+        // indexes may depend on the preceding tables in this batch
+        analyze_all(ast::statement::kind::index_definition, limit);
+        limit = apply_indices(limit);
+
+        std::vector<ddl_batch_entry> results {};
+        results.reserve(limit);
+        for (std::size_t index = 0; index < limit; ++index) {
+            results.push_back(std::move(results_[index]));
+        }
+        return results;
+    }
+
+private:
+    sequence_view<std::unique_ptr<ast::statement::statement> const> statements_;
+    ast::compilation_unit const& source_;
+    analyzer::sql_analyzer_options const& options_;
+    ::yugawara::variable::provider const& variables_;
+    std::size_t threads_;
+    std::vector<ddl_batch_entry> results_;
+
+    // the tables defined in this batch, and their statement positions
+    std::unordered_map<::yugawara::storage::table const*, std::size_t> defined_tables_ {};
+
+    [[nodiscard]] analyzer::sql_analyzer_result analyze(std::size_t index) const {
+        analyzer::sql_analyzer analyzer {};
+        return analyzer(options_, *statements_[index], source_, {}, variables_);
+    }
+
+    void analyze_all(ast::statement::kind kind, std::size_t limit) {
+        std::vector<std::size_t> targets {};
+        for (std::size_t index = 0; index < limit; ++index) {
+            if (statements_[index]->node_kind() == kind) {
+                targets.push_back(index);
+            }
+        }
+        std::atomic_size_t next { 0 };
+        auto worker = [&] {
+            // NOTE: each sql_analyzer instance is not thread-safe
+            analyzer::sql_analyzer analyzer {};
+            for (auto offset = next++; offset < targets.size(); offset = next++) {
+                auto index = targets[offset];
+                results_[index] = {
+                        analyzer(options_, *statements_[index], source_, {}, variables_),
+                        false,
+                };
+            }
+        };
+        auto thread_count = std::min(threads_, targets.size());
+        if (thread_count <= 1) {
+            worker();
+            return;
+        }
+        std::vector<std::thread> workers {};
+        workers.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            workers.emplace_back(worker);
+        }
+        for (auto&& thread : workers) {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] std::size_t apply_tables(std::size_t limit) {
+        for (std::size_t index = 0; index < limit; ++index) {
+            if (statements_[index]->node_kind() != ast::statement::kind::table_definition) {
+                continue;
+            }
+            auto&& entry = results_[index];
+            if (is_create_table(entry.result) && is_defined(entry.result)) {
+                // the same table was defined in this batch, so that we must analyze it again
+                entry.result = analyze(index);
+            }
+            if (!entry.result) {
+                return index + 1;
+            }
+            if (is_create_table(entry.result)) {
+                auto&& statement = entry.result.element<result_kind::statement>();
+                auto&& table = ::yugawara::binding::extract(
+                        unsafe_downcast<::takatori::statement::create_table>(statement).definition());
+                interpret(statement);
+                defined_tables_.emplace(std::addressof(table), index);
+                entry.interpreted = true;
+            }
+        }
+        return limit;
+    }
+
+    [[nodiscard]] std::size_t apply_indices(std::size_t limit) {
+        for (std::size_t index = 0; index < limit; ++index) {
+            if (statements_[index]->node_kind() != ast::statement::kind::index_definition) {
+                continue;
+            }
+            auto&& entry = results_[index];
+            if (is_create_index(entry.result)) {
+                if (auto position = find_table_position(entry.result); position && *position > index) {
+                    // the target table is not yet defined at this statement
+                    entry.result = not_yet_defined(index);
+                } else if (is_defined(entry.result)) {
+                    // the same index was defined in this batch, so that we must analyze it again
+                    entry.result = analyze(index);
+                }
+            }
+            if (!entry.result) {
+                return index + 1;
+            }
+            if (is_create_index(entry.result)) {
+                interpret(entry.result.element<result_kind::statement>());
+                entry.interpreted = true;
+            }
+        }
+        return limit;
+    }
+
+    [[nodiscard]] static bool is_create_table(analyzer::sql_analyzer_result const& result) {
+        return result.kind() == result_kind::statement
+                && result.element<result_kind::statement>().kind() == ::takatori::statement::create_table::tag;
+    }
+
+    [[nodiscard]] static bool is_create_index(analyzer::sql_analyzer_result const& result) {
+        return result.kind() == result_kind::statement
+                && result.element<result_kind::statement>().kind() == ::takatori::statement::create_index::tag;
+    }
+
+    [[nodiscard]] static bool is_defined(analyzer::sql_analyzer_result const& result) {
+        auto&& statement = result.element<result_kind::statement>();
+        if (statement.kind() == ::takatori::statement::create_table::tag) {
+            auto&& create = unsafe_downcast<::takatori::statement::create_table>(statement);
+            auto&& schema = ::yugawara::binding::extract(create.schema());
+            auto&& table = ::yugawara::binding::extract(create.definition());
+            return schema.storage_provider().find_relation(table.simple_name()) != nullptr;
+        }
+        auto&& create = unsafe_downcast<::takatori::statement::create_index>(statement);
+        auto&& schema = ::yugawara::binding::extract(create.schema());
+        auto&& index = ::yugawara::binding::extract<::yugawara::storage::index>(create.definition());
+        return schema.storage_provider().find_index(index.simple_name()) != nullptr;
+    }
+
+    [[nodiscard]] std::optional<std::size_t> find_table_position(analyzer::sql_analyzer_result const& result) const {
+        auto&& create = unsafe_downcast<::takatori::statement::create_index>(result.element<result_kind::statement>());
+        auto&& index = ::yugawara::binding::extract<::yugawara::storage::index>(create.definition());
+        if (auto iter = defined_tables_.find(std::addressof(index.table())); iter != defined_tables_.end()) {
+            return iter->second;
+        }
+        return {};
+    }
+
+    [[nodiscard]] analyzer::sql_analyzer_result not_yet_defined(std::size_t index) const {
+        auto&& region = statements_[index]->region();
+        std::vector<analyzer::sql_analyzer_result::diagnostic_type> diagnostics {};
+        diagnostics.emplace_back(
+                analyzer::sql_analyzer_code::table_not_found,
+                string_builder {}
+                        << "target table is not yet defined at this statement"
+                        << string_builder::to_string,
+                ::takatori::document::region {
+                        *source_.document(),
+                        region.begin,
+                        region.end,
+                });
+        return analyzer::sql_analyzer_result { std::move(diagnostics) };
+    }
+};
+
+} // namespace
+
+bool is_ddl_batch_target(ast::statement::statement const& statement) noexcept {
+    auto kind = statement.node_kind();
+    return kind == ast::statement::kind::table_definition
+            || kind == ast::statement::kind::index_definition;
+}
+
+std::vector<ddl_batch_entry> analyze_ddl_batch(
+        sequence_view<std::unique_ptr<ast::statement::statement> const> statements,
+        ast::compilation_unit const& source,
+        analyzer::sql_analyzer_options const& options,
+        ::yugawara::variable::provider const& variables,
+        std::size_t threads) {
+    engine e { statements, source, options, variables, threads };
+    return e.process();
+}
+
+} // namespace mizugaki::examples::explain_cli
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <takatori/util/sequence_view.h>
+
+#include <yugawara/variable/provider.h>
+
+#include <mizugaki/ast/compilation_unit.h>
+#include <mizugaki/ast/statement/statement.h>
+
+#include <mizugaki/analyzer/sql_analyzer_options.h>
+#include <mizugaki/analyzer/sql_analyzer_result.h>
+
+namespace mizugaki::examples::explain_cli {
+
+/**
+ * @brief an analyzed statement in DDL batch.
+ */
+struct ddl_batch_entry {
+    /// @brief the analysis result.
+    analyzer::sql_analyzer_result result;
+
+    /// @brief whether or not the result statement was already applied to the catalog.
+    bool interpreted { false };
+};
+
+/**
+ * @brief returns whether or not the given statement can be analyzed in DDL batch.
+ * @param statement the target statement
+ * @return true if it is CREATE TABLE or CREATE INDEX statement
+ * @return false otherwise
+ */
+[[nodiscard]] bool is_ddl_batch_target(ast::statement::statement const& statement) noexcept;
+
+/**
+ * @brief analyzes a run of DDL statements in parallel, and then applies them to the catalog in order.
+ * @details This first analyzes all CREATE TABLE statements in parallel, and applies them in order.
+ *      Then, this analyzes all CREATE INDEX statements in parallel, and applies them in order.
+ *      If the analysis may be affected by the preceding statements in the same batch (e.g. duplicate names),
+ *      this analyzes such statements again just before they are applied.
+ *      Each statement must satisfy is_ddl_batch_target().
+ * @param statements the target statements
+ * @param source the compilation unit which owns the statements
+ * @param options the analyzer options
+ * @param variables the host variables
+ * @param threads the number of analyzer threads
+ * @return the analyzed results, ordered as the source statements
+ * @return the results are truncated just after the first erroneous one
+ */
+[[nodiscard]] std::vector<ddl_batch_entry> analyze_ddl_batch(
+        ::takatori::util::sequence_view<std::unique_ptr<ast::statement::statement> const> statements,
+        ast::compilation_unit const& source,
+        analyzer::sql_analyzer_options const& options,
+        ::yugawara::variable::provider const& variables,
+        std::size_t threads);
+
+} // namespace mizugaki::examples::explain_cli
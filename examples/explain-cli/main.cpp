@@ -1,9 +1,12 @@
 #include <gflags/gflags.h>
 
-#include <fstream>
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <vector>
 
 #include <takatori/type/int.h>
 #include <takatori/type/decimal.h>
@@ -14,6 +17,7 @@
 
 #include <takatori/util/exception.h>
 #include <takatori/util/optional_ptr.h>
+#include <takatori/util/sequence_view.h>
 
 #include <yugawara/compiler.h>
 #include <yugawara/compiler_options.h>
@@ -23,6 +27,8 @@
 #include <yugawara/variable/configurable_provider.h>
 #include <yugawara/variable/declaration.h>
 
+#include <mizugaki/parser/mapped_document.h>
+#include <mizugaki/parser/string_document.h>
 #include <mizugaki/parser/sql_parser.h>
 #include <mizugaki/parser/sql_parser_options.h>
 #include <mizugaki/parser/sql_parser_result.h>
@@ -31,14 +37,18 @@
 
 #include <mizugaki/analyzer/sql_analyzer.h>
 
+#include "ddl_batch.h"
 #include "ddl_interpreter.h"
 #include "options.h"
+#include "replay_benchmark.h"
 
 namespace mizugaki::examples::explain_cli {
 
-static parser::sql_parser_result parse(std::string path, std::string source, parser::sql_parser_options options) {
+static parser::sql_parser_result parse(
+        std::shared_ptr<::takatori::document::document const> source,
+        parser::sql_parser_options options) {
     parser::sql_parser engine { std::move(options) };
-    auto result = engine(std::move(path), std::move(source));
+    auto result = engine(std::move(source));
     return result;
 }
 
@@ -118,31 +128,80 @@ DEFINE_bool(quiet, false, "only show diagnostic erroneous"); // NOLINT
 DEFINE_string(file, "", "input file path"); // NOLINT
 DEFINE_string(text, "", "input text"); // NOLINT
 DEFINE_string(placeholders, "", "placeholder definitions (name:type, separated by ,)"); // NOLINT
+DEFINE_int32(ddl_threads, 0, "analyzes consecutive CREATE TABLE/INDEX statements in parallel if greater than 1"); // NOLINT
+DEFINE_uint32(replay, 0, "replays DML statements the given times after compiling the input, and prints their latency"); // NOLINT
+DEFINE_int32(replay_threads, 1, "the number of threads to replay statements"); // NOLINT
+
+static int process(ddl_batch_entry& entry, ::yugawara::compiler_options const& compiler_opts) {
+    auto&& analyzer_result = entry.result;
+    ::yugawara::compiler_result compiler_result {};
+    switch (analyzer_result.kind()) {
+        case ::mizugaki::analyzer::sql_analyzer_result_kind::statement: {
+            auto stmt = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::statement>();
+            compiler_result = compile(std::move(stmt), compiler_opts);
+            break;
+        }
+        case ::mizugaki::analyzer::sql_analyzer_result_kind::execution_plan: {
+            auto graph = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::execution_plan>();
+            compiler_result = compile(std::move(graph), compiler_opts);
+            break;
+        }
+        case ::mizugaki::analyzer::sql_analyzer_result_kind::diagnostics: {
+            auto errors = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::diagnostics>();
+            for (auto&& info : errors) {
+                std::cerr << "failed to analyze SQL: " << info.code() << '\n'
+                        << "  message: " << info.message() << '\n'
+                        << "  at " << info.location() << '\n';
+            }
+            return 2;
+        }
+        default:
+            std::abort();
+    }
+
+    if (!compiler_result) {
+        auto errors = compiler_result.diagnostics();
+        for (auto&& info : errors) {
+            std::cerr << "failed to compile SQL: " << info.code() << '\n'
+                    << "  message: " << info.message() << '\n'
+                    << "  at " << info.location() << '\n';
+        }
+        return 3;
+    }
+
+    if (!FLAGS_quiet) {
+        ::takatori::serializer::json_printer printer { std::cout };
+        auto&& scanner = compiler_result.info().object_scanner();
+        auto&& compiled = compiler_result.statement();
+        scanner(compiled, printer);
+        std::cout << '\n' << std::flush;
+    }
+
+    if (!entry.interpreted) {
+        interpret(compiler_result.statement());
+    }
+    return 0;
+}
 
 static int do_main() {
-    std::string path;
-    std::string source;
+    std::shared_ptr<::takatori::document::document const> source;
     if (!FLAGS_text.empty()) {
-        path = "<text>";
-        source = FLAGS_text;
+        source = std::make_shared<parser::string_document>("<text>", FLAGS_text);
     } else {
-        path = FLAGS_file;
-        std::ifstream ifs { FLAGS_file };
-        if (ifs.fail()) {
-            std::cerr << "failed to open file: " << FLAGS_file << '\n';
+        // maps the file instead of loading it, to compile huge scripts
+        try {
+            source = std::make_shared<parser::mapped_document>(FLAGS_file);
+        } catch (std::system_error const& e) {
+            std::cerr << "failed to open file: " << e.what() << '\n';
             return 2;
         }
-        source.assign(
-                std::istreambuf_iterator { ifs },
-                std::istreambuf_iterator<char> {});
-        ifs.close();
     }
 
     auto variables = parse_variables(FLAGS_placeholders);
 
     // parse
     auto parser_opts = parser_options();
-    auto parser_result = parse(std::move(path), std::move(source), std::move(parser_opts));
+    auto parser_result = parse(std::move(source), std::move(parser_opts));
     if (!parser_result) {
         auto&& info = parser_result.diagnostic();
         std::cerr << "failed to parse SQL: " << info.code() << '\n'
@@ -155,61 +214,64 @@ static int do_main() {
     auto schema = create_default_schema("public");
 
     auto compiler_opts = compiler_options();
-    for (auto&& statement : compilation_unit->statements()) {
-        if (FLAGS_echo) {
-            auto&& region = statement->region();
-            std::cout << "> "
-                    << compilation_unit->document()->contents(region.begin, region.size())
-                    << '\n';
+    std::vector<std::string> replay_statements {};
+    auto&& statements = compilation_unit->statements();
+    for (std::size_t index = 0; index < statements.size();) {
+        auto next = index + 1;
+        std::vector<ddl_batch_entry> entries {};
+        if (FLAGS_ddl_threads > 1 && is_ddl_batch_target(*statements[index])) {
+            while (next < statements.size() && is_ddl_batch_target(*statements[next])) {
+                ++next;
+            }
+            entries = analyze_ddl_batch(
+                    ::takatori::util::sequence_view<std::unique_ptr<::mizugaki::ast::statement::statement> const> {
+                            statements.data() + index, // NOLINT(*-pointer-arithmetic)
+                            next - index,
+                    },
+                    *compilation_unit,
+                    analyzer_options(schema),
+                    *variables,
+                    static_cast<std::size_t>(FLAGS_ddl_threads));
+        } else {
+            auto analyzer_opts = analyzer_options(schema);
+            entries.push_back({
+                    analyze(*statements[index], *compilation_unit, analyzer_opts, *variables),
+                    false,
+            });
         }
 
-        auto analyzer_opts = analyzer_options(schema);
-        auto analyzer_result = analyze(*statement, *compilation_unit, analyzer_opts, *variables);
-
-        ::yugawara::compiler_result compiler_result {};
-        switch (analyzer_result.kind()) {
-            case ::mizugaki::analyzer::sql_analyzer_result_kind::statement: {
-                auto stmt = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::statement>();
-                compiler_result = compile(std::move(stmt), compiler_opts);
-                break;
+        for (std::size_t offset = 0; offset < entries.size(); ++offset) {
+            if (FLAGS_echo) {
+                auto&& region = statements[index + offset]->region();
+                std::cout << "> "
+                        << compilation_unit->document()->contents(region.begin, region.size())
+                        << '\n';
             }
-            case ::mizugaki::analyzer::sql_analyzer_result_kind::execution_plan: {
-                auto graph = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::execution_plan>();
-                compiler_result = compile(std::move(graph), compiler_opts);
-                break;
-            }
-            case ::mizugaki::analyzer::sql_analyzer_result_kind::diagnostics: {
-                auto errors = analyzer_result.release<::mizugaki::analyzer::sql_analyzer_result_kind::diagnostics>();
-                for (auto&& info : errors) {
-                    std::cerr << "failed to analyze SQL: " << info.code() << '\n'
-                            << "  message: " << info.message() << '\n'
-                            << "  at " << info.location() << '\n';
-                }
-                return 2;
+            if (auto rc = process(entries[offset], compiler_opts); rc != 0) {
+                return rc;
             }
-            default:
-                std::abort();
-        }
-
-        if (!compiler_result) {
-            auto errors = compiler_result.diagnostics();
-            for (auto&& info : errors) {
-                std::cerr << "failed to compile SQL: " << info.code() << '\n'
-                        << "  message: " << info.message() << '\n'
-                        << "  at " << info.location() << '\n';
+            if (FLAGS_replay > 0 && is_replay_target(*statements[index + offset])) {
+                auto&& region = statements[index + offset]->region();
+                replay_statements.emplace_back(compilation_unit->document()->contents(region.begin, region.size()));
             }
-            return 3;
         }
+        index = next;
+    }
 
-        if (!FLAGS_quiet) {
-            ::takatori::serializer::json_printer printer { std::cout };
-            auto&& scanner = compiler_result.info().object_scanner();
-            auto&& compiled = compiler_result.statement();
-            scanner(compiled, printer);
-            std::cout << '\n' << std::flush;
+    if (FLAGS_replay > 0) {
+        bool succeeded = run_replay_benchmark(
+                replay_statements,
+                FLAGS_replay,
+                static_cast<std::size_t>(std::max(FLAGS_replay_threads, 1)),
+                parser_options(),
+                analyzer_options(schema),
+                compiler_opts,
+                variables,
+                std::cout);
+        if (!succeeded) {
+            std::cerr << "some statements were failed while replaying" << '\n';
+            return 4;
         }
-
-        interpret(compiler_result.statement());
     }
     return 0;
 }
@@ -0,0 +1,226 @@
+#include "replay_benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <string_view>
+#include <thread>
+
+#include <mizugaki/sql_compiler.h>
+
+namespace mizugaki::examples::explain_cli {
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+using duration = clock::duration;
+
+enum class phase : std::size_t {
+    parse = 0,
+    analyze,
+    compile,
+    total,
+};
+
+constexpr std::size_t phase_count = static_cast<std::size_t>(phase::total) + 1;
+
+constexpr std::array<std::string_view, phase_count> phase_names {
+        "parse",
+        "analyze",
+        "compile",
+        "total",
+};
+
+/**
+ * @brief the measurements of individual worker threads.
+ */
+class measurement {
+public:
+    void record(phase p, duration elapsed) {
+        latencies_[static_cast<std::size_t>(p)].push_back(elapsed);
+    }
+
+    void fail(phase p) noexcept {
+        ++failures_[static_cast<std::size_t>(p)];
+    }
+
+    void merge(measurement& other) {
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            auto&& source = other.latencies_[i];
+            latencies_[i].insert(latencies_[i].end(), source.begin(), source.end());
+            source.clear();
+            failures_[i] += other.failures_[i];
+        }
+    }
+
+    [[nodiscard]] std::vector<duration>& latencies(phase p) noexcept {
+        return latencies_[static_cast<std::size_t>(p)];
+    }
+
+    [[nodiscard]] std::size_t failures(phase p) const noexcept {
+        return failures_[static_cast<std::size_t>(p)];
+    }
+
+    [[nodiscard]] std::size_t total_failures() const noexcept {
+        std::size_t result = 0;
+        for (auto count : failures_) {
+            result += count;
+        }
+        return result;
+    }
+
+private:
+    std::array<std::vector<duration>, phase_count> latencies_ {};
+    std::array<std::size_t, phase_count> failures_ {};
+};
+
+phase to_phase(sql_compiler_stage stage) noexcept {
+    switch (stage) {
+        case sql_compiler_stage::parse: return phase::parse;
+        case sql_compiler_stage::analyze: return phase::analyze;
+        case sql_compiler_stage::compile: return phase::compile;
+    }
+    std::abort();
+}
+
+double to_micros(duration value) {
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(value).count();
+}
+
+double to_seconds(duration value) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(value).count();
+}
+
+duration percentile(std::vector<duration> const& sorted, std::size_t percent) {
+    if (sorted.empty()) {
+        return {};
+    }
+    return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+} // namespace
+
+bool is_replay_target(ast::statement::statement const& statement) noexcept {
+    using kind = ast::statement::kind;
+    switch (statement.node_kind()) {
+        case kind::select_statement:
+        case kind::insert_statement:
+        case kind::update_statement:
+        case kind::delete_statement:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool run_replay_benchmark(
+        std::vector<std::string> const& statements,
+        std::size_t rounds,
+        std::size_t threads,
+        parser::sql_parser_options const& parser_options,
+        analyzer::sql_analyzer_options const& analyzer_options,
+        ::yugawara::compiler_options const& compiler_options,
+        std::shared_ptr<::yugawara::variable::provider const> variables,
+        std::ostream& out) {
+    auto task_count = statements.size() * rounds;
+    auto thread_count = std::max(std::min(threads, task_count), std::size_t { 1 });
+    std::vector<measurement> measurements(thread_count);
+
+    std::atomic_size_t next { 0 };
+    auto worker = [&](measurement& m) {
+        // NOTE: each compiler is not thread-safe
+        sql_compiler compiler {
+                sql_compiler_options {
+                        analyzer_options,
+                        compiler_options,
+                        parser_options,
+                        variables,
+                },
+        };
+        for (auto index = next++; index < task_count; index = next++) {
+            auto&& text = statements[index % statements.size()];
+            auto result = compiler.compile(text);
+            auto&& metrics = result.metrics();
+            auto stage = result.stage();
+
+            m.record(phase::parse, metrics.parse_time());
+            if (stage >= sql_compiler_stage::analyze) {
+                m.record(phase::analyze, metrics.analysis_time());
+            }
+            if (stage >= sql_compiler_stage::compile) {
+                m.record(phase::compile, metrics.compile_time());
+            }
+            if (!result) {
+                m.fail(to_phase(stage));
+                continue;
+            }
+            m.record(phase::total, metrics.total_time());
+        }
+    };
+
+    auto started = clock::now();
+    if (thread_count <= 1) {
+        worker(measurements.front());
+    } else {
+        std::vector<std::thread> workers {};
+        workers.reserve(thread_count);
+        for (auto&& m : measurements) {
+            workers.emplace_back(worker, std::ref(m));
+        }
+        for (auto&& thread : workers) {
+            thread.join();
+        }
+    }
+    auto elapsed = clock::now() - started;
+
+    auto&& result = measurements.front();
+    for (std::size_t i = 1; i < measurements.size(); ++i) {
+        result.merge(measurements[i]);
+    }
+
+    out << "replayed " << task_count << " statements "
+        << "(" << statements.size() << " x " << rounds << ") "
+        << "with " << thread_count << " threads "
+        << "in " << to_seconds(elapsed) << "s" << '\n';
+    out << std::left
+        << std::setw(10) << "phase"
+        << std::setw(12) << "count"
+        << std::setw(10) << "failed"
+        << std::setw(14) << "p50(us)"
+        << std::setw(14) << "p99(us)"
+        << "statements/sec" << '\n';
+    for (std::size_t i = 0; i < phase_count; ++i) {
+        auto p = static_cast<phase>(i);
+        auto&& latencies = result.latencies(p);
+        std::sort(latencies.begin(), latencies.end());
+
+        // the phases are measured as if the all threads only processed the individual phase,
+        // and the total is measured by the wall clock time
+        double throughput {};
+        if (p == phase::total) {
+            auto seconds = to_seconds(elapsed);
+            throughput = seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0;
+        } else {
+            duration busy {};
+            for (auto latency : latencies) {
+                busy += latency;
+            }
+            auto seconds = to_seconds(busy) / static_cast<double>(thread_count);
+            throughput = seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0;
+        }
+        out << std::left
+            << std::setw(10) << phase_names[i]
+            << std::setw(12) << latencies.size()
+            << std::setw(10) << result.failures(p)
+            << std::setw(14) << to_micros(percentile(latencies, 50))
+            << std::setw(14) << to_micros(percentile(latencies, 99))
+            << throughput << '\n';
+    }
+    return result.total_failures() == 0;
+}
+
+} // namespace mizugaki::examples::explain_cli
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <yugawara/compiler_options.h>
+
+#include <yugawara/variable/provider.h>
+
+#include <mizugaki/ast/statement/statement.h>
+
+#include <mizugaki/parser/sql_parser_options.h>
+
+#include <mizugaki/analyzer/sql_analyzer_options.h>
+
+namespace mizugaki::examples::explain_cli {
+
+/**
+ * @brief returns whether or not the given statement can be replayed in the benchmark.
+ * @param statement the target statement
+ * @return true if it is a DML statement, which never changes the catalog
+ * @return false otherwise
+ */
+[[nodiscard]] bool is_replay_target(ast::statement::statement const& statement) noexcept;
+
+/**
+ * @brief replays the statements, and then prints the latency distribution and throughput of each phase.
+ * @details Each thread takes the next statement from the shared queue, which contains the statement log
+ *      `rounds` times, and then parses, analyzes, and compiles it with its own sql_compiler.
+ *      The phases of each statement are measured separately, and the following phases are skipped
+ *      if a phase was failed.
+ * @param statements the source text of individual statements
+ * @param rounds the number of times to replay the statements
+ * @param threads the number of worker threads
+ * @param parser_options the parser options
+ * @param analyzer_options the analyzer options
+ * @param compiler_options the compiler options
+ * @param variables the host variables
+ * @param out the report output
+ * @return true if all statements were successfully compiled
+ * @return false otherwise
+ */
+bool run_replay_benchmark(
+        std::vector<std::string> const& statements,
+        std::size_t rounds,
+        std::size_t threads,
+        parser::sql_parser_options const& parser_options,
+        analyzer::sql_analyzer_options const& analyzer_options,
+        ::yugawara::compiler_options const& compiler_options,
+        std::shared_ptr<::yugawara::variable::provider const> variables,
+        std::ostream& out);
+
+} // namespace mizugaki::examples::explain_cli
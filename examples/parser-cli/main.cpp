@@ -1,17 +1,26 @@
 #include <gflags/gflags.h>
 
-#include <fstream>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <string>
-#include <string_view>
+#include <system_error>
 
+#include <mizugaki/parser/mapped_document.h>
+#include <mizugaki/parser/string_document.h>
 #include <mizugaki/parser/sql_parser.h>
+#include <mizugaki/parser/sql_token_stream.h>
 
 namespace mizugaki::examples::parser_cli {
 
-static bool run(std::string_view source, std::size_t repeat, bool quiet, bool stats, parser::sql_parser engine) {
+static bool run(
+        std::shared_ptr<::takatori::document::document const> const& source,
+        std::size_t repeat,
+        bool quiet,
+        bool stats,
+        parser::sql_parser engine) {
     for (std::size_t round = 0; round < repeat; ++round) {
-        auto result = engine("-", std::string { source });
+        auto result = engine(source);
         if (auto&& error = result.diagnostic()) {
             std::cerr << error.message() << "; "
                       << "occurred at " << error.region().first()
@@ -29,6 +38,40 @@ static bool run(std::string_view source, std::size_t repeat, bool quiet, bool st
     return true;
 }
 
+static void tokenize(
+        std::shared_ptr<::takatori::document::document const> const& source,
+        std::size_t repeat,
+        bool quiet,
+        bool stats) {
+    using clock = std::chrono::steady_clock;
+    parser::sql_token_stream stream {};
+    std::size_t count = 0;
+    auto started = clock::now();
+    for (std::size_t round = 0; round < repeat; ++round) {
+        stream.reset(source);
+        while (true) {
+            auto token = stream.next();
+            if (token.kind() == parser::sql_token_kind::end_of_file) {
+                break;
+            }
+            ++count;
+            if (!quiet && round == 0) {
+                std::cout << token.kind() << '\t'
+                          << token.region().first() << '\t'
+                          << stream.image(token) << '\n';
+            }
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(clock::now() - started);
+    if (stats) {
+        std::cout << "tokens: " << count << '\n';
+        std::cout << "elapsed: " << elapsed.count() << "s" << '\n';
+        if (elapsed.count() > 0) {
+            std::cout << "tokens/sec: " << static_cast<double>(count) / elapsed.count() << '\n';
+        }
+    }
+}
+
 } // namespace mizugaki::examples::parser_cli
 
 using namespace mizugaki::examples::parser_cli;
@@ -38,9 +81,11 @@ DEFINE_int32(debug, 0, "parser debug level"); // NOLINT
 DEFINE_uint32(repeat, 1, "repeat parse operation"); // NOLINT
 DEFINE_string(file, "", "input file path"); // NOLINT
 DEFINE_string(text, "", "input text"); // NOLINT
-DEFINE_bool(stats, false, "show AST statistics"); // NOLINT
+DEFINE_bool(stats, false, "show AST statistics, or tokens/sec with -tokenize"); // NOLINT
+DEFINE_bool(tokenize, false, "only split the input into tokens"); // NOLINT
 DEFINE_uint64(node_limit, 10'000, "AST node limit"); // NOLINT
 DEFINE_uint64(depth_limit, 5'000, "AST depth limit"); // NOLINT
+DEFINE_string(comments, "all", "comment collection mode {all, description, none}"); // NOLINT
 
 int main(int argc, char* argv[]) {
     gflags::SetUsageMessage("mizugaki SQL parser CLI");
@@ -51,24 +96,36 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::string source;
+    std::shared_ptr<::takatori::document::document const> source;
     if (!FLAGS_text.empty()) {
-        source = FLAGS_text;
+        source = std::make_shared<::mizugaki::parser::string_document>("-", FLAGS_text);
     } else {
-        std::ifstream ifs { FLAGS_file };
-        if (ifs.fail()) {
-            std::cerr << "failed to open file: " << FLAGS_file << '\n';
+        // maps the file instead of loading it, to parse huge scripts
+        try {
+            source = std::make_shared<::mizugaki::parser::mapped_document>(FLAGS_file);
+        } catch (std::system_error const& e) {
+            std::cerr << "failed to open file: " << e.what() << '\n';
             return 2;
         }
-        source.assign(
-                std::istreambuf_iterator<char> { ifs },
-                std::istreambuf_iterator<char> {});
-        ifs.close();
+    }
+    if (FLAGS_tokenize) {
+        tokenize(source, FLAGS_repeat, FLAGS_quiet, FLAGS_stats);
+        return 0;
     }
     ::mizugaki::parser::sql_parser engine {};
     engine.options().debug() = FLAGS_debug;
     engine.options().tree_node_limit() = FLAGS_node_limit;
     engine.options().tree_depth_limit() = FLAGS_depth_limit;
+    if (FLAGS_comments == "all") {
+        engine.options().comment_mode() = ::mizugaki::parser::sql_parser_comment_mode::all;
+    } else if (FLAGS_comments == "description") {
+        engine.options().comment_mode() = ::mizugaki::parser::sql_parser_comment_mode::description;
+    } else if (FLAGS_comments == "none") {
+        engine.options().comment_mode() = ::mizugaki::parser::sql_parser_comment_mode::none;
+    } else {
+        std::cerr << "unknown comment mode: " << FLAGS_comments << '\n';
+        return 1;
+    }
     if (run(source, FLAGS_repeat, FLAGS_quiet, FLAGS_stats, std::move(engine))) {
         return 0;
     }
@@ -0,0 +1,113 @@
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <yugawara/schema/catalog.h>
+#include <yugawara/schema/configurable_provider.h>
+#include <yugawara/schema/search_path.h>
+
+#include <mizugaki/parser/sql_parser.h>
+
+#include <mizugaki/analyzer/sql_analyzer.h>
+
+#include "synthetic_schema.h"
+#include "workload_generator.h"
+
+namespace mizugaki::examples::workload_generator {
+
+static analyzer::sql_analyzer_options analyzer_options(std::size_t table_count, std::size_t column_count) {
+    auto schema_provider = std::make_shared<::yugawara::schema::configurable_provider>();
+    auto schema = schema_provider->add(create_synthetic_schema("public", table_count, column_count));
+    auto catalog = std::make_shared<::yugawara::schema::catalog>(
+            "tsurugi",
+            std::nullopt,
+            std::move(schema_provider));
+    auto search_path = std::make_shared<::yugawara::schema::search_path>(
+            ::yugawara::schema::search_path::vector_type { schema });
+    analyzer::sql_analyzer_options options {
+            std::move(catalog),
+            std::move(search_path),
+            std::move(schema),
+    };
+    options.enable_metrics() = true;
+    return options;
+}
+
+static bool check(std::string source, analyzer::sql_analyzer_options const& options) {
+    parser::sql_parser parser {};
+    parser.options().enable_metrics() = true;
+    auto parser_result = parser("<generated>", std::move(source));
+    if (auto&& error = parser_result.diagnostic()) {
+        std::cerr << "failed to parse: " << error.message() << '\n';
+        return false;
+    }
+    std::cerr << *parser_result.metrics() << '\n';
+
+    analyzer::sql_analyzer analyzer {};
+    auto&& unit = *parser_result.value();
+    for (auto&& statement : unit.statements()) {
+        auto result = analyzer(options, *statement, unit);
+        if (!result) {
+            for (auto&& info : result.element<analyzer::sql_analyzer_result_kind::diagnostics>()) {
+                std::cerr << "failed to analyze: " << info.code() << ": " << info.message() << '\n';
+            }
+            return false;
+        }
+        std::cerr << *result.metrics() << '\n';
+    }
+    return true;
+}
+
+} // namespace mizugaki::examples::workload_generator
+
+using namespace mizugaki::examples::workload_generator;
+
+DEFINE_string(kind, "", "workload kind {columns, join, values, nested_subquery, in_list, conjunction, ddl}"); // NOLINT
+DEFINE_uint64(size, 1, "workload size"); // NOLINT
+DEFINE_uint64(columns, 4, "the number of columns in each synthetic table"); // NOLINT
+DEFINE_uint64(statements, 1, "the number of statements to generate"); // NOLINT
+DEFINE_string(output, "", "output file path (default: standard output)"); // NOLINT
+DEFINE_bool(check, false, "parses and analyzes the generated statements, and then prints their metrics"); // NOLINT
+
+int main(int argc, char* argv[]) {
+    gflags::SetUsageMessage("mizugaki synthetic SQL workload generator");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    auto kind = find_workload_kind(FLAGS_kind);
+    if (!kind) {
+        gflags::ShowUsageWithFlags(argv[0]); // NOLINT
+        return 1;
+    }
+    std::size_t column_count = std::max<std::size_t>(FLAGS_columns, required_column_count(*kind, FLAGS_size));
+
+    std::ostringstream buffer {};
+    for (std::size_t i = 0; i < FLAGS_statements; ++i) {
+        generate(buffer, *kind, FLAGS_size, column_count);
+    }
+    auto source = std::move(buffer).str();
+
+    if (FLAGS_output.empty()) {
+        std::cout << source;
+    } else {
+        std::ofstream ofs { FLAGS_output };
+        if (ofs.fail()) {
+            std::cerr << "failed to open file: " << FLAGS_output << '\n';
+            return 2;
+        }
+        ofs << source;
+        ofs.close();
+    }
+
+    if (FLAGS_check) {
+        auto options = analyzer_options(required_table_count(*kind, FLAGS_size), column_count);
+        if (!check(std::move(source), options)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "synthetic_schema.h"
+
+#include <optional>
+#include <string>
+
+#include <takatori/type/primitive.h>
+
+#include <takatori/util/reference_vector.h>
+
+#include <yugawara/aggregate/configurable_provider.h>
+#include <yugawara/function/configurable_provider.h>
+
+#include <yugawara/storage/configurable_provider.h>
+#include <yugawara/storage/table.h>
+#include <yugawara/storage/column.h>
+#include <yugawara/storage/index.h>
+
+#include <yugawara/variable/provider.h>
+
+namespace mizugaki::examples::workload_generator {
+
+std::shared_ptr<::yugawara::schema::declaration> create_synthetic_schema(
+        std::string name,
+        std::size_t table_count,
+        std::size_t column_count) {
+    auto storages = std::make_shared<::yugawara::storage::configurable_provider>();
+    for (std::size_t table_index = 0; table_index < table_count; ++table_index) {
+        ::takatori::util::reference_vector<::yugawara::storage::column> columns {};
+        columns.reserve(column_count);
+        for (std::size_t column_index = 0; column_index < column_count; ++column_index) {
+            // c0 BIGINT PRIMARY KEY, c1 BIGINT, ...
+            columns.emplace_back(std::make_unique<::yugawara::storage::column>(
+                    "c" + std::to_string(column_index),
+                    ::takatori::type::int8 {},
+                    column_index == 0 ? ~::yugawara::variable::nullable : ::yugawara::variable::nullable));
+        }
+        auto table_name = "t" + std::to_string(table_index);
+        auto table = std::make_shared<::yugawara::storage::table>(
+                std::nullopt,
+                table_name,
+                std::move(columns));
+        storages->add_table(table);
+        // primary key
+        storages->add_index({
+                table,
+                table_name,
+                { table->columns()[0] },
+                {},
+                {
+                        ::yugawara::storage::index_feature::primary,
+                        ::yugawara::storage::index_feature::find,
+                        ::yugawara::storage::index_feature::scan,
+                        ::yugawara::storage::index_feature::unique,
+                        ::yugawara::storage::index_feature::unique_constraint,
+                },
+        });
+    }
+    return std::make_shared<::yugawara::schema::declaration>(
+            std::nullopt,
+            std::move(name),
+            std::move(storages),
+            std::shared_ptr<::yugawara::variable::provider> {},
+            std::make_shared<::yugawara::function::configurable_provider>(),
+            std::make_shared<::yugawara::aggregate::configurable_provider>());
+}
+
+} // namespace mizugaki::examples::workload_generator
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <yugawara/schema/declaration.h>
+
+namespace mizugaki::examples::workload_generator {
+
+/**
+ * @brief creates a schema which contains synthetic tables.
+ * @details The schema contains `table_count` tables named `t0, t1, ...`,
+ *      and each table has `column_count` columns named `c0, c1, ...` of `BIGINT`.
+ *      The first column of each table is its primary key.
+ *      This is the same schema as the workload_kind::ddl statements with the same parameters.
+ * @param name the schema name
+ * @param table_count the number of tables
+ * @param column_count the number of columns in each table, must be greater than 0
+ * @return the created schema
+ */
+[[nodiscard]] std::shared_ptr<::yugawara::schema::declaration> create_synthetic_schema(
+        std::string name,
+        std::size_t table_count,
+        std::size_t column_count);
+
+} // namespace mizugaki::examples::workload_generator
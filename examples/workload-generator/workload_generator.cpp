@@ -0,0 +1,170 @@
+#include "workload_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <utility>
+
+namespace mizugaki::examples::workload_generator {
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr std::array<std::pair<std::string_view, workload_kind>, 7> workload_names {{
+        { "columns"sv, workload_kind::columns },
+        { "join"sv, workload_kind::join },
+        { "values"sv, workload_kind::values },
+        { "nested_subquery"sv, workload_kind::nested_subquery },
+        { "in_list"sv, workload_kind::in_list },
+        { "conjunction"sv, workload_kind::conjunction },
+        { "ddl"sv, workload_kind::ddl },
+}};
+
+void emit_columns(std::ostream& out, std::size_t size) {
+    out << "SELECT ";
+    for (std::size_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            out << ", ";
+        }
+        out << 'c' << i;
+    }
+    out << " FROM t0";
+}
+
+void emit_join(std::ostream& out, std::size_t size) {
+    out << "SELECT * FROM t0";
+    for (std::size_t i = 1; i < size; ++i) {
+        out << "\n  JOIN t" << i << " ON t" << (i - 1) << ".c0 = t" << i << ".c0";
+    }
+}
+
+void emit_values(std::ostream& out, std::size_t size, std::size_t column_count) {
+    out << "INSERT INTO t0 VALUES";
+    for (std::size_t row = 0; row < size; ++row) {
+        out << (row == 0 ? "\n  (" : ",\n  (");
+        for (std::size_t column = 0; column < column_count; ++column) {
+            if (column > 0) {
+                out << ", ";
+            }
+            // keep the primary key unique
+            out << (column == 0 ? row : row + column);
+        }
+        out << ')';
+    }
+}
+
+void emit_nested_subquery(std::ostream& out, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        out << "SELECT * FROM (";
+    }
+    out << "SELECT * FROM t0";
+    for (std::size_t i = size; i > 0; --i) {
+        out << ") q" << (i - 1);
+    }
+}
+
+void emit_in_list(std::ostream& out, std::size_t size) {
+    out << "SELECT * FROM t0 WHERE c0 IN (";
+    for (std::size_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            out << ", ";
+        }
+        out << i;
+    }
+    out << ')';
+}
+
+void emit_conjunction(std::ostream& out, std::size_t size, std::size_t column_count) {
+    out << "SELECT * FROM t0";
+    for (std::size_t i = 0; i < size; ++i) {
+        out << (i == 0 ? " WHERE " : " AND ");
+        out << 'c' << (i % column_count) << " >= " << i;
+    }
+}
+
+void emit_ddl(std::ostream& out, std::size_t size, std::size_t column_count) {
+    for (std::size_t table = 0; table < size; ++table) {
+        if (table > 0) {
+            out << ";\n";
+        }
+        out << "CREATE TABLE t" << table << " (";
+        for (std::size_t column = 0; column < column_count; ++column) {
+            out << (column == 0 ? "\n  " : ",\n  ");
+            out << 'c' << column << " BIGINT";
+            if (column == 0) {
+                out << " PRIMARY KEY";
+            }
+        }
+        out << "\n)";
+    }
+}
+
+} // namespace
+
+std::string_view to_string_view(workload_kind value) noexcept {
+    for (auto&& [name, kind] : workload_names) {
+        if (kind == value) {
+            return name;
+        }
+    }
+    std::abort();
+}
+
+std::optional<workload_kind> find_workload_kind(std::string_view name) noexcept {
+    for (auto&& [candidate, kind] : workload_names) {
+        if (candidate == name) {
+            return kind;
+        }
+    }
+    return {};
+}
+
+std::size_t required_table_count(workload_kind kind, std::size_t size) noexcept {
+    switch (kind) {
+        case workload_kind::join:
+            return std::max<std::size_t>(size, 1);
+        case workload_kind::ddl:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+std::size_t required_column_count(workload_kind kind, std::size_t size) noexcept {
+    switch (kind) {
+        case workload_kind::columns:
+            return std::max<std::size_t>(size, 1);
+        default:
+            return 1;
+    }
+}
+
+void generate(std::ostream& out, workload_kind kind, std::size_t size, std::size_t column_count) {
+    switch (kind) {
+        case workload_kind::columns:
+            emit_columns(out, size);
+            break;
+        case workload_kind::join:
+            emit_join(out, size);
+            break;
+        case workload_kind::values:
+            emit_values(out, size, column_count);
+            break;
+        case workload_kind::nested_subquery:
+            emit_nested_subquery(out, size);
+            break;
+        case workload_kind::in_list:
+            emit_in_list(out, size);
+            break;
+        case workload_kind::conjunction:
+            emit_conjunction(out, size, column_count);
+            break;
+        case workload_kind::ddl:
+            emit_ddl(out, size, column_count);
+            break;
+    }
+    out << ";\n";
+}
+
+} // namespace mizugaki::examples::workload_generator
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+namespace mizugaki::examples::workload_generator {
+
+/**
+ * @brief represents a kind of synthetic workload.
+ * @details Each workload scales along a single dimension, given as `size` of generate().
+ *      The generated statements refer to the synthetic schema: tables `t0, t1, ...` and columns `c0, c1, ...`.
+ * @see create_synthetic_schema()
+ */
+enum class workload_kind {
+    /// @brief `SELECT c0, c1, ... FROM t0`, with `size` columns.
+    columns,
+
+    /// @brief `SELECT * FROM t0 JOIN t1 ON ... JOIN t2 ON ...`, with `size` tables.
+    join,
+
+    /// @brief `INSERT INTO t0 VALUES (...), (...), ...`, with `size` rows.
+    values,
+
+    /// @brief `SELECT * FROM (SELECT * FROM (...) q1) q0`, with `size` levels of sub-queries.
+    nested_subquery,
+
+    /// @brief `SELECT * FROM t0 WHERE c0 IN (0, 1, ...)`, with `size` elements.
+    in_list,
+
+    /// @brief `SELECT * FROM t0 WHERE c0 = 0 AND c1 = 1 AND ...`, with `size` conjuncts.
+    conjunction,
+
+    /// @brief `CREATE TABLE t0 (...); CREATE TABLE t1 (...); ...`, with `size` tables.
+    ddl,
+};
+
+/**
+ * @brief returns string representation of the value.
+ * @param value the target value
+ * @return the corresponded string representation
+ */
+[[nodiscard]] std::string_view to_string_view(workload_kind value) noexcept;
+
+/**
+ * @brief returns the workload kind of the given name.
+ * @param name the workload name
+ * @return the corresponded workload kind
+ * @return empty if there is no such the workload
+ */
+[[nodiscard]] std::optional<workload_kind> find_workload_kind(std::string_view name) noexcept;
+
+/**
+ * @brief returns the number of tables required to analyze the workload.
+ * @param kind the workload kind
+ * @param size the workload size
+ * @return the minimum number of tables in the synthetic schema
+ */
+[[nodiscard]] std::size_t required_table_count(workload_kind kind, std::size_t size) noexcept;
+
+/**
+ * @brief returns the number of columns in each table required to analyze the workload.
+ * @param kind the workload kind
+ * @param size the workload size
+ * @return the minimum number of columns in the synthetic schema
+ */
+[[nodiscard]] std::size_t required_column_count(workload_kind kind, std::size_t size) noexcept;
+
+/**
+ * @brief generates a synthetic SQL statement.
+ * @param out the output stream
+ * @param kind the workload kind
+ * @param size the workload size
+ * @param column_count the number of columns in each table, must be greater than 0
+ */
+void generate(std::ostream& out, workload_kind kind, std::size_t size, std::size_t column_count);
+
+} // namespace mizugaki::examples::workload_generator
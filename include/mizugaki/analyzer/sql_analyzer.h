@@ -15,6 +15,7 @@
 
 #include "sql_analyzer_options.h"
 #include "sql_analyzer_result.h"
+#include "sql_prepared_statement.h"
 
 namespace mizugaki::analyzer {
 
@@ -32,6 +33,9 @@ public:
     /// @brief the result type.
     using result_type = sql_analyzer_result;
 
+    /// @brief the prepared statement type.
+    using prepared_statement_type = sql_prepared_statement;
+
     /**
      * @brief creates a new instance.
      */
@@ -90,6 +94,42 @@ public:
             placeholder_map const& placeholders = {},
             ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters = {});
 
+    /**
+     * @brief analyzes a statement and leaves its host parameters as parameter slots.
+     * @details Each host parameter in the statement must be declared in the host parameter declarations,
+     *      and it is represented as a variable reference in the resulting statement.
+     *      Clients can bind the parameter values via sql_prepared_statement::bind() for each execution.
+     * @param options the analysis options
+     * @param statement the source statement
+     * @param source the source program
+     * @param host_parameters the host parameter declarations
+     * @return the prepared statement
+     * @return invalid prepared statement if an error was occurred
+     */
+    [[nodiscard]] prepared_statement_type prepare(
+            options_type const& options,
+            ast::statement::statement const& statement,
+            ast::compilation_unit const& source,
+            ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters);
+
+    /**
+     * @brief analyzes a statement and leaves its host parameters as parameter slots.
+     * @param options the analysis options
+     * @param statement the source statement
+     * @param source the source document
+     * @param comments the comment regions in the document
+     * @param host_parameters the host variables for placeholders: each entry name may start with `:`
+     * @return the prepared statement
+     * @return invalid prepared statement if an error was occurred
+     * @see prepare(options_type const&, ast::statement::statement const&, ast::compilation_unit const&, ::takatori::util::optional_ptr<::yugawara::variable::provider const>)
+     */
+    [[nodiscard]] prepared_statement_type prepare(
+            options_type const& options,
+            ast::statement::statement const& statement,
+            ::takatori::util::optional_ptr<::takatori::document::document const> source,
+            ::takatori::util::sequence_view<ast::node_region const> comments,
+            ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters);
+
 private:
     std::unique_ptr<impl> impl_;
 };
@@ -122,6 +122,13 @@ enum class sql_analyzer_code {
     inconsistent_elements,
     /// @brief there is no such the function (internal error).
     inconsistent_function_type,
+
+    /// @brief the analysis exceeds its memory budget.
+    memory_budget_exceeded,
+    /// @brief the analysis was cancelled.
+    cancelled,
+    /// @brief the analysis has exceeded its deadline.
+    deadline_exceeded,
 };
 
 /**
@@ -193,6 +200,10 @@ inline constexpr std::string_view to_string_view(sql_analyzer_code value) noexce
         case kind::unresolved_variable: return "unresolved_variable"sv;
         case kind::inconsistent_elements: return "inconsistent_elements"sv;
         case kind::inconsistent_function_type: return "inconsistent_function_type"sv;
+
+        case kind::memory_budget_exceeded: return "memory_budget_exceeded"sv;
+        case kind::cancelled: return "cancelled"sv;
+        case kind::deadline_exceeded: return "deadline_exceeded"sv;
     }
     std::abort();
 }
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace mizugaki::analyzer {
+
+/**
+ * @brief performance metrics of an analysis operation.
+ * @details This is only available if sql_analyzer_options::enable_metrics() is set.
+ *      Each elapsed time is inclusive, that is, it also contains the time of the other phases invoked from it
+ *      (e.g. scalar_expression_time() contains the name resolution of column references).
+ *      Re-entering the same phase (e.g. scalar sub-queries) is never counted twice.
+ * @see sql_analyzer_result::metrics()
+ */
+class sql_analyzer_metrics {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /// @brief the duration type.
+    using duration_type = std::chrono::nanoseconds;
+
+    /**
+     * @brief returns the total elapsed time of the analysis.
+     * @return the total elapsed time
+     */
+    [[nodiscard]] duration_type& total_time() noexcept {
+        return total_time_;
+    }
+
+    /// @copydoc total_time()
+    [[nodiscard]] duration_type total_time() const noexcept {
+        return total_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of resolving names of tables, columns, functions and so on.
+     * @return the elapsed time of name resolution
+     */
+    [[nodiscard]] duration_type& name_resolution_time() noexcept {
+        return name_resolution_time_;
+    }
+
+    /// @copydoc name_resolution_time()
+    [[nodiscard]] duration_type name_resolution_time() const noexcept {
+        return name_resolution_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of analyzing scalar expressions.
+     * @return the elapsed time of scalar expression analysis
+     */
+    [[nodiscard]] duration_type& scalar_expression_time() noexcept {
+        return scalar_expression_time_;
+    }
+
+    /// @copydoc scalar_expression_time()
+    [[nodiscard]] duration_type scalar_expression_time() const noexcept {
+        return scalar_expression_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of analyzing query expressions.
+     * @return the elapsed time of query expression analysis
+     */
+    [[nodiscard]] duration_type& query_expression_time() noexcept {
+        return query_expression_time_;
+    }
+
+    /// @copydoc query_expression_time()
+    [[nodiscard]] duration_type query_expression_time() const noexcept {
+        return query_expression_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of resolving types of the individual expressions.
+     * @return the elapsed time of type resolution
+     */
+    [[nodiscard]] duration_type& type_resolution_time() noexcept {
+        return type_resolution_time_;
+    }
+
+    /// @copydoc type_resolution_time()
+    [[nodiscard]] duration_type type_resolution_time() const noexcept {
+        return type_resolution_time_;
+    }
+
+    /**
+     * @brief returns the number of relational operators in the resulting execution plan.
+     * @return the number of relational operators
+     * @return 0 if the result is not an execution plan
+     */
+    [[nodiscard]] size_type& relation_count() noexcept {
+        return relation_count_;
+    }
+
+    /// @copydoc relation_count()
+    [[nodiscard]] size_type relation_count() const noexcept {
+        return relation_count_;
+    }
+
+    /**
+     * @brief returns the number of variables declared by the analyzer.
+     * @return the number of stream and local variables
+     */
+    [[nodiscard]] size_type& variable_count() noexcept {
+        return variable_count_;
+    }
+
+    /// @copydoc variable_count()
+    [[nodiscard]] size_type variable_count() const noexcept {
+        return variable_count_;
+    }
+
+    /**
+     * @brief returns the number of reported diagnostics.
+     * @return the number of diagnostics
+     */
+    [[nodiscard]] size_type& diagnostic_count() noexcept {
+        return diagnostic_count_;
+    }
+
+    /// @copydoc diagnostic_count()
+    [[nodiscard]] size_type diagnostic_count() const noexcept {
+        return diagnostic_count_;
+    }
+
+    /**
+     * @brief returns the estimated memory usage of the analysis, in bytes.
+     * @return the estimated memory usage
+     * @see sql_analyzer_options::memory_budget()
+     */
+    [[nodiscard]] size_type& memory_usage() noexcept {
+        return memory_usage_;
+    }
+
+    /// @copydoc memory_usage()
+    [[nodiscard]] size_type memory_usage() const noexcept {
+        return memory_usage_;
+    }
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output
+     */
+    friend std::ostream& operator<<(std::ostream& out, sql_analyzer_metrics const& value) {
+        return out << "sql_analyzer_metrics("
+                   << "total_time=" << value.total_time_.count() << "ns, "
+                   << "name_resolution_time=" << value.name_resolution_time_.count() << "ns, "
+                   << "scalar_expression_time=" << value.scalar_expression_time_.count() << "ns, "
+                   << "query_expression_time=" << value.query_expression_time_.count() << "ns, "
+                   << "type_resolution_time=" << value.type_resolution_time_.count() << "ns, "
+                   << "relation_count=" << value.relation_count_ << ", "
+                   << "variable_count=" << value.variable_count_ << ", "
+                   << "diagnostic_count=" << value.diagnostic_count_ << ", "
+                   << "memory_usage=" << value.memory_usage_ << ")";
+    }
+
+private:
+    duration_type total_time_ {};
+    duration_type name_resolution_time_ {};
+    duration_type scalar_expression_time_ {};
+    duration_type query_expression_time_ {};
+    duration_type type_resolution_time_ {};
+    size_type relation_count_ {};
+    size_type variable_count_ {};
+    size_type diagnostic_count_ {};
+    size_type memory_usage_ {};
+};
+
+} // namespace mizugaki::analyzer
@@ -9,6 +9,9 @@
 
 #include <takatori/util/maybe_shared_ptr.h>
 
+#include <mizugaki/cancellation_token.h>
+#include <mizugaki/statement_statistics.h>
+
 #include <yugawara/schema/catalog.h>
 #include <yugawara/schema/search_path.h>
 
@@ -132,6 +135,54 @@ public:
      */
     static constexpr bool default_cast_literals_in_context = true;
 
+    /**
+     * @brief the default value of whether to fold scalar expressions which only consist of constant values.
+     * @see fold_constant_expressions()
+     */
+    static constexpr bool default_fold_constant_expressions = false;
+
+    /**
+     * @brief the default value of whether to remove table scan columns which are never referenced.
+     * @see prune_scan_columns()
+     */
+    static constexpr bool default_prune_scan_columns = false;
+
+    /**
+     * @brief the default value of whether to convert equivalent conditions on the primary key into point lookups.
+     * @see primary_key_lookup()
+     */
+    static constexpr bool default_primary_key_lookup = false;
+
+    /**
+     * @brief the default value of whether to resolve the relational operators in batch.
+     * @see batch_relation_resolution()
+     */
+    static constexpr bool default_batch_relation_resolution = false;
+
+    /**
+     * @brief the default value of whether to share the common expressions between clauses in queries.
+     * @see eliminate_common_subexpressions()
+     */
+    static constexpr bool default_eliminate_common_subexpressions = false;
+
+    /**
+     * @brief the default value of the minimum size of literal values which are not shared.
+     * @see large_literal_threshold()
+     */
+    static constexpr size_type default_large_literal_threshold = 64 * 1024;
+
+    /**
+     * @brief the default value of the memory budget of each analysis.
+     * @see memory_budget()
+     */
+    static constexpr size_type default_memory_budget = 0;
+
+    /**
+     * @brief the default value of whether to record performance metrics of the analysis.
+     * @see enable_metrics()
+     */
+    static constexpr bool default_enable_metrics = false;
+
     /**
      * @brief the default value of the default to enable to wrap the seuqnce values.
      * @see default_sequence_cycle()
@@ -511,6 +562,186 @@ public:
         return cast_literals_in_context_;
     }
 
+    /**
+     * @brief returns whether to fold scalar expressions which only consist of constant values.
+     * @details If enabled, the analyzer evaluates deterministic operations on immediate values
+     *      (e.g. `1 + 2 * 3`, `'a' || 'b'`, or `CAST('2024-01-01' AS DATE)`),
+     *      and then replaces them with the resulting immediate values.
+     *      Operations which may raise errors (e.g. overflow or division by zero) are never folded,
+     *      and they will be reported at run-time as usual.
+     * @return true if constant folding is enabled
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& fold_constant_expressions() noexcept {
+        return fold_constant_expressions_;
+    }
+
+    /// @copydoc fold_constant_expressions()
+    [[nodiscard]] bool const& fold_constant_expressions() const noexcept {
+        return fold_constant_expressions_;
+    }
+
+    /**
+     * @brief returns whether to remove table scan columns which are never referenced in query statements.
+     * @details If this is enabled, each table scan only provides the columns referred from the statement,
+     *      so that the size of the resulting plan does not depend on the number of table columns.
+     *      Otherwise, table scans always provide all columns of the individual tables.
+     * @return true if unused scan columns are removed
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& prune_scan_columns() noexcept {
+        return prune_scan_columns_;
+    }
+
+    /// @copydoc prune_scan_columns()
+    [[nodiscard]] bool const& prune_scan_columns() const noexcept {
+        return prune_scan_columns_;
+    }
+
+    /**
+     * @brief returns whether to convert equivalent conditions on the whole primary key into point lookups.
+     * @details If this is enabled, the analyzer moves the conditions `<key-column> = <value>` in WHERE clause
+     *      into the range of the table scan, when the values are constants or host parameters,
+     *      and they cover all the primary key columns.
+     *      Integer literals are also accepted for narrower integer key columns (e.g. `INT`) if they fit into them.
+     *      This only applies to SELECT, UPDATE, and DELETE statements whose table is directly filtered by the condition.
+     *      Otherwise, table scans are always unbounded and the conditions are left in the filter operators,
+     *      and they are converted in the later optimization phase of the compiler.
+     * @return true if point lookups are built in the analyzer
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& primary_key_lookup() noexcept {
+        return primary_key_lookup_;
+    }
+
+    /// @copydoc primary_key_lookup()
+    [[nodiscard]] bool const& primary_key_lookup() const noexcept {
+        return primary_key_lookup_;
+    }
+
+    /**
+     * @brief returns whether to resolve the relational operators in batch.
+     * @details If this is enabled, the analyzer defers type resolution of relational operators which never define
+     *      any variables (e.g. filters, joins, and limits), and resolves them at once for each query expression.
+     *      Otherwise, the analyzer resolves each relational operator just after it was built.
+     *      Note that, the reported diagnostics may be in different order between the two modes.
+     * @return true if the relational operators are resolved in batch
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& batch_relation_resolution() noexcept {
+        return batch_relation_resolution_;
+    }
+
+    /// @copydoc batch_relation_resolution()
+    [[nodiscard]] bool const& batch_relation_resolution() const noexcept {
+        return batch_relation_resolution_;
+    }
+
+    /**
+     * @brief returns whether to share the common expressions between clauses in queries.
+     * @details If this is enabled, each sort key in ORDER BY clause reuses the column which computes
+     *      the structurally equivalent expression in the select list or the preceding sort keys,
+     *      instead of computing it again.
+     * @return true if the common expressions are shared
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& eliminate_common_subexpressions() noexcept {
+        return eliminate_common_subexpressions_;
+    }
+
+    /// @copydoc eliminate_common_subexpressions()
+    [[nodiscard]] bool const& eliminate_common_subexpressions() const noexcept {
+        return eliminate_common_subexpressions_;
+    }
+
+    /**
+     * @brief returns the minimum size of literal values which are not shared.
+     * @details The analyzer usually shares the equivalent literal values in an analysis,
+     *      but it requires computing the hash code of the values.
+     *      The character and binary string literals whose size in bytes is greater than or equal to this
+     *      are never shared, to avoid scanning the large values again.
+     *      If this is `0`, all literal values are shared.
+     * @return the minimum size of literal values which are not shared
+     * @see #default_large_literal_threshold
+     */
+    [[nodiscard]] size_type& large_literal_threshold() noexcept {
+        return large_literal_threshold_;
+    }
+
+    /// @copydoc large_literal_threshold()
+    [[nodiscard]] size_type const& large_literal_threshold() const noexcept {
+        return large_literal_threshold_;
+    }
+
+    /**
+     * @brief returns the memory budget of each analysis, in bytes.
+     * @details The analyzer estimates the memory usage from the intermediate objects it creates,
+     *      like scalar expressions, relational operators and their columns, interned types and values,
+     *      the column lists of relations, and literal values.
+     *      If the estimation exceeds this budget, the analysis is aborted and reports
+     *      sql_analyzer_code::memory_budget_exceeded.
+     *      If this is `0`, the memory usage is not limited.
+     * @return the memory budget in bytes
+     * @see #default_memory_budget
+     */
+    [[nodiscard]] size_type& memory_budget() noexcept {
+        return memory_budget_;
+    }
+
+    /// @copydoc memory_budget()
+    [[nodiscard]] size_type const& memory_budget() const noexcept {
+        return memory_budget_;
+    }
+
+    /**
+     * @brief returns whether to record performance metrics of the analysis.
+     * @details If this is disabled, the analyzer never measures elapsed time of the individual phases.
+     * @return true if the analyzer records metrics into sql_analyzer_result::metrics()
+     * @return false otherwise
+     */
+    [[nodiscard]] bool& enable_metrics() noexcept {
+        return enable_metrics_;
+    }
+
+    /// @copydoc enable_metrics()
+    [[nodiscard]] bool const& enable_metrics() const noexcept {
+        return enable_metrics_;
+    }
+
+    /**
+     * @brief returns the token to interrupt analysis operations.
+     * @details The analyzer checks this token periodically while analyzing expressions and relational operators,
+     *      and then fails with sql_analyzer_code::cancelled or sql_analyzer_code::deadline_exceeded
+     *      if it was cancelled or has exceeded the deadline.
+     *      The default token never interrupts the analyzer.
+     * @return the cancellation token
+     */
+    [[nodiscard]] cancellation_token& cancellation() noexcept {
+        return cancellation_;
+    }
+
+    /// @copydoc cancellation()
+    [[nodiscard]] cancellation_token const& cancellation() const noexcept {
+        return cancellation_;
+    }
+
+    /**
+     * @brief returns the statistics registry which collects the statistics of each analysis operation.
+     * @details The statistics are recorded for each statement, keyed by the fingerprint of its source text.
+     *      Statements without their source document are not recorded.
+     * @return the statistics registry
+     * @return empty if it is disabled
+     * @see parser::compute_sql_fingerprint()
+     */
+    [[nodiscard]] std::shared_ptr<statement_statistics>& statistics() noexcept {
+        return statistics_;
+    }
+
+    /// @copydoc statistics()
+    [[nodiscard]] std::shared_ptr<statement_statistics> const& statistics() const noexcept {
+        return statistics_;
+    }
+
     /**
      * @brief returns whether to wrap the sequence values.
      * @return true if the sequence values are wrapped
@@ -582,6 +813,16 @@ private:
     bool allow_context_independent_null_ { default_allow_context_independent_null };
     bool validate_scalar_expressions_ { default_validate_scalar_expressions };
     bool cast_literals_in_context_ { default_cast_literals_in_context };
+    bool fold_constant_expressions_ { default_fold_constant_expressions };
+    bool prune_scan_columns_ { default_prune_scan_columns };
+    bool primary_key_lookup_ { default_primary_key_lookup };
+    bool batch_relation_resolution_ { default_batch_relation_resolution };
+    bool eliminate_common_subexpressions_ { default_eliminate_common_subexpressions };
+    size_type large_literal_threshold_ { default_large_literal_threshold };
+    size_type memory_budget_ { default_memory_budget };
+    bool enable_metrics_ { default_enable_metrics };
+    std::shared_ptr<statement_statistics> statistics_ {};
+    cancellation_token cancellation_ {};
     bool default_sequence_cycle_ { default_default_sequence_cycle };
 
     std::string_view advance_sequence_function_name_ { default_advance_sequence_function_name };
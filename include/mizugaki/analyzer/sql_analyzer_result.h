@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
 #include <vector>
 
@@ -11,6 +12,7 @@
 
 #include "sql_analyzer_result_kind.h"
 #include "sql_analyzer_code.h"
+#include "sql_analyzer_metrics.h"
 
 namespace mizugaki::analyzer {
 
@@ -215,6 +217,20 @@ public:
         return std::move(std::get<static_cast<std::size_t>(Kind)>(entity_));
     }
 
+    /**
+     * @brief returns the performance metrics of the analysis.
+     * @return the metrics
+     * @return empty if sql_analyzer_options::enable_metrics() is not set
+     */
+    [[nodiscard]] std::optional<sql_analyzer_metrics>& metrics() noexcept {
+        return metrics_;
+    }
+
+    /// @copydoc metrics()
+    [[nodiscard]] std::optional<sql_analyzer_metrics> const& metrics() const noexcept {
+        return metrics_;
+    }
+
     /**
      * @brief appends string representation of the given value.
      * @param out the target output
@@ -225,6 +241,7 @@ public:
 
 private:
     entity_type entity_;
+    std::optional<sql_analyzer_metrics> metrics_ {};
 };
 
 } // namespace mizugaki::analyzer
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <takatori/value/data.h>
+
+#include <takatori/util/sequence_view.h>
+
+#include <yugawara/variable/declaration.h>
+
+#include <mizugaki/placeholder_map.h>
+
+#include "sql_analyzer_result.h"
+
+namespace mizugaki::analyzer {
+
+/**
+ * @brief an analyzed statement whose host parameters are left as parameter slots.
+ * @details This holds the analysis result which refers each host parameter as a variable reference,
+ *      so that clients can bind the individual parameter values via bind() without re-analyzing the statement.
+ * @see sql_analyzer::prepare()
+ */
+class sql_prepared_statement {
+public:
+    /// @brief the analysis result type.
+    using result_type = sql_analyzer_result;
+
+    /// @brief the diagnostic information type.
+    using diagnostic_type = result_type::diagnostic_type;
+
+    /// @brief the parameter slot type.
+    using parameter_type = std::shared_ptr<::yugawara::variable::declaration const>;
+
+    /// @brief the parameter value type.
+    using value_type = std::shared_ptr<::takatori::value::data const>;
+
+    /**
+     * @brief a result of bind().
+     */
+    class binding {
+    public:
+        /**
+         * @brief creates a new invalid instance.
+         */
+        binding() = default;
+
+        /**
+         * @brief creates a new valid instance.
+         * @param values the bound values, ordered as parameters()
+         */
+        explicit binding(std::vector<value_type> values) noexcept;
+
+        /**
+         * @brief creates a new invalid instance.
+         * @param diagnostics the diagnostics
+         */
+        explicit binding(std::vector<diagnostic_type> diagnostics) noexcept;
+
+        /**
+         * @brief returns whether or not this is valid result.
+         * @return true if this is a valid result
+         * @return false otherwise
+         */
+        [[nodiscard]] bool is_valid() const noexcept;
+
+        /// @copydoc is_valid()
+        [[nodiscard]] explicit operator bool() const noexcept;
+
+        /**
+         * @brief returns the bound values.
+         * @details The individual values are corresponded to sql_prepared_statement::parameters() by their index.
+         * @return the bound values
+         * @return empty if this is not valid
+         */
+        [[nodiscard]] ::takatori::util::sequence_view<value_type const> values() const noexcept;
+
+        /**
+         * @brief returns the diagnostics.
+         * @return the diagnostics
+         * @return empty if this is valid
+         */
+        [[nodiscard]] ::takatori::util::sequence_view<diagnostic_type const> diagnostics() const noexcept;
+
+    private:
+        std::optional<std::vector<value_type>> values_ {};
+        std::vector<diagnostic_type> diagnostics_ {};
+    };
+
+    /**
+     * @brief creates a new invalid instance.
+     */
+    sql_prepared_statement() = default;
+
+    /**
+     * @brief creates a new instance.
+     * @param result the analysis result
+     * @param parameters the referred host parameters, in order of their first appearance
+     */
+    sql_prepared_statement(result_type result, std::vector<parameter_type> parameters) noexcept;
+
+    /**
+     * @brief returns whether or not this statement was successfully analyzed.
+     * @return true if this is valid
+     * @return false otherwise
+     */
+    [[nodiscard]] bool is_valid() const noexcept;
+
+    /// @copydoc is_valid()
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /**
+     * @brief returns the analysis result.
+     * @details The host parameters in the result are represented as variable references to parameters().
+     * @return the analysis result
+     */
+    [[nodiscard]] result_type const& result() const noexcept;
+
+    /**
+     * @brief returns the parameter slots of this statement.
+     * @return the host parameters referred from this statement, in order of their first appearance
+     */
+    [[nodiscard]] ::takatori::util::sequence_view<parameter_type const> parameters() const noexcept;
+
+    /**
+     * @brief returns the parameter slot index of the given name.
+     * @param name the host parameter name
+     * @return the corresponded index of parameters()
+     * @return empty if there is no such the parameter
+     */
+    [[nodiscard]] std::optional<std::size_t> find_parameter(std::string_view name) const noexcept;
+
+    /**
+     * @brief binds values to the individual parameter slots.
+     * @details This only looks up the values and checks their types,
+     *      that is, the statement is never analyzed again.
+     * @param values the parameter values, keyed by the host parameter name
+     * @return the bound values
+     * @return invalid result if some parameters are not bound, or they have inconsistent types
+     */
+    [[nodiscard]] binding bind(placeholder_map const& values) const;
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output stream
+     */
+    friend std::ostream& operator<<(std::ostream& out, sql_prepared_statement const& value);
+
+private:
+    result_type result_ {};
+    std::vector<parameter_type> parameters_ {};
+};
+
+} // namespace mizugaki::analyzer
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <takatori/document/document.h>
+#include <takatori/util/maybe_shared_ptr.h>
+
+#include "compilation_unit.h"
+
+/**
+ * @brief provides a compact binary encoding of the AST structure.
+ * @details The encoded data consists of a format header, the source document location, the top level statements,
+ *      and the comment regions. Each node is written in pre-order as its node kind, its region, and its properties.
+ *      Every region is included, and is encoded as a difference from the previously written one.
+ *      Every identifier and character string is interned, so that repeated names are written only once,
+ *      and the subsequent occurrences are encoded as small integers.
+ *
+ *      The encoded data never contains memory addresses: nodes are identified only by their position in the data,
+ *      so that the data can be stored into a local file or a shared memory, and then decoded in other processes.
+ *      The decoder reads the data in a single pass, and rebuilds an equivalent compilation unit.
+ */
+namespace mizugaki::ast::binary_format {
+
+/// @brief the magic number of the encoded data.
+constexpr std::string_view magic { "MZAB" };
+
+/// @brief the current format version.
+constexpr std::uint8_t version = 2;
+
+/**
+ * @brief the default limit of node nesting depth on decoding.
+ * @details The encoded data may not come from the parser, so that its tree depth is not limited by
+ *      sql_parser_options::tree_depth_limit().
+ */
+constexpr std::size_t default_tree_depth_limit = 1'000;
+
+/**
+ * @brief encodes the given compilation unit.
+ * @details The result includes the top level statements with their node regions, the comment regions,
+ *      and the location of the source document.
+ * @param value the target compilation unit
+ * @return the encoded data
+ */
+[[nodiscard]] std::string encode(compilation_unit const& value);
+
+/**
+ * @brief decodes the encoded data into a compilation unit.
+ * @details The source document is not a part of the encoded data.
+ *      If the document is given, it must have the same location as the document of the encoded compilation unit,
+ *      and the resulting compilation unit will refer it.
+ *
+ *      This never throws on broken data: every node kind and enumerator is validated,
+ *      and nodes nested deeper than the given limit are rejected, to avoid running out of the stack.
+ * @param data the encoded data
+ * @param document the source document of the encoded compilation unit, or empty to omit it
+ * @param tree_depth_limit the limit of node nesting depth, or 0 to disable to limit
+ * @return the decoded compilation unit
+ * @return empty if the data is broken, it was encoded with an unsupported format version,
+ *      the given document has a different location, or nodes are nested deeper than the limit
+ */
+[[nodiscard]] std::unique_ptr<compilation_unit> decode(
+        std::string_view data,
+        ::takatori::util::maybe_shared_ptr<::takatori::document::document const> document = {},
+        std::size_t tree_depth_limit = default_tree_depth_limit);
+
+} // namespace mizugaki::ast::binary_format
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+namespace mizugaki {
+
+/**
+ * @brief represents whether an operation should be interrupted.
+ * @see cancellation_token
+ */
+enum class cancellation_status {
+    /// @brief the operation can continue.
+    none,
+
+    /// @brief the operation was cancelled.
+    cancelled,
+
+    /// @brief the operation has exceeded its deadline.
+    deadline_exceeded,
+};
+
+/**
+ * @brief returns string representation of the value.
+ * @param value the target value
+ * @return the corresponded string representation
+ */
+inline constexpr std::string_view to_string_view(cancellation_status value) noexcept {
+    using namespace std::string_view_literals;
+    using kind = cancellation_status;
+    switch (value) {
+        case kind::none: return "none"sv;
+        case kind::cancelled: return "cancelled"sv;
+        case kind::deadline_exceeded: return "deadline_exceeded"sv;
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends string representation of the given value.
+ * @param out the target output
+ * @param value the target value
+ * @return the output
+ */
+inline std::ostream& operator<<(std::ostream& out, cancellation_status value) {
+    return out << to_string_view(value);
+}
+
+/**
+ * @brief requests to interrupt long running operations cooperatively.
+ * @details The parser and analyzer periodically check this token while they are working,
+ *      and then abort the operation with a diagnostic if it was cancelled or it has exceeded the deadline.
+ *
+ *      The copies of a token share the same cancellation state,
+ *      so that a thread can cancel the operations which are running on the other threads.
+ *      This object is thread-safe.
+ * @see sql_parser_options::cancellation()
+ * @see sql_analyzer_options::cancellation()
+ */
+class cancellation_token {
+public:
+    /// @brief the clock type.
+    using clock = std::chrono::steady_clock;
+
+    /// @brief the time point type.
+    using time_point_type = clock::time_point;
+
+    /// @brief the duration type.
+    using duration_type = clock::duration;
+
+    /**
+     * @brief creates a new token which never interrupts operations.
+     */
+    cancellation_token() noexcept = default;
+
+    /**
+     * @brief creates a new token which can be cancelled.
+     * @return the created token
+     * @see cancel()
+     */
+    [[nodiscard]] static cancellation_token create();
+
+    /**
+     * @brief creates a new token which can be cancelled, and is expired at the given time.
+     * @param deadline the deadline
+     * @return the created token
+     */
+    [[nodiscard]] static cancellation_token with_deadline(time_point_type deadline);
+
+    /**
+     * @brief creates a new token which can be cancelled, and is expired after the given duration.
+     * @param timeout the duration from now
+     * @return the created token
+     */
+    [[nodiscard]] static cancellation_token with_timeout(duration_type timeout);
+
+    /**
+     * @brief requests to cancel the operations which refer this token or its copies.
+     * @details This does nothing if this token is not cancellable.
+     */
+    void cancel() const noexcept;
+
+    /**
+     * @brief returns whether or not this token can be cancelled.
+     * @return true if this is cancellable
+     * @return false otherwise
+     */
+    [[nodiscard]] bool cancellable() const noexcept;
+
+    /**
+     * @brief returns the deadline of this token.
+     * @return the deadline
+     * @return empty if it is not set
+     */
+    [[nodiscard]] std::optional<time_point_type> const& deadline() const noexcept;
+
+    /**
+     * @brief returns the current status of this token.
+     * @details This only reads the clock if the deadline is set.
+     * @return the current status
+     */
+    [[nodiscard]] cancellation_status status() const noexcept;
+
+    /**
+     * @brief returns whether or not this token may interrupt operations.
+     * @return true if this is cancellable or has a deadline
+     * @return false otherwise
+     */
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+private:
+    std::shared_ptr<std::atomic_bool> cancelled_ {};
+    std::optional<time_point_type> deadline_ {};
+};
+
+} // namespace mizugaki
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <takatori/document/position.h>
+
+#include <cstddef>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief an index of line beginning offsets in document contents.
+ * @details The index is built on the first lookup, so that documents without any diagnostics never pay for it.
+ *      After that, each lookup takes `O(log N)` time, where `N` is the number of lines.
+ *
+ *      The lookup operations are thread-safe, but they must always receive the same contents.
+ */
+class line_index {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /**
+     * @brief creates a new empty instance.
+     */
+    line_index() = default;
+
+    ~line_index() = default;
+
+    line_index(line_index const& other) = delete;
+    line_index& operator=(line_index const& other) = delete;
+    line_index(line_index&& other) noexcept = delete;
+    line_index& operator=(line_index&& other) noexcept = delete;
+
+    /**
+     * @brief returns the contents of the given line.
+     * @param contents the document contents
+     * @param line_number the line number (1-origin)
+     * @return the line contents, without its line terminator
+     * @return empty if there is no such the line
+     */
+    [[nodiscard]] std::string_view line(std::string_view contents, size_type line_number) const;
+
+    /**
+     * @brief returns the line and column number of the given offset.
+     * @param contents the document contents
+     * @param offset the byte offset in the contents (0-origin)
+     * @return the corresponded position (1-origin)
+     */
+    [[nodiscard]] ::takatori::document::position position(std::string_view contents, size_type offset) const;
+
+    /**
+     * @brief returns whether or not the index has been built.
+     * @return true if it has been built
+     * @return false otherwise
+     */
+    [[nodiscard]] bool is_built() const noexcept;
+
+private:
+    mutable std::once_flag once_ {};
+    mutable std::vector<size_type> offsets_ {};
+    mutable std::atomic_bool built_ { false };
+
+    [[nodiscard]] std::vector<size_type> const& offsets(std::string_view contents) const;
+};
+
+} // namespace mizugaki::parser
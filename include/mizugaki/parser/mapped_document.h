@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <takatori/document/document.h>
+#include <takatori/document/position.h>
+
+#include <cstddef>
+
+#include "line_index.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief a read-only document whose contents are mapped from a file.
+ * @details The file contents are not loaded into the heap memory, and the OS pages them in on demand.
+ *      The line index, which is required to compute line and column numbers, is not built until
+ *      line() or position() is called for the first time.
+ *
+ *      This object is not copyable nor movable; share it via `std::shared_ptr` instead.
+ * @attention the file must not be modified while this document is alive.
+ */
+class mapped_document : public ::takatori::document::document {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /**
+     * @brief maps the contents of the given file.
+     * @param path the file path, which is also used as the document location
+     * @throws std::system_error if the file cannot be opened or mapped
+     */
+    explicit mapped_document(std::string path);
+
+    ~mapped_document() override;
+
+    mapped_document(mapped_document const& other) = delete;
+    mapped_document& operator=(mapped_document const& other) = delete;
+    mapped_document(mapped_document&& other) noexcept = delete;
+    mapped_document& operator=(mapped_document&& other) noexcept = delete;
+
+    [[nodiscard]] std::string_view location() const noexcept override;
+    [[nodiscard]] std::string_view contents(size_type position, size_type size) const noexcept override;
+    [[nodiscard]] size_type size() const noexcept override;
+    [[nodiscard]] std::string_view line(size_type line_number) const noexcept override;
+    [[nodiscard]] ::takatori::document::position position(size_type offset) const noexcept override;
+
+private:
+    std::string location_;
+    char const* data_ {};
+    size_type size_ {};
+    line_index lines_ {};
+
+    [[nodiscard]] std::string_view all_contents() const noexcept;
+};
+
+} // namespace mizugaki::parser
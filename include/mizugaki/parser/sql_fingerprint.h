@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "sql_token_stream.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief computes the fingerprint of the rest tokens in the given stream.
+ * @details The fingerprint only reflects the statement shape, that is, the following differences are ignored:
+ *
+ *      - white spaces and comments
+ *      - values of literals, placeholders, and host parameter names
+ *      - letter case of keywords and regular identifiers
+ *      - trailing semicolons
+ *
+ *      This consumes the all rest tokens in the stream.
+ * @param stream the source token stream
+ * @return the fingerprint
+ */
+[[nodiscard]] std::uint64_t compute_sql_fingerprint(sql_token_stream& stream);
+
+} // namespace mizugaki::parser
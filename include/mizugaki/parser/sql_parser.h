@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <takatori/document/document.h>
@@ -8,6 +9,8 @@
 
 #include "sql_parser_options.h"
 #include "sql_parser_result.h"
+#include "sql_parser_session.h"
+#include "sql_text_edit.h"
 
 namespace mizugaki::parser {
 
@@ -39,7 +42,7 @@ public:
 
     /**
      * @brief parses the contents.
-     * @details This operation creates a new document object, and then the resulting compilation unit will hold
+     * @details This operation creates a new string_document object, and then the resulting compilation unit will hold
      *      the ownership of the created document object.
      * @param location the content location
      * @param contents the target contents
@@ -54,6 +57,37 @@ public:
      */
     [[nodiscard]] result_type operator()(::takatori::util::maybe_shared_ptr<document_type const> document) const;
 
+    /**
+     * @brief parses the previous contents with the given text edit.
+     * @details This re-parses only the statements which overlap with the edited range, and reuses the other
+     *      statements of the previous compilation unit. The regions in the following statements are moved
+     *      by the difference of the text length before and after the edit.
+     *      The preceding statements are not reused if the text before the edit contains any placeholders,
+     *      and the following statements are not reused if they contain any placeholders.
+     *      If the number of statements is limited by sql_parser_options::element_limits(), this parses the whole
+     *      edited contents instead.
+     *
+     *      The resulting compilation unit will hold a new string_document of the edited contents, with the
+     *      same location of the previous document.
+     *
+     *      The previous compilation unit is released only if this operation was succeeded.
+     *      Otherwise, it is left as is, so that the caller can re-parse it again with another edit,
+     *      which must be relative to the source document of the previous compilation unit.
+     * @param previous the previous compilation unit, which must hold its source document
+     * @param edit the text edit to the previous source document
+     * @return the parsed result
+     * @throws std::invalid_argument if the previous unit does not have its document, or the edit is out of range
+     */
+    [[nodiscard]] result_type reparse(std::unique_ptr<ast::compilation_unit>& previous, sql_text_edit const& edit) const;
+
+    /**
+     * @brief creates a new parser session with the current options.
+     * @details The session reuses its internal buffers over multiple parse operations,
+     *      so that it is suitable for parsing many short statements in the same thread.
+     * @return the created session
+     */
+    [[nodiscard]] sql_parser_session create_session() const;
+
 private:
     sql_parser_options options_;
 };
@@ -36,6 +36,12 @@ enum class sql_parser_code {
 
     /// @brief the declared elements exceeds the limit of count.
     exceed_number_of_elements,
+
+    /// @brief the parse operation was cancelled.
+    cancelled,
+
+    /// @brief the parse operation has exceeded its deadline.
+    deadline_exceeded,
 };
 
 /**
@@ -56,6 +62,8 @@ inline constexpr std::string_view to_string_view(sql_parser_code value) noexcept
         case kind::unexpected_token: return "unexpected_token"sv;
         case kind::unexpected_eof: return "unexpected_eof"sv;
         case kind::exceed_number_of_elements: return "exceed_number_of_elements"sv;
+        case kind::cancelled: return "cancelled"sv;
+        case kind::deadline_exceeded: return "deadline_exceeded"sv;
     }
     std::abort();
 }
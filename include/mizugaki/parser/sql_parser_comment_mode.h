@@ -0,0 +1,52 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief represents how the SQL parser collects comments in the source document.
+ */
+enum class sql_parser_comment_mode {
+    /// @brief collects all comments.
+    all = 0,
+
+    /**
+     * @brief collects only block comments which can be description comments of declarations.
+     * @details The other comments are just skipped, and they will not appear in compilation units.
+     */
+    description,
+
+    /// @brief never collects any comments.
+    none,
+};
+
+/**
+ * @brief returns string representation of the value.
+ * @param value the target value
+ * @return the corresponded string representation
+ */
+inline constexpr std::string_view to_string_view(sql_parser_comment_mode value) noexcept {
+    using namespace std::string_view_literals;
+    using kind = sql_parser_comment_mode;
+    switch (value) {
+        case kind::all: return "all"sv;
+        case kind::description: return "description"sv;
+        case kind::none: return "none"sv;
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends string representation of the given value.
+ * @param out the target output
+ * @param value the target value
+ * @return the output
+ */
+inline std::ostream& operator<<(std::ostream& out, sql_parser_comment_mode value) {
+    return out << to_string_view(value);
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief performance metrics of a parsing operation.
+ * @details This is only available if sql_parser_options::enable_metrics() is set.
+ * @see sql_parser_result::metrics()
+ */
+class sql_parser_metrics {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /// @brief the duration type.
+    using duration_type = std::chrono::nanoseconds;
+
+    /**
+     * @brief creates a new instance.
+     */
+    sql_parser_metrics() = default;
+
+    /**
+     * @brief returns the elapsed time of the lexical analysis.
+     * @return the elapsed time of scanning tokens
+     */
+    [[nodiscard]] duration_type& scan_time() noexcept;
+
+    /// @copydoc scan_time()
+    [[nodiscard]] duration_type scan_time() const noexcept;
+
+    /**
+     * @brief returns the elapsed time of the syntax analysis.
+     * @return the elapsed time of building the AST, excluding scan_time()
+     */
+    [[nodiscard]] duration_type& parse_time() noexcept;
+
+    /// @copydoc parse_time()
+    [[nodiscard]] duration_type parse_time() const noexcept;
+
+    /**
+     * @brief returns the elapsed time of validating the AST.
+     * @return the elapsed time of checking the tree node count and depth
+     * @return 0 if the AST was not built
+     */
+    [[nodiscard]] duration_type& validation_time() noexcept;
+
+    /// @copydoc validation_time()
+    [[nodiscard]] duration_type validation_time() const noexcept;
+
+    /**
+     * @brief returns the number of scanned tokens.
+     * @return the number of tokens, including the end of document
+     */
+    [[nodiscard]] size_type& token_count() noexcept;
+
+    /// @copydoc token_count()
+    [[nodiscard]] size_type token_count() const noexcept;
+
+    /**
+     * @brief returns the number of AST nodes allocated while parsing.
+     * @details This also includes the nodes which were discarded on error recovery.
+     * @return the number of allocated AST nodes
+     */
+    [[nodiscard]] size_type& node_allocation_count() noexcept;
+
+    /// @copydoc node_allocation_count()
+    [[nodiscard]] size_type node_allocation_count() const noexcept;
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output
+     */
+    friend std::ostream& operator<<(std::ostream& out, sql_parser_metrics const& value);
+
+private:
+    duration_type scan_time_ {};
+    duration_type parse_time_ {};
+    duration_type validation_time_ {};
+    size_type token_count_ {};
+    size_type node_allocation_count_ {};
+};
+
+} // namespace mizugaki::parser
@@ -3,6 +3,10 @@
 #include <memory>
 #include <utility>
 
+#include <mizugaki/cancellation_token.h>
+#include <mizugaki/statement_statistics.h>
+
+#include <mizugaki/parser/sql_parser_comment_mode.h>
 #include <mizugaki/parser/sql_parser_element_kind.h>
 
 namespace mizugaki::parser {
@@ -24,11 +28,45 @@ public:
     /// @brief default value of whether description comments are enabled for each declaration.
     static constexpr bool default_enable_description_comments = true;
 
+    /// @brief default value of how the parser collects comments.
+    static constexpr sql_parser_comment_mode default_comment_mode = sql_parser_comment_mode::all;
+
+    /// @brief default value of whether the parser records its performance metrics.
+    static constexpr bool default_enable_metrics = false;
+
     /**
      * @brief creates a new instance.
      */
     sql_parser_options();
 
+    ~sql_parser_options() = default;
+
+    /**
+     * @brief creates a copy of the given options.
+     * @param other the copy source
+     */
+    sql_parser_options(sql_parser_options const& other);
+
+    /**
+     * @brief assigns a copy of the given options into this.
+     * @param other the copy source
+     * @return this
+     */
+    sql_parser_options& operator=(sql_parser_options const& other);
+
+    /**
+     * @brief creates a new instance.
+     * @param other the move source
+     */
+    sql_parser_options(sql_parser_options&& other) noexcept = default;
+
+    /**
+     * @brief assigns the given object into this.
+     * @param other the move source
+     * @return this
+     */
+    sql_parser_options& operator=(sql_parser_options&& other) noexcept = default;
+
     /**
      * @brief sets the max number of next token candidates to display on error.
      * @param count the max number of candidates, or 0 to disable to display
@@ -81,6 +119,57 @@ public:
     /// @copydoc enable_description_comments()
     [[nodiscard]] bool const& enable_description_comments() const noexcept;
 
+    /**
+     * @brief returns how the parser collects comments.
+     * @details If the statements never use comments, sql_parser_comment_mode::none can reduce
+     *      the parsing overhead of comments.
+     *      Note that, description comments are not available if this is sql_parser_comment_mode::none.
+     * @return the comment collection mode
+     * @see default_comment_mode
+     */
+    [[nodiscard]] sql_parser_comment_mode& comment_mode() noexcept;
+
+    /// @copydoc comment_mode()
+    [[nodiscard]] sql_parser_comment_mode const& comment_mode() const noexcept;
+
+    /**
+     * @brief returns whether the parser records its performance metrics.
+     * @details If this is disabled, the parser never measures elapsed time of the individual phases.
+     * @return true if the parser records metrics into sql_parser_result::metrics()
+     * @return false otherwise
+     * @see default_enable_metrics
+     */
+    [[nodiscard]] bool& enable_metrics() noexcept;
+
+    /// @copydoc enable_metrics()
+    [[nodiscard]] bool const& enable_metrics() const noexcept;
+
+    /**
+     * @brief returns the token to interrupt parse operations.
+     * @details The parser checks this token periodically while reading tokens,
+     *      and then fails with sql_parser_code::cancelled or sql_parser_code::deadline_exceeded
+     *      if it was cancelled or has exceeded the deadline.
+     *      The default token never interrupts the parser.
+     * @return the cancellation token
+     */
+    [[nodiscard]] cancellation_token& cancellation() noexcept;
+
+    /// @copydoc cancellation()
+    [[nodiscard]] cancellation_token const& cancellation() const noexcept;
+
+    /**
+     * @brief returns the statistics registry which collects the statistics of each parse operation.
+     * @details The statistics are recorded for each document, keyed by its fingerprint.
+     *      If this is empty, the parser never computes the fingerprint.
+     * @return the statistics registry
+     * @return empty if it is disabled
+     * @see compute_sql_fingerprint()
+     */
+    [[nodiscard]] std::shared_ptr<statement_statistics>& statistics() noexcept;
+
+    /// @copydoc statistics()
+    [[nodiscard]] std::shared_ptr<statement_statistics> const& statistics() const noexcept;
+
     /**
      * @brief returns the debug level.
      * @return the debug level
@@ -98,6 +187,10 @@ private:
     size_type tree_node_limit_ { default_tree_node_limit };
     size_type tree_depth_limit_ { default_tree_depth_limit };
     bool enable_description_comments_ { default_enable_description_comments };
+    sql_parser_comment_mode comment_mode_ { default_comment_mode };
+    bool enable_metrics_ { default_enable_metrics };
+    std::shared_ptr<statement_statistics> statistics_ {};
+    cancellation_token cancellation_ {};
 };
 
 } // namespace mizugaki::parser
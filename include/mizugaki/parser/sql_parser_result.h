@@ -1,12 +1,13 @@
 #pragma once
 
+#include <optional>
 #include <string>
 
-
 #include <mizugaki/ast/compilation_unit.h>
 #include <mizugaki/ast/node_region.h>
 
 #include "sql_parser_diagnostic.h"
+#include "sql_parser_metrics.h"
 
 namespace mizugaki::parser {
 
@@ -111,12 +112,24 @@ public:
     /// @copydoc max_tree_depth()
     [[nodiscard]] std::size_t max_tree_depth() const noexcept;
 
+    /**
+     * @brief returns the performance metrics of the parsing operation.
+     * @return the metrics
+     * @return empty if sql_parser_options::enable_metrics() is not set
+     */
+    [[nodiscard]] std::optional<sql_parser_metrics>& metrics() noexcept;
+
+    /// @copydoc metrics()
+    [[nodiscard]] std::optional<sql_parser_metrics> const& metrics() const noexcept;
+
 private:
     value_type value_ {};
     diagnostic_type diagnostic_ {};
 
     std::size_t tree_node_count_ {};
     std::size_t max_tree_depth_ {};
+
+    std::optional<sql_parser_metrics> metrics_ {};
 };
 
 } // namespace mizugaki::parser
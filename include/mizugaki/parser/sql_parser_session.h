@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <takatori/document/document.h>
+
+#include <takatori/util/maybe_shared_ptr.h>
+
+#include "sql_parser_options.h"
+#include "sql_parser_result.h"
+#include "sql_text_edit.h"
+
+namespace mizugaki::parser {
+
+/// @cond
+class sql_parser_engine;
+/// @endcond
+
+/**
+ * @brief parses SQL text repeatedly, with reusing the internal buffers.
+ * @details sql_parser prepares its scanner, driver and parser objects for every parse operation.
+ *      This instead keeps them between parse operations, so that parsing many short statements
+ *      requires few setup allocations.
+ *
+ *      This object is not thread-safe, and it is designed to be kept by each thread.
+ * @see sql_parser::create_session()
+ */
+class sql_parser_session {
+public:
+    /// @brief the source document type.
+    using document_type = ::takatori::document::document;
+
+    /// @brief the result type.
+    using result_type = sql_parser_result;
+
+    /**
+     * @brief creates a new instance.
+     * @param options the parser options
+     */
+    explicit sql_parser_session(sql_parser_options options = {});
+
+    ~sql_parser_session();
+
+    sql_parser_session(sql_parser_session const& other) = delete;
+    sql_parser_session& operator=(sql_parser_session const& other) = delete;
+
+    /**
+     * @brief creates a new instance.
+     * @param other the move source
+     */
+    sql_parser_session(sql_parser_session&& other) noexcept;
+
+    /**
+     * @brief assigns the given object into this.
+     * @param other the move source
+     * @return this
+     */
+    sql_parser_session& operator=(sql_parser_session&& other) noexcept;
+
+    /**
+     * @brief returns the parser options.
+     * @return the parser options
+     */
+    [[nodiscard]] sql_parser_options& options() noexcept;
+
+    /// @copydoc options()
+    [[nodiscard]] sql_parser_options const& options() const noexcept;
+
+    /**
+     * @brief parses the contents.
+     * @details This operation creates a new document object, and then the resulting compilation unit will hold
+     *      the ownership of the created document object.
+     * @param location the content location
+     * @param contents the target contents
+     * @return the parsed result
+     */
+    [[nodiscard]] result_type operator()(std::string location, std::string contents);
+
+    /**
+     * @brief parses the contents in the given document.
+     * @param document the source document
+     * @return the parsed result
+     */
+    [[nodiscard]] result_type operator()(::takatori::util::maybe_shared_ptr<document_type const> document);
+
+    /**
+     * @brief parses the previous contents with the given text edit.
+     * @details This is equivalent to sql_parser::reparse(), but reuses the internal buffers of this session.
+     * @param previous the previous compilation unit, which must hold its source document,
+     *      and will be released only if the operation was succeeded
+     * @param edit the text edit to the previous source document
+     * @return the parsed result
+     * @throws std::invalid_argument if the previous unit does not have its document, or the edit is out of range
+     */
+    [[nodiscard]] result_type reparse(std::unique_ptr<ast::compilation_unit>& previous, sql_text_edit const& edit);
+
+private:
+    sql_parser_options options_;
+    std::unique_ptr<sql_parser_engine> engine_;
+};
+
+} // namespace mizugaki::parser
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <cstddef>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief represents a text edit on the source document.
+ * @details The edit replaces `removed` bytes from `offset` with the `inserted` text.
+ * @see sql_parser::reparse()
+ */
+class sql_text_edit {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /**
+     * @brief creates a new instance.
+     * @param offset the byte offset of the edit in the original contents
+     * @param removed the number of bytes removed from the original contents
+     * @param inserted the inserted text
+     */
+    sql_text_edit(size_type offset, size_type removed, std::string inserted) noexcept;
+
+    /**
+     * @brief returns the byte offset of the edit in the original contents.
+     * @return the byte offset
+     */
+    [[nodiscard]] size_type offset() const noexcept;
+
+    /**
+     * @brief returns the number of bytes removed from the original contents.
+     * @return the number of removed bytes
+     */
+    [[nodiscard]] size_type removed() const noexcept;
+
+    /**
+     * @brief returns the inserted text.
+     * @return the inserted text
+     */
+    [[nodiscard]] std::string const& inserted() const noexcept;
+
+    /**
+     * @brief returns whether or not this edit can be applied to the given contents.
+     * @param contents the original contents
+     * @return true if the edited range is in the contents
+     * @return false otherwise
+     */
+    [[nodiscard]] bool applicable(std::string_view contents) const noexcept;
+
+    /**
+     * @brief applies this edit to the given contents.
+     * @param contents the original contents
+     * @return the edited contents
+     * @attention undefined behavior if this edit is not applicable() to the contents
+     */
+    [[nodiscard]] std::string apply(std::string_view contents) const;
+
+private:
+    size_type offset_;
+    size_type removed_;
+    std::string inserted_;
+};
+
+} // namespace mizugaki::parser
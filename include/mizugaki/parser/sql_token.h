@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ostream>
+
+#include <mizugaki/ast/node_region.h>
+
+#include "sql_token_kind.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief represents a token in SQL text.
+ * @see sql_token_stream
+ */
+class sql_token {
+public:
+    /// @brief the token kind type.
+    using kind_type = sql_token_kind;
+
+    /// @brief the region type.
+    using region_type = ast::node_region;
+
+    /**
+     * @brief creates a new instance which represents the end of an empty document.
+     */
+    constexpr sql_token() noexcept = default;
+
+    /**
+     * @brief creates a new instance.
+     * @param kind the token kind
+     * @param region the token region in the source document
+     */
+    constexpr sql_token(kind_type kind, region_type region) noexcept :
+        kind_ { kind },
+        region_ { region }
+    {}
+
+    /**
+     * @brief returns the token kind.
+     * @return the token kind
+     */
+    [[nodiscard]] constexpr kind_type kind() const noexcept {
+        return kind_;
+    }
+
+    /**
+     * @brief returns the region of this token in the source document.
+     * @return the token region
+     */
+    [[nodiscard]] constexpr region_type region() const noexcept {
+        return region_;
+    }
+
+    /**
+     * @brief returns whether or not this token is a literal.
+     * @return true if this is a numeric, character string, or hex string literal
+     * @return false otherwise
+     */
+    [[nodiscard]] constexpr bool is_literal() const noexcept {
+        switch (kind_) {
+            case kind_type::unsigned_integer:
+            case kind_type::exact_numeric_literal:
+            case kind_type::approximate_numeric_literal:
+            case kind_type::character_string_literal:
+            case kind_type::hex_string_literal:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief returns whether or not this token is a comment.
+     * @return true if this is a comment, including unclosed one
+     * @return false otherwise
+     */
+    [[nodiscard]] constexpr bool is_comment() const noexcept {
+        return kind_ == kind_type::comment || kind_ == kind_type::unclosed_comment;
+    }
+
+private:
+    kind_type kind_ { kind_type::end_of_file };
+    region_type region_ { 0, 0 };
+};
+
+/**
+ * @brief appends string representation of the given value.
+ * @param out the target output
+ * @param value the target value
+ * @return the output
+ */
+inline std::ostream& operator<<(std::ostream& out, sql_token const& value) {
+    return out << value.kind() << value.region();
+}
+
+} // namespace mizugaki::parser
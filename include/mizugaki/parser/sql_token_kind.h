@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <cstdlib>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief represents a kind of tokens in SQL text.
+ * @see sql_token_stream
+ */
+enum class sql_token_kind {
+    /// @brief reserved or non-reserved keywords, like `SELECT`.
+    keyword = 0,
+
+    /// @brief regular identifiers, like `T0`.
+    regular_identifier,
+
+    /// @brief delimited identifiers, like `"T0"`.
+    delimited_identifier,
+
+    /// @brief host parameter names, like `:p0`.
+    host_parameter_name,
+
+    /// @brief placeholders (`?`).
+    placeholder,
+
+    /// @brief unsigned integer literals, like `100`.
+    unsigned_integer,
+
+    /// @brief exact numeric literals with decimal points, like `1.5`.
+    exact_numeric_literal,
+
+    /// @brief approximate numeric literals, like `1.5E3`.
+    approximate_numeric_literal,
+
+    /// @brief character string literals, like `'abc'`.
+    character_string_literal,
+
+    /// @brief hex string literals, like `X'0f'`.
+    hex_string_literal,
+
+    /// @brief operators and punctuations, like `<=` or `,`.
+    symbol,
+
+    /// @brief simple or bracketed comments.
+    comment,
+
+    /// @brief the head of a bracketed comment which is not closed until the end of document.
+    unclosed_comment,
+
+    /// @brief unrecognized characters.
+    error,
+
+    /// @brief the end of document.
+    end_of_file,
+};
+
+/**
+ * @brief returns string representation of the value.
+ * @param value the target value
+ * @return the corresponded string representation
+ */
+inline constexpr std::string_view to_string_view(sql_token_kind value) noexcept {
+    using namespace std::string_view_literals;
+    using kind = sql_token_kind;
+    switch (value) {
+        case kind::keyword: return "keyword"sv;
+        case kind::regular_identifier: return "regular_identifier"sv;
+        case kind::delimited_identifier: return "delimited_identifier"sv;
+        case kind::host_parameter_name: return "host_parameter_name"sv;
+        case kind::placeholder: return "placeholder"sv;
+        case kind::unsigned_integer: return "unsigned_integer"sv;
+        case kind::exact_numeric_literal: return "exact_numeric_literal"sv;
+        case kind::approximate_numeric_literal: return "approximate_numeric_literal"sv;
+        case kind::character_string_literal: return "character_string_literal"sv;
+        case kind::hex_string_literal: return "hex_string_literal"sv;
+        case kind::symbol: return "symbol"sv;
+        case kind::comment: return "comment"sv;
+        case kind::unclosed_comment: return "unclosed_comment"sv;
+        case kind::error: return "error"sv;
+        case kind::end_of_file: return "end_of_file"sv;
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends string representation of the given value.
+ * @param out the target output
+ * @param value the target value
+ * @return the output
+ */
+inline std::ostream& operator<<(std::ostream& out, sql_token_kind value) {
+    return out << to_string_view(value);
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include <takatori/document/document.h>
+
+#include <takatori/util/maybe_shared_ptr.h>
+
+#include <mizugaki/ast/node_region.h>
+
+#include "sql_token.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief splits SQL text into tokens, without building syntax trees.
+ * @details This uses the same scanner as sql_parser, so that the tokens are split exactly as the parser does.
+ *      Comments in the document are also returned as tokens, in order of their appearances.
+ *
+ *      This object keeps its internal buffers between documents, and then it does not allocate memory
+ *      for each token once the buffers grow large enough.
+ *      This object is not thread-safe, and it is designed to be kept by each thread.
+ */
+class sql_token_stream {
+public:
+    /// @brief the source document type.
+    using document_type = ::takatori::document::document;
+
+    /**
+     * @brief creates a new instance without any documents.
+     * @details Please call reset() to start reading a document.
+     */
+    sql_token_stream();
+
+    /**
+     * @brief creates a new instance.
+     * @param document the source document
+     */
+    explicit sql_token_stream(::takatori::util::maybe_shared_ptr<document_type const> document);
+
+    ~sql_token_stream();
+
+    sql_token_stream(sql_token_stream const& other) = delete;
+    sql_token_stream& operator=(sql_token_stream const& other) = delete;
+
+    /**
+     * @brief creates a new instance.
+     * @param other the move source
+     */
+    sql_token_stream(sql_token_stream&& other) noexcept;
+
+    /**
+     * @brief assigns the given object into this.
+     * @param other the move source
+     * @return this
+     */
+    sql_token_stream& operator=(sql_token_stream&& other) noexcept;
+
+    /**
+     * @brief starts reading the given document.
+     * @param document the source document, or empty to release the current document
+     */
+    void reset(::takatori::util::maybe_shared_ptr<document_type const> document);
+
+    /**
+     * @brief starts reading the given range of the document.
+     * @details The resulting token regions are still relative to the head of the document.
+     * @param document the source document
+     * @param range the target range in the document, must be a valid region
+     */
+    void reset(::takatori::util::maybe_shared_ptr<document_type const> document, ast::node_region range);
+
+    /**
+     * @brief returns the current source document.
+     * @return the source document
+     * @return empty if it is not set
+     */
+    [[nodiscard]] ::takatori::util::maybe_shared_ptr<document_type const> const& document() const noexcept;
+
+    /**
+     * @brief returns the next token.
+     * @return the next token
+     * @return sql_token_kind::end_of_file if the stream reached the end of document,
+     *      or it was stopped by an unclosed comment
+     */
+    [[nodiscard]] sql_token next();
+
+    /**
+     * @brief returns the text of the given token in the current document.
+     * @param token the target token
+     * @return the token text
+     */
+    [[nodiscard]] std::string_view image(sql_token token) const noexcept;
+
+private:
+    class impl;
+    std::unique_ptr<impl> impl_;
+};
+
+} // namespace mizugaki::parser
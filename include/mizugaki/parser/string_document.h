@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <takatori/document/document.h>
+#include <takatori/document/position.h>
+
+#include <cstddef>
+
+#include "line_index.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief a document which holds its contents as a string.
+ * @details The line index, which is required to compute line and column numbers, is not built until
+ *      line() or position() is called for the first time, and then it is cached in this document.
+ *
+ *      This object is not copyable nor movable; share it via `std::shared_ptr` instead.
+ * @see sql_parser::operator()(std::string, std::string)
+ */
+class string_document : public ::takatori::document::document {
+public:
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /**
+     * @brief creates a new instance.
+     * @param location the document location
+     * @param contents the document contents
+     */
+    string_document(std::string location, std::string contents) noexcept;
+
+    ~string_document() override = default;
+
+    string_document(string_document const& other) = delete;
+    string_document& operator=(string_document const& other) = delete;
+    string_document(string_document&& other) noexcept = delete;
+    string_document& operator=(string_document&& other) noexcept = delete;
+
+    [[nodiscard]] std::string_view location() const noexcept override;
+    [[nodiscard]] std::string_view contents(size_type position, size_type size) const noexcept override;
+    [[nodiscard]] size_type size() const noexcept override;
+    [[nodiscard]] std::string_view line(size_type line_number) const noexcept override;
+    [[nodiscard]] ::takatori::document::position position(size_type offset) const noexcept override;
+
+    /**
+     * @brief returns the line index of this document.
+     * @return the line index
+     */
+    [[nodiscard]] line_index const& lines() const noexcept;
+
+private:
+    std::string location_;
+    std::string contents_;
+    line_index lines_ {};
+};
+
+} // namespace mizugaki::parser
@@ -51,6 +51,18 @@ public:
      */
     placeholder_entry(::takatori::type::data&& type, ::takatori::value::data&& value);
 
+    /**
+     * @brief returns the value of this placeholder.
+     * @return the value
+     */
+    [[nodiscard]] std::shared_ptr<::takatori::value::data const> const& value() const noexcept;
+
+    /**
+     * @brief returns the type of this placeholder.
+     * @return the value type
+     */
+    [[nodiscard]] std::shared_ptr<::takatori::type::data const> const& type() const noexcept;
+
     /**
      * @brief resolves this placeholder.
      * @return the created scalar expression
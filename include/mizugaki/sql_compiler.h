@@ -0,0 +1,105 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <takatori/document/document.h>
+
+#include <takatori/util/maybe_shared_ptr.h>
+
+#include <yugawara/compiler.h>
+
+#include <mizugaki/placeholder_map.h>
+
+#include <mizugaki/parser/sql_parser_session.h>
+
+#include <mizugaki/analyzer/sql_analyzer.h>
+
+#include "sql_compiler_options.h"
+#include "sql_compiler_result.h"
+
+namespace mizugaki {
+
+/**
+ * @brief compiles SQL text into its execution plan, through the parse, analyze, and compile stages.
+ * @details This keeps the parser session, analyzer, and execution plan compiler between compile operations,
+ *      so that compiling many short statements reuses their internal buffers.
+ *      The parsed compilation unit is directly passed to the analyzer, and it also holds the source document
+ *      and comments which the diagnostics of the individual stages refer.
+ *
+ *      This object is not thread-safe, and it is designed to be kept by each thread.
+ */
+class sql_compiler {
+public:
+    /// @brief the source document type.
+    using document_type = ::takatori::document::document;
+
+    /// @brief the options type.
+    using options_type = sql_compiler_options;
+
+    /// @brief the result type.
+    using result_type = sql_compiler_result;
+
+    /// @brief the default location name of the source text.
+    static constexpr std::string_view default_location = "<input>";
+
+    /**
+     * @brief creates a new instance.
+     * @param options the compiler options
+     */
+    explicit sql_compiler(options_type options);
+
+    ~sql_compiler();
+
+    sql_compiler(sql_compiler const& other) = delete;
+    sql_compiler& operator=(sql_compiler const& other) = delete;
+
+    /**
+     * @brief creates a new instance.
+     * @param other the move source
+     */
+    sql_compiler(sql_compiler&& other) noexcept;
+
+    /**
+     * @brief assigns the given object into this.
+     * @param other the move source
+     * @return this
+     */
+    sql_compiler& operator=(sql_compiler&& other) noexcept;
+
+    /**
+     * @brief returns the compiler options.
+     * @return the compiler options
+     */
+    [[nodiscard]] options_type const& options() const noexcept;
+
+    /**
+     * @brief compiles the given SQL text.
+     * @details The text must consist of exactly one statement.
+     * @param text the SQL text
+     * @param placeholders the input placeholders
+     * @return the compiled result
+     */
+    [[nodiscard]] result_type compile(std::string text, placeholder_map const& placeholders = {});
+
+    /**
+     * @brief compiles the SQL text in the given document.
+     * @details The document must consist of exactly one statement.
+     * @param document the source document
+     * @param placeholders the input placeholders
+     * @return the compiled result
+     */
+    [[nodiscard]] result_type compile(
+            ::takatori::util::maybe_shared_ptr<document_type const> document,
+            placeholder_map const& placeholders = {});
+
+private:
+    options_type options_;
+    parser::sql_parser_session parser_;
+    analyzer::sql_analyzer analyzer_ {};
+    ::yugawara::compiler compiler_ {};
+
+    void compile_statement(result_type& result, analyzer::sql_analyzer_result& analyzed);
+};
+
+} // namespace mizugaki
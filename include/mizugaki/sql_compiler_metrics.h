@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+
+namespace mizugaki {
+
+/**
+ * @brief elapsed time of the individual stages in a compile operation.
+ * @details The stages which were not reached, because a previous stage was failed, are left as zero.
+ * @see sql_compiler_result::metrics()
+ */
+class sql_compiler_metrics {
+public:
+    /// @brief the duration type.
+    using duration_type = std::chrono::nanoseconds;
+
+    /**
+     * @brief returns the total elapsed time of the compile operation.
+     * @return the total elapsed time
+     */
+    [[nodiscard]] duration_type& total_time() noexcept {
+        return total_time_;
+    }
+
+    /// @copydoc total_time()
+    [[nodiscard]] duration_type total_time() const noexcept {
+        return total_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of parsing the source text.
+     * @return the elapsed time of the parse stage
+     */
+    [[nodiscard]] duration_type& parse_time() noexcept {
+        return parse_time_;
+    }
+
+    /// @copydoc parse_time()
+    [[nodiscard]] duration_type parse_time() const noexcept {
+        return parse_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of analyzing the parsed statement.
+     * @return the elapsed time of the analyze stage
+     */
+    [[nodiscard]] duration_type& analysis_time() noexcept {
+        return analysis_time_;
+    }
+
+    /// @copydoc analysis_time()
+    [[nodiscard]] duration_type analysis_time() const noexcept {
+        return analysis_time_;
+    }
+
+    /**
+     * @brief returns the elapsed time of compiling the analyzed statement into its execution plan.
+     * @return the elapsed time of the compile stage
+     */
+    [[nodiscard]] duration_type& compile_time() noexcept {
+        return compile_time_;
+    }
+
+    /// @copydoc compile_time()
+    [[nodiscard]] duration_type compile_time() const noexcept {
+        return compile_time_;
+    }
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output
+     */
+    friend std::ostream& operator<<(std::ostream& out, sql_compiler_metrics const& value) {
+        return out << "sql_compiler_metrics("
+                   << "total_time=" << value.total_time_.count() << "ns, "
+                   << "parse_time=" << value.parse_time_.count() << "ns, "
+                   << "analysis_time=" << value.analysis_time_.count() << "ns, "
+                   << "compile_time=" << value.compile_time_.count() << "ns)";
+    }
+
+private:
+    duration_type total_time_ {};
+    duration_type parse_time_ {};
+    duration_type analysis_time_ {};
+    duration_type compile_time_ {};
+};
+
+} // namespace mizugaki
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+
+#include <yugawara/compiler_options.h>
+
+#include <yugawara/variable/provider.h>
+
+#include <mizugaki/parser/sql_parser_options.h>
+
+#include <mizugaki/analyzer/sql_analyzer_options.h>
+
+namespace mizugaki {
+
+/**
+ * @brief options of sql_compiler.
+ * @details This bundles the options of the individual stages, and sql_compiler shares them
+ *      between all compile operations.
+ * @see sql_compiler
+ */
+class sql_compiler_options {
+public:
+    /**
+     * @brief creates a new instance.
+     * @param analyzer_options the analyzer options, which provide the catalog and schemas
+     * @param compiler_options the execution plan compiler options
+     * @param parser_options the parser options
+     * @param host_parameters the host parameter declarations, or empty if host parameters are not available
+     */
+    explicit sql_compiler_options(
+            analyzer::sql_analyzer_options analyzer_options,
+            ::yugawara::compiler_options compiler_options,
+            parser::sql_parser_options parser_options = {},
+            std::shared_ptr<::yugawara::variable::provider const> host_parameters = {});
+
+    /**
+     * @brief returns the options of the parse stage.
+     * @return the parser options
+     */
+    [[nodiscard]] parser::sql_parser_options& parser_options() noexcept;
+
+    /// @copydoc parser_options()
+    [[nodiscard]] parser::sql_parser_options const& parser_options() const noexcept;
+
+    /**
+     * @brief returns the options of the analyze stage.
+     * @return the analyzer options
+     */
+    [[nodiscard]] analyzer::sql_analyzer_options& analyzer_options() noexcept;
+
+    /// @copydoc analyzer_options()
+    [[nodiscard]] analyzer::sql_analyzer_options const& analyzer_options() const noexcept;
+
+    /**
+     * @brief returns the options of the compile stage.
+     * @return the execution plan compiler options
+     */
+    [[nodiscard]] ::yugawara::compiler_options& compiler_options() noexcept;
+
+    /// @copydoc compiler_options()
+    [[nodiscard]] ::yugawara::compiler_options const& compiler_options() const noexcept;
+
+    /**
+     * @brief returns the host parameter declarations.
+     * @return the host parameter declarations
+     * @return empty if host parameters are not available
+     */
+    [[nodiscard]] std::shared_ptr<::yugawara::variable::provider const>& host_parameters() noexcept;
+
+    /// @copydoc host_parameters()
+    [[nodiscard]] std::shared_ptr<::yugawara::variable::provider const> const& host_parameters() const noexcept;
+
+private:
+    parser::sql_parser_options parser_options_;
+    analyzer::sql_analyzer_options analyzer_options_;
+    ::yugawara::compiler_options compiler_options_;
+    std::shared_ptr<::yugawara::variable::provider const> host_parameters_;
+};
+
+} // namespace mizugaki
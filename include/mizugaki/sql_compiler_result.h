@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <yugawara/compiler_result.h>
+
+#include <mizugaki/ast/compilation_unit.h>
+
+#include <mizugaki/parser/sql_parser_diagnostic.h>
+
+#include <mizugaki/analyzer/sql_analyzer_result.h>
+
+#include "sql_compiler_metrics.h"
+
+namespace mizugaki {
+
+/**
+ * @brief represents a stage of sql_compiler.
+ */
+enum class sql_compiler_stage {
+    /// @brief parses the source text into AST.
+    parse,
+
+    /// @brief analyzes AST and converts it into the takatori IR.
+    analyze,
+
+    /// @brief compiles the takatori IR into its execution plan.
+    compile,
+};
+
+/**
+ * @brief returns string representation of the value.
+ * @param value the target value
+ * @return the corresponded string representation
+ */
+inline constexpr std::string_view to_string_view(sql_compiler_stage value) noexcept {
+    using namespace std::string_view_literals;
+    using kind = sql_compiler_stage;
+    switch (value) {
+        case kind::parse: return "parse"sv;
+        case kind::analyze: return "analyze"sv;
+        case kind::compile: return "compile"sv;
+    }
+    std::abort();
+}
+
+/**
+ * @brief appends string representation of the given value.
+ * @param out the target output
+ * @param value the target value
+ * @return the output
+ */
+inline std::ostream& operator<<(std::ostream& out, sql_compiler_stage value) {
+    return out << to_string_view(value);
+}
+
+/**
+ * @brief the result of sql_compiler.
+ * @details This holds the diagnostics of the last processed stage if it was failed.
+ *      The following stages are never processed after a failed stage.
+ */
+class sql_compiler_result {
+public:
+    /// @brief the stage type.
+    using stage_type = sql_compiler_stage;
+
+    /// @brief the parsed compilation unit type.
+    using compilation_unit_type = std::unique_ptr<ast::compilation_unit>;
+
+    /// @brief the diagnostic type of the parse stage.
+    using parser_diagnostic_type = parser::sql_parser_diagnostic;
+
+    /// @brief the diagnostic type of the analyze stage.
+    using analyzer_diagnostic_type = analyzer::sql_analyzer_result::diagnostic_type;
+
+    /// @brief the result type of the compile stage.
+    using compiler_result_type = ::yugawara::compiler_result;
+
+    /// @brief the metrics type.
+    using metrics_type = sql_compiler_metrics;
+
+    /**
+     * @brief creates a new empty instance.
+     */
+    sql_compiler_result() = default;
+
+    /**
+     * @brief returns whether or not all stages were successfully completed.
+     * @return true if this is a valid result, and compiled() contains the execution plan
+     * @return false if any stage was failed
+     */
+    [[nodiscard]] bool is_valid() const noexcept;
+
+    /// @copydoc is_valid()
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /**
+     * @brief returns the last processed stage.
+     * @details If this is not a valid result, the returned stage was failed.
+     * @return the last processed stage
+     */
+    [[nodiscard]] stage_type& stage() noexcept;
+
+    /// @copydoc stage()
+    [[nodiscard]] stage_type stage() const noexcept;
+
+    /**
+     * @brief returns the parsed compilation unit.
+     * @details The compilation unit holds the source document and its comments,
+     *      and the diagnostics of the later stages refer them.
+     * @return the parsed compilation unit
+     * @return empty if the parse stage was failed
+     */
+    [[nodiscard]] compilation_unit_type& compilation_unit() noexcept;
+
+    /// @copydoc compilation_unit()
+    [[nodiscard]] compilation_unit_type const& compilation_unit() const noexcept;
+
+    /**
+     * @brief returns the diagnostic of the parse stage.
+     * @return the diagnostic
+     * @return an invalid diagnostic if the parse stage was succeeded
+     */
+    [[nodiscard]] parser_diagnostic_type& parser_diagnostic() noexcept;
+
+    /// @copydoc parser_diagnostic()
+    [[nodiscard]] parser_diagnostic_type const& parser_diagnostic() const noexcept;
+
+    /**
+     * @brief returns the diagnostics of the analyze stage.
+     * @return the diagnostics
+     * @return empty if the analyze stage was succeeded or not processed
+     */
+    [[nodiscard]] std::vector<analyzer_diagnostic_type>& analyzer_diagnostics() noexcept;
+
+    /// @copydoc analyzer_diagnostics()
+    [[nodiscard]] std::vector<analyzer_diagnostic_type> const& analyzer_diagnostics() const noexcept;
+
+    /**
+     * @brief returns the result of the compile stage.
+     * @return the compiled execution plan, or its diagnostics if the compile stage was failed
+     * @return an empty result if the compile stage was not processed
+     */
+    [[nodiscard]] compiler_result_type& compiled() noexcept;
+
+    /// @copydoc compiled()
+    [[nodiscard]] compiler_result_type const& compiled() const noexcept;
+
+    /**
+     * @brief returns the elapsed time of the individual stages.
+     * @return the metrics
+     */
+    [[nodiscard]] metrics_type& metrics() noexcept;
+
+    /// @copydoc metrics()
+    [[nodiscard]] metrics_type const& metrics() const noexcept;
+
+private:
+    stage_type stage_ { stage_type::parse };
+    compilation_unit_type compilation_unit_ {};
+    parser_diagnostic_type parser_diagnostic_ {};
+    std::vector<analyzer_diagnostic_type> analyzer_diagnostics_ {};
+    compiler_result_type compiled_ {};
+    metrics_type metrics_ {};
+};
+
+} // namespace mizugaki
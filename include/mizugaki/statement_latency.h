@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace mizugaki {
+
+/**
+ * @brief aggregates elapsed time of individual operations.
+ * @details This keeps a fixed size logarithmic histogram instead of the individual samples,
+ *      so that percentiles are approximated within about 25% of relative error.
+ */
+class statement_latency {
+public:
+    /// @brief the duration type.
+    using duration_type = std::chrono::nanoseconds;
+
+    /// @brief the number of histogram buckets.
+    static constexpr std::size_t bucket_count = 160;
+
+    /**
+     * @brief adds an elapsed time.
+     * @param elapsed the elapsed time
+     */
+    void add(duration_type elapsed) noexcept;
+
+    /**
+     * @brief merges the other aggregation into this.
+     * @param other the source aggregation
+     */
+    void merge(statement_latency const& other) noexcept;
+
+    /**
+     * @brief returns the number of added elapsed times.
+     * @return the number of samples
+     */
+    [[nodiscard]] std::size_t count() const noexcept;
+
+    /**
+     * @brief returns the total elapsed time.
+     * @return the total elapsed time
+     */
+    [[nodiscard]] duration_type total() const noexcept;
+
+    /**
+     * @brief returns the minimum elapsed time.
+     * @return the minimum elapsed time
+     * @return zero if there are no samples
+     */
+    [[nodiscard]] duration_type min() const noexcept;
+
+    /**
+     * @brief returns the maximum elapsed time.
+     * @return the maximum elapsed time
+     * @return zero if there are no samples
+     */
+    [[nodiscard]] duration_type max() const noexcept;
+
+    /**
+     * @brief returns the mean elapsed time.
+     * @return the mean elapsed time
+     * @return zero if there are no samples
+     */
+    [[nodiscard]] duration_type mean() const noexcept;
+
+    /**
+     * @brief returns an approximation of the given percentile.
+     * @param percent the percentile, must be in [0, 100]
+     * @return the upper bound of the histogram bucket which includes the percentile, never exceeds max()
+     * @return zero if there are no samples
+     */
+    [[nodiscard]] duration_type percentile(double percent) const noexcept;
+
+    /**
+     * @brief returns an approximation of the 99th percentile.
+     * @return the 99th percentile
+     * @see percentile()
+     */
+    [[nodiscard]] duration_type p99() const noexcept;
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output
+     */
+    friend std::ostream& operator<<(std::ostream& out, statement_latency const& value);
+
+private:
+    std::size_t count_ {};
+    std::uint64_t total_ {};
+    std::uint64_t min_ {};
+    std::uint64_t max_ {};
+    std::array<std::uint64_t, bucket_count> buckets_ {};
+};
+
+} // namespace mizugaki
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "statement_latency.h"
+#include "statement_statistics_entry.h"
+
+namespace mizugaki {
+
+/**
+ * @brief a bounded registry of statement statistics, keyed by the normalized statement fingerprint.
+ * @details Each thread accumulates the records into its own buffer without any synchronization,
+ *      and then merges them into this registry under the lock when the buffer has enough records,
+ *      when flush() is called, or when the thread exits.
+ *      Consequently, snapshot() may not contain the latest records of the other threads.
+ *
+ *      This object is thread-safe, and is designed to be shared between sql_parser_options
+ *      and sql_analyzer_options of many threads.
+ * @see parser::compute_sql_fingerprint()
+ */
+class statement_statistics {
+public:
+    /// @brief the fingerprint type.
+    using fingerprint_type = statement_statistics_entry::fingerprint_type;
+
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /// @brief the duration type.
+    using duration_type = statement_latency::duration_type;
+
+    /// @brief the default max number of entries.
+    static constexpr size_type default_max_entries = 1'000;
+
+    /// @brief the default number of records in each thread buffer before merging them.
+    static constexpr size_type default_flush_threshold = 64;
+
+    /**
+     * @brief creates a new instance.
+     * @param max_entries the max number of entries, records of the other fingerprints are dropped
+     * @param flush_threshold the number of records in each thread buffer before merging them into this
+     * @see dropped_count()
+     */
+    explicit statement_statistics(
+            size_type max_entries = default_max_entries,
+            size_type flush_threshold = default_flush_threshold);
+
+    /**
+     * @brief records a parse operation.
+     * @param fingerprint the statement fingerprint
+     * @param text the statement text, which is only used for the text sample
+     * @param elapsed the elapsed time
+     * @param tree_node_count the number of syntax tree nodes, or 0 if the parse operation was failed
+     * @param tree_depth the syntax tree depth, or 0 if the parse operation was failed
+     * @param diagnostic_count the number of reported diagnostics
+     */
+    void record_parse(
+            fingerprint_type fingerprint,
+            std::string_view text,
+            duration_type elapsed,
+            size_type tree_node_count,
+            size_type tree_depth,
+            size_type diagnostic_count);
+
+    /**
+     * @brief records an analysis operation.
+     * @param fingerprint the statement fingerprint
+     * @param text the statement text, which is only used for the text sample
+     * @param elapsed the elapsed time
+     * @param diagnostic_count the number of reported diagnostics
+     */
+    void record_analysis(
+            fingerprint_type fingerprint,
+            std::string_view text,
+            duration_type elapsed,
+            size_type diagnostic_count);
+
+    /**
+     * @brief merges the records in the buffer of the current thread into this.
+     */
+    void flush();
+
+    /**
+     * @brief returns a copy of the merged entries.
+     * @details This first merges the records of the current thread, but may not include the pending records
+     *      of the other threads.
+     * @return the entries, in no particular order
+     */
+    [[nodiscard]] std::vector<statement_statistics_entry> snapshot();
+
+    /**
+     * @brief returns the number of records which were dropped because this registry was full.
+     * @return the number of dropped records
+     */
+    [[nodiscard]] size_type dropped_count() const noexcept;
+
+    /**
+     * @brief removes all merged entries.
+     * @details The pending records of individual threads are not affected.
+     */
+    void clear();
+
+private:
+    class state;
+    class thread_buffers;
+
+    std::shared_ptr<state> state_;
+
+    [[nodiscard]] static thread_buffers& buffers();
+};
+
+} // namespace mizugaki
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "statement_latency.h"
+
+namespace mizugaki {
+
+/**
+ * @brief aggregated statistics of statements which share the same fingerprint.
+ * @see statement_statistics
+ */
+class statement_statistics_entry {
+public:
+    /// @brief the fingerprint type.
+    using fingerprint_type = std::uint64_t;
+
+    /// @brief the size type.
+    using size_type = std::size_t;
+
+    /// @brief the max length of text_sample().
+    static constexpr size_type max_text_sample_length = 1024;
+
+    /**
+     * @brief creates a new empty instance.
+     */
+    statement_statistics_entry() = default;
+
+    /**
+     * @brief creates a new empty instance.
+     * @param fingerprint the statement fingerprint
+     * @param text_sample an example of the statement text, which may be truncated
+     */
+    statement_statistics_entry(fingerprint_type fingerprint, std::string_view text_sample);
+
+    /**
+     * @brief returns the statement fingerprint.
+     * @return the fingerprint
+     */
+    [[nodiscard]] fingerprint_type fingerprint() const noexcept;
+
+    /**
+     * @brief returns an example of the statement text.
+     * @details This is the first statement text which was recorded with the fingerprint,
+     *      and is truncated to max_text_sample_length bytes.
+     * @return the text sample
+     */
+    [[nodiscard]] std::string const& text_sample() const noexcept;
+
+    /**
+     * @brief returns the number of calls.
+     * @details This is the larger one of the number of parse and analysis operations,
+     *      because statements may be parsed once and analyzed many times, or vice versa.
+     * @return the number of calls
+     */
+    [[nodiscard]] size_type calls() const noexcept;
+
+    /**
+     * @brief returns the elapsed time of parse operations.
+     * @return the parse time
+     */
+    [[nodiscard]] statement_latency& parse_time() noexcept;
+
+    /// @copydoc parse_time()
+    [[nodiscard]] statement_latency const& parse_time() const noexcept;
+
+    /**
+     * @brief returns the elapsed time of analysis operations.
+     * @return the analysis time
+     */
+    [[nodiscard]] statement_latency& analysis_time() noexcept;
+
+    /// @copydoc analysis_time()
+    [[nodiscard]] statement_latency const& analysis_time() const noexcept;
+
+    /**
+     * @brief returns the total number of syntax tree nodes.
+     * @return the total number of nodes
+     */
+    [[nodiscard]] size_type& total_tree_node_count() noexcept;
+
+    /// @copydoc total_tree_node_count()
+    [[nodiscard]] size_type const& total_tree_node_count() const noexcept;
+
+    /**
+     * @brief returns the max number of syntax tree nodes.
+     * @return the max number of nodes
+     */
+    [[nodiscard]] size_type& max_tree_node_count() noexcept;
+
+    /// @copydoc max_tree_node_count()
+    [[nodiscard]] size_type const& max_tree_node_count() const noexcept;
+
+    /**
+     * @brief returns the max syntax tree depth.
+     * @return the max depth
+     */
+    [[nodiscard]] size_type& max_tree_depth() noexcept;
+
+    /// @copydoc max_tree_depth()
+    [[nodiscard]] size_type const& max_tree_depth() const noexcept;
+
+    /**
+     * @brief returns the total number of diagnostics reported by the parser.
+     * @return the number of parser diagnostics
+     */
+    [[nodiscard]] size_type& parse_diagnostic_count() noexcept;
+
+    /// @copydoc parse_diagnostic_count()
+    [[nodiscard]] size_type const& parse_diagnostic_count() const noexcept;
+
+    /**
+     * @brief returns the total number of diagnostics reported by the analyzer.
+     * @return the number of analyzer diagnostics
+     */
+    [[nodiscard]] size_type& analysis_diagnostic_count() noexcept;
+
+    /// @copydoc analysis_diagnostic_count()
+    [[nodiscard]] size_type const& analysis_diagnostic_count() const noexcept;
+
+    /**
+     * @brief merges the other entry into this.
+     * @details This keeps the text sample of this entry, or takes the other one if this is empty.
+     * @param other the source entry
+     */
+    void merge(statement_statistics_entry const& other);
+
+    /**
+     * @brief appends string representation of the given value.
+     * @param out the target output
+     * @param value the target value
+     * @return the output
+     */
+    friend std::ostream& operator<<(std::ostream& out, statement_statistics_entry const& value);
+
+private:
+    fingerprint_type fingerprint_ {};
+    std::string text_sample_ {};
+    statement_latency parse_time_ {};
+    statement_latency analysis_time_ {};
+    size_type total_tree_node_count_ {};
+    size_type max_tree_node_count_ {};
+    size_type max_tree_depth_ {};
+    size_type parse_diagnostic_count_ {};
+    size_type analysis_diagnostic_count_ {};
+};
+
+} // namespace mizugaki
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <exception>
+
+#include <mizugaki/cancellation_token.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief an exception which aborts the current analysis because it was cancelled or has exceeded its deadline.
+ * @details This is only thrown in the analyzer, and sql_analyzer reports it as
+ *      sql_analyzer_code::cancelled or sql_analyzer_code::deadline_exceeded.
+ * @see sql_analyzer_options::cancellation()
+ */
+class analysis_cancelled : public std::exception {
+public:
+    /**
+     * @brief creates a new instance.
+     * @param status the cancellation status
+     */
+    explicit analysis_cancelled(cancellation_status status) noexcept :
+        status_ { status }
+    {}
+
+    /**
+     * @brief returns the cancellation status.
+     * @return the cancellation status
+     */
+    [[nodiscard]] cancellation_status status() const noexcept {
+        return status_;
+    }
+
+    [[nodiscard]] char const* what() const noexcept override {
+        if (status_ == cancellation_status::deadline_exceeded) {
+            return "analysis has exceeded its deadline";
+        }
+        return "analysis was cancelled";
+    }
+
+private:
+    cancellation_status status_;
+};
+
+} // namespace mizugaki::analyzer::details
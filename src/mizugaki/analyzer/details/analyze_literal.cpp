@@ -1,6 +1,9 @@
 #include <mizugaki/analyzer/details/analyze_literal.h>
 
 #include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 
 #include <takatori/datetime/conversion.h>
 
@@ -353,177 +356,171 @@ private:
                 context_.types().get(ttype::float8 {}));
     }
 
-    [[nodiscard]] std::optional<std::size_t> count_characters(ast::literal::string::value_type const& string) {
+    [[nodiscard]] bool append_quoted_string(
+            ast::literal::string::value_type const& string,
+            tvalue::character::entity_type& destination) {
         constexpr char quote = ast::literal::string::quote_character;
-        auto&& q = *string;
+        std::string_view q { *string };
         if (q.size() >= 2 && q.front() == quote && q.back() == quote) {
-            std::size_t count = 0;
-            bool malformed = false;
-            for (std::size_t i = 1, n = q.size() - 1; i < n; ++i) {
-                auto c = q[i];
-                if (c == quote) {
-                    ++i;
-                    if (i >= n || q[i] != quote) {
-                        malformed = true;
-                        break;
-                    }
+            q.remove_prefix(1);
+            q.remove_suffix(1);
+            // NOTE: find() delegates to memchr(), so that we copy the runs between quotes in bulk
+            while (true) {
+                auto position = q.find(quote);
+                if (position == std::string_view::npos) {
+                    destination.append(q);
+                    return true;
                 }
-                ++count;
-            }
-            if (!malformed) {
-                return count;
+                if (position + 1 >= q.size() || q[position + 1] != quote) {
+                    break;
+                }
+                // keep one of the escaped quote pair
+                destination.append(q.substr(0, position + 1));
+                q.remove_prefix(position + 2);
             }
         }
         context_.report(sql_analyzer_code::malformed_quoted_string,
                 string_builder {}
-                        << "invalid quoted string \"" << q << "\""
+                        << "invalid quoted string \"" << *string << "\""
                         << string_builder::to_string,
                 string.region());
-        return {};
+        return false;
     }
 
-    template<class T>
-    static void append_quoted_string_unchecked(ast::common::chars const& from, T& destination) {
-        constexpr char quote = ast::literal::string::quote_character;
-        for (auto iter = from.begin() + 1, end = from.end() - 1; iter != end; ++iter) {
-            auto c = *iter;
-            destination.append(1, c);
-            if (c == quote) {
-                ++iter;
-            }
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> process_character_string(ast::literal::string const& value) {
+        std::size_t capacity = value.value()->size();
+        for (auto&& v : value.concatenations()) {
+            capacity += v->size();
         }
-    }
 
-    [[nodiscard]] std::unique_ptr<tscalar::immediate> process_character_string(ast::literal::string const& value) {
-        std::size_t nchars = 0;
-        if (auto n = count_characters(value.value())) {
-            nchars += *n;
-        } else {
+        context_.consume_memory(capacity);
+        tvalue::character::entity_type string {};
+        string.reserve(capacity);
+        if (!append_quoted_string(value.value(), string)) {
             return {};
         }
         for (auto&& v : value.concatenations()) {
-            if (auto n = count_characters(v)) {
-                nchars += *n;
-            } else {
+            if (!append_quoted_string(v, string)) {
                 return {};
             }
         }
-
-        tvalue::character::entity_type string {};
-        string.reserve(nchars);
-
-        append_quoted_string_unchecked(*value.value(), string);
-        for (auto&& v : value.concatenations()) {
-            append_quoted_string_unchecked(*v, string);
-        }
+        auto nchars = string.size();
         std::optional<std::size_t> size {};
         if (context_.options()->prefer_small_character_literals()) {
             size = nchars;
         }
         return context_.create<tscalar::immediate>(
                 value.region(),
-                context_.values().get(tvalue::character { std::move(string) }),
+                share(tvalue::character { std::move(string) }, nchars),
                 context_.types().get(ttype::character {
                         ttype::varying,
                         size,
                 }));
     }
 
-    [[nodiscard]] std::optional<std::size_t> count_hex_digits(ast::literal::string::value_type const& string) {
+    [[nodiscard]] static constexpr int hex_digit_value(char c) noexcept {
+        if ('0' <= c && c <= '9') {
+            return c - '0';
+        }
+        if ('A' <= c && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        if ('a' <= c && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        return -1;
+    }
+
+    [[nodiscard]] bool append_quoted_hex_digits(
+            ast::literal::string::value_type const& string,
+            std::string& destination) {
         constexpr char quote = ast::literal::string::quote_character;
-        auto&& q = *string;
+        std::string_view q { *string };
         if (q.size() < 2 || q.front() != quote || q.back() != quote) {
             context_.report(sql_analyzer_code::malformed_quoted_string,
                     string_builder {}
-                            << "invalid quoted string \"" << q << "\""
+                            << "invalid quoted string \"" << *string << "\""
                             << string_builder::to_string,
                     string.region());
-            return {};
+            return false;
         }
+        q.remove_prefix(1);
+        q.remove_suffix(1);
+
+        // validates and decodes the digits in a single pass
         std::size_t digits = 0;
-        for (auto iter = string.value().begin() + 1, end = string.value().end() - 1; iter != end; ++iter) {
-            auto c = *iter;
+        unsigned int upper = 0;
+        for (auto c : q) {
             if (c == ' ') {
                 continue;
             }
-            if (('0' <= c && c <= '9') || ('A' <= c && c <= 'F') || ('a' <= c && c <= 'f')) {
-                ++digits;
-                continue;
+            auto digit = hex_digit_value(c);
+            if (digit < 0) {
+                context_.report(sql_analyzer_code::malformed_quoted_string,
+                        string_builder {}
+                                << "unexpected character in hex string \"" << *string << "\""
+                                << string_builder::to_string,
+                        string.region());
+                return false;
             }
-            context_.report(sql_analyzer_code::malformed_quoted_string,
-                    string_builder {}
-                            << "unexpected character in hex string \"" << q << "\""
-                            << string_builder::to_string,
-                    string.region());
-            return {};
+            if ((digits % 2) == 0) {
+                upper = static_cast<unsigned int>(digit);
+            } else {
+                destination.push_back(static_cast<char>((upper << 4U) | static_cast<unsigned int>(digit)));
+            }
+            ++digits;
         }
         if ((digits % 2) != 0) {
             context_.report(sql_analyzer_code::malformed_quoted_string,
                     string_builder {}
-                            << "odd-digit hex string \"" << q << "\""
+                            << "odd-digit hex string \"" << *string << "\""
                             << string_builder::to_string,
                     string.region());
-            return {};
+            return false;
         }
-        return digits / 2;
-    }
-
-    [[nodiscard]] bool append_quoted_hex_digits_unchecked(ast::literal::string::value_type const& string, std::string& destination) {
-        std::string_view input { *string };
-        input.remove_prefix(1);
-        input.remove_suffix(1);
-        auto result = tvalue::parse_octet(input, destination);
-        if (result) {
-            return true;
-        }
-        context_.report(sql_analyzer_code::malformed_quoted_string,
-                string_builder {}
-                        << "invalid hex string "
-                        << "(" << result.error() << "): "
-                        << *string
-                        << string_builder::to_string,
-                string.region());
-        return false;
+        return true;
     }
 
     [[nodiscard]] std::unique_ptr<tscalar::immediate> process_binary_string(ast::literal::string const& value) {
-        std::size_t nchars {};
-        if (auto n = count_hex_digits(value.value())) {
-            nchars += *n;
-        } else {
-            return {};
-        }
-        for (auto&& concat : value.concatenations()) {
-            if (auto n = count_hex_digits(concat)) {
-                nchars += *n;
-            } else {
-                return {};
-            }
+        std::size_t capacity = value.value()->size() / 2;
+        for (auto&& v : value.concatenations()) {
+            capacity += v->size() / 2;
         }
 
+        context_.consume_memory(capacity);
         std::string buffer {};
-        buffer.reserve(nchars);
-        if (!append_quoted_hex_digits_unchecked(value.value(), buffer)) {
+        buffer.reserve(capacity);
+        if (!append_quoted_hex_digits(value.value(), buffer)) {
             return {};
         }
         for (auto&& v : value.concatenations()) {
-            if (!append_quoted_hex_digits_unchecked(v, buffer)) {
+            if (!append_quoted_hex_digits(v, buffer)) {
                 return {};
             }
         }
+        auto nchars = buffer.size();
         std::optional<std::size_t> size {};
         if (context_.options()->prefer_small_binary_literals()) {
             size = nchars;
         }
         return context_.create<tscalar::immediate>(
                 value.region(),
-                context_.values().get(tvalue::octet { std::move(buffer) }),
+                share(tvalue::octet { std::move(buffer) }, nchars),
                 context_.types().get(ttype::octet {
                         ttype::varying,
                         nchars,
                 }));
     }
 
+    template<class T>
+    [[nodiscard]] std::shared_ptr<tvalue::data const> share(T&& value, std::size_t size) {
+        if (auto threshold = context_.options()->large_literal_threshold(); threshold > 0 && size >= threshold) {
+            // NOTE: sharing the value requires its hash code, which scans whole of the value again
+            return std::make_shared<std::remove_reference_t<T> const>(std::forward<T>(value));
+        }
+        return context_.values().get(std::forward<T>(value));
+    }
+
     std::unique_ptr<tscalar::immediate> process_date(ast::literal::datetime const& value) {
         std::string_view contents { *value.value() };
         contents.remove_prefix(1);
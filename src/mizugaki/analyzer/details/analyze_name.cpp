@@ -896,8 +896,8 @@ private:
             ast::name::simple const& name) {
         ast::common::chars buffer;
         auto id = to_identifier(name.last_name(), buffer, name_kind::variable);
-        if (auto v = schema.variable_provider().find(id)) {
-            return { scoped_variable_info { context_.bless(to_descriptor(std::move(v)), name.region()) } };
+        if (auto&& v = context_.snapshot().find_variable(schema, id)) {
+            return { scoped_variable_info { context_.bless(to_descriptor(v), name.region()) } };
         }
         return not_found;
     }
@@ -924,7 +924,7 @@ private:
     [[nodiscard]] find_symbol_result<relation_decl const&> find_relation_decl_in_schema(schema_decl const& parent, ast::name::simple const& name) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::relation);
-        if (auto t = parent.storage_provider().find_relation(id)) {
+        if (auto&& t = context_.snapshot().find_relation(parent, id)) {
             return { *t };
         }
         return {};
@@ -936,14 +936,7 @@ private:
             std::size_t argument_count) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::function);
-        std::vector<std::shared_ptr<function_decl const>> result;
-        parent.function_provider().each(
-                id,
-                argument_count,
-                [&] (std::shared_ptr<function_decl const> const& f) -> void {
-                    result.push_back(f);
-                });
-        return result;
+        return context_.snapshot().find_functions(parent, id, argument_count);
     }
 
     [[nodiscard]] std::vector<std::shared_ptr<aggregation_decl const>> collect_aggregation_decl_in_schema(
@@ -952,21 +945,14 @@ private:
             std::size_t argument_count) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::function);
-        std::vector<std::shared_ptr<aggregation_decl const>> result;
-        parent.set_function_provider().each(
-                id,
-                argument_count,
-                [&] (std::shared_ptr<aggregation_decl const> const& f) -> void {
-                    result.push_back(f);
-                });
-        return result;
+        return context_.snapshot().find_aggregations(parent, id, argument_count);
     }
 
     [[nodiscard]] find_symbol_result<table_decl const*> find_table_decl_in_schema(schema_decl const& parent, ast::name::simple const& name) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::relation);
-        if (auto t = parent.storage_provider().find_table(id)) {
-            return { std::move(t) };
+        if (auto&& t = context_.snapshot().find_table(parent, id)) {
+            return { t };
         }
         return {};
     }
@@ -974,8 +960,8 @@ private:
     [[nodiscard]] find_symbol_result<index_decl const*> find_index_decl_in_schema(schema_decl const& parent, ast::name::simple const& name) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::relation);
-        if (auto t = parent.storage_provider().find_index(id)) {
-            return { std::move(t) };
+        if (auto&& t = context_.snapshot().find_index(parent, id)) {
+            return { t };
         }
         return {};
     }
@@ -983,8 +969,8 @@ private:
     find_symbol_result<schema_decl const*> find_schema_in_catalog(catalog_decl const& parent, ast::name::simple const& name) {
         ast::common::chars buffer;
         auto id = to_identifier(name, buffer, name_kind::schema);
-        if (auto s = parent.schema_provider().find(id)) {
-            return { std::move(s) };
+        if (auto&& s = context_.snapshot().find_schema(parent, id)) {
+            return { s };
         }
         return {};
     }
@@ -1009,6 +995,7 @@ std::unique_ptr<tscalar::expression> analyze_variable_name(
         analyzer_context& context,
         ast::name::name const& name,
         query_scope& scope) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     engine e { context, scope };
     return e.find_variable(scope, name);
 }
@@ -1017,6 +1004,7 @@ std::vector<std::shared_ptr<function_decl const>> analyze_function_name(
         analyzer_context& context,
         ast::name::name const& name,
         std::size_t argument_count) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     query_scope empty_scope;
     engine e { context, empty_scope };
     return e.collect_function_decl(name, argument_count);
@@ -1026,6 +1014,7 @@ std::vector<std::shared_ptr<aggregation_decl const>> analyze_aggregation_name(
         analyzer_context& context,
         ast::name::name const& name,
         std::size_t argument_count) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     query_scope empty_scope;
     engine e { context, empty_scope };
     return e.collect_aggregation_decl(name, argument_count);
@@ -1035,6 +1024,7 @@ optional_ptr<relation_info const> analyze_relation_info_name(
         analyzer_context& context,
         ast::name::name const& name,
         query_scope const& scope) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     engine e { context, scope };
     return e.find_relation_info(name);
 }
@@ -1043,6 +1033,7 @@ declared_relation analyze_relation_name(
         analyzer_context& context,
         ast::name::name const& name,
         query_scope const& scope) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     engine e { context, scope };
     return e.find_relation_decl(name);
 }
@@ -1051,6 +1042,7 @@ std::optional<schema_element<table_decl>> analyze_table_name(
         analyzer_context& context,
         ast::name::name const& name,
         bool mandatory) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     query_scope empty_scope;
     engine e { context, empty_scope };
     return e.find_table_decl(name, mandatory);
@@ -1060,6 +1052,7 @@ std::optional<schema_element<index_decl>> analyze_index_name(
         analyzer_context& context,
         ast::name::name const& name,
         bool mandatory) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     query_scope empty_scope;
     engine e { context, empty_scope };
     return e.find_index_decl(name, mandatory);
@@ -1069,6 +1062,7 @@ std::shared_ptr<schema_decl const> analyze_schema_name(
         analyzer_context& context,
         ast::name::name const& name,
         bool mandatory) {
+    auto timer = context.measure(analyzer_context::phase::name_resolution);
     query_scope empty_scope;
     engine e { context, empty_scope };
     return e.find_schema_decl(name, mandatory);
@@ -1,8 +1,10 @@
 #include <mizugaki/analyzer/details/analyze_query_expression.h>
 
+#include <functional>
 #include <numeric>
 #include <vector>
 
+#include <tsl/hopscotch_map.h>
 #include <tsl/hopscotch_set.h>
 
 #include <takatori/type/table.h>
@@ -43,6 +45,7 @@
 
 #include <mizugaki/analyzer/details/analyze_name.h>
 #include <mizugaki/analyzer/details/analyze_scalar_expression.h>
+#include <mizugaki/analyzer/details/scalar_expression_hash.h>
 #include <yugawara/binding/extract.h>
 
 #include "set_function_processor.h"
@@ -69,6 +72,12 @@ using node_vector = std::vector<std::unique_ptr<T>>;
 
 namespace {
 
+using common_expression_map = ::tsl::hopscotch_map<
+        std::reference_wrapper<tscalar::expression const>,
+        tdescriptor::variable,
+        scalar_expression_hash,
+        scalar_expression_equal>;
+
 class engine {
 public:
     engine(
@@ -145,9 +154,10 @@ public:
                         expr.where()->region());
                 return {};
             }
-            auto&& filter = graph_.emplace<trelation::filter>(
+            auto&& filter = context_.emplace<trelation::filter>(
+                    graph_,
                     predicate.release());
-            if (!context_.resolve(filter)) {
+            if (!context_.resolve_later(filter)) {
                 return {};
             }
             filter.region() = context_.convert(expr.where()->region());
@@ -181,7 +191,7 @@ public:
             if (!set_functions.process(filter.ownership_condition())) {
                 return {};
             }
-            if (!context_.resolve(filter)) {
+            if (!context_.resolve_later(filter)) {
                 return {};
             }
             filter.input().connect_to(*output);
@@ -192,7 +202,7 @@ public:
         relation_info info;
         optional_ptr<trelation::project> select_columns {};
         {
-            auto&& project = graph_.emplace<trelation::project>(std::vector<trelation::project::column> {});
+            auto&& project = context_.emplace<trelation::project>(graph_, std::vector<trelation::project::column> {});
             project.columns().reserve(std::min(expr.elements().size(), std::size_t { 8 }));
             if (!expr.elements().empty()) {
                 project.region() = context_.convert(
@@ -221,13 +231,14 @@ public:
 
         // SELECT DISTINCT
         if (auto&& quantifier = expr.quantifier(); quantifier == ast::query::set_quantifier::distinct) {
+            context_.consume_elements<tdescriptor::variable>(info.columns().size());
             auto keys = create_vector<tdescriptor::variable>(info.columns().size());
             for (auto&& column : info.columns()) {
                 keys.emplace_back(column.variable());
             }
-            auto&& distinct = graph_.emplace<trelation::intermediate::distinct>(std::move(keys));
+            auto&& distinct = context_.emplace<trelation::intermediate::distinct>(graph_, std::move(keys));
             distinct.region() = context_.convert(quantifier->region());
-            if (!context_.resolve(distinct)) {
+            if (!context_.resolve_later(distinct)) {
                 return {};
             }
             distinct.input().connect_to(*output);
@@ -237,9 +248,19 @@ public:
         optional_ptr<trelation::project> sort_columns {};
         optional_ptr<trelation::intermediate::limit> sort_limit {};
         if (auto&& specs = expr.order_by(); !specs.empty()) {
+            context_.consume_elements<trelation::intermediate::limit::sort_key>(specs.size());
+            context_.consume_elements<trelation::project::column>(specs.size());
             auto sort_keys = create_vector<trelation::intermediate::limit::sort_key>(specs.size());
-            auto&& project = graph_.emplace<trelation::project>(std::vector<trelation::project::column> {});
-            project.columns().reserve(specs.size());
+            auto project_columns = create_vector<trelation::project::column>(specs.size());
+
+            // the computed expressions which sort keys can share
+            common_expression_map common_expressions {};
+            bool share_expressions = context_.options()->eliminate_common_subexpressions();
+            if (share_expressions && select_columns) {
+                for (auto&& column : select_columns->columns()) {
+                    common_expressions.emplace(column.value(), column.variable());
+                }
+            }
             for (auto&& spec : specs) {
                 if (spec.collation()) {
                     context_.report(
@@ -268,31 +289,50 @@ public:
                             spec.key()->region());
                     return {};
                 }
-                // FIXME: debug string for order key column
-                auto variable = factory_.stream_variable();
-                variable.region() = result.value().region();
                 auto direction = convert(spec.direction());
                 if (!direction) {
                     context_.clear_expression_resolution(result.value());
                     return {};
                 }
-                project.columns().emplace_back(variable, result.release());
+                if (share_expressions) {
+                    if (auto iter = common_expressions.find(result.value()); iter != common_expressions.end()) {
+                        // reuse the column which computes the same expression
+                        context_.clear_expression_resolution(result.value());
+                        sort_keys.emplace_back(iter->second, *direction);
+                        continue;
+                    }
+                }
+                // FIXME: debug string for order key column
+                auto variable = factory_.stream_variable();
+                variable.region() = result.value().region();
+                auto&& column = project_columns.emplace_back(variable, result.release());
+                if (share_expressions) {
+                    common_expressions.emplace(column.value(), column.variable());
+                }
                 sort_keys.emplace_back(std::move(variable), *direction);
             }
-            if (!context_.resolve(project)) {
-                return {};
+            optional_ptr<trelation::project> project {};
+            if (!project_columns.empty()) {
+                project = context_.emplace<trelation::project>(graph_, std::move(project_columns));
+                if (!context_.resolve(*project)) {
+                    return {};
+                }
             }
             auto&& limit = graph_.insert(context_.create<trelation::intermediate::limit>(
                     specs.front().region() | specs.back().region(),
                     std::nullopt,
                     std::vector<tdescriptor::variable> {},
                     std::move(sort_keys)));
-            if (!context_.resolve(limit)) {
+            if (!context_.resolve_later(limit)) {
                 return {};
             }
 
-            project.input().connect_to(*output);
-            limit.input().connect_to(project.output());
+            if (project) {
+                project->input().connect_to(*output);
+                limit.input().connect_to(project->output());
+            } else {
+                limit.input().connect_to(*output);
+            }
             output = limit.output();
             sort_columns = project;
             sort_limit = limit;
@@ -319,7 +359,7 @@ public:
                         nrows,
                         create_vector<tdescriptor::variable>(),
                         create_vector<trelation::intermediate::limit::sort_key>()));
-                if (!context_.resolve(limit)) {
+                if (!context_.resolve_later(limit)) {
                     return {};
                 }
                 limit.input().connect_to(*output);
@@ -363,6 +403,7 @@ public:
                 output = aggregate_output;
             }
         }
+        context_.consume_memory(info.memory_usage());
         return { *output, std::move(info) };
     }
 
@@ -442,9 +483,11 @@ public:
             query_scope& scope,
             row_value_context const& val) {
         // compute row values only which is a row value constructor
+        context_.consume_elements<trelation::values::row>(expr.elements().size());
         auto rows = create_vector<trelation::values::row>(expr.elements().size());
         for (auto&& row_value : expr.elements()) {
             if (auto row_ctor = as_row_value_constructor(*row_value)) {
+                context_.consume_elements<tscalar::expression*>(row_ctor->elements().size());
                 auto row = create_ref_vector<tscalar::expression>(row_ctor->elements().size());
                 std::size_t index = 0;
                 for (auto&& elem_expr : row_ctor->elements()) {
@@ -482,6 +525,7 @@ public:
                 [](std::size_t c, auto&& r) {
                     return std::max(c, r.elements().size());
                 });
+        context_.consume_elements<trelation::values::column>(ncols);
         auto columns = create_vector<trelation::values::column>(ncols);
         for (std::size_t i = 0; i < ncols; ++i) {
             auto variable = factory_.stream_variable(
@@ -491,7 +535,8 @@ public:
             columns.emplace_back(std::move(variable));
         }
 
-        auto&& op = graph_.emplace<trelation::values>(
+        auto&& op = context_.emplace<trelation::values>(
+                graph_,
                 std::move(columns),
                 std::move(rows));
         op.region() = context_.convert(expr.region());
@@ -508,6 +553,7 @@ public:
                     std::nullopt,
             });
         }
+        context_.consume_memory(info.memory_usage());
 
         return { op.output(), std::move(info) };
     }
@@ -583,6 +629,7 @@ public:
         relation_info output_info {};
         output_info.reserve(left_info.columns().size());
 
+        context_.consume_elements<trelation::intermediate::union_::mapping>(left_columns.size());
         std::vector<trelation::intermediate::union_::mapping> mappings {};
         mappings.reserve(left_info.columns().size());
         for (std::size_t index = 0, size = left_columns.size(); index < size; ++index) {
@@ -605,6 +652,7 @@ public:
         if (!context_.resolve(result)) {
             return {};
         }
+        context_.consume_memory(output_info.memory_usage());
         return { result.output(), std::move(output_info) };
     }
 
@@ -651,6 +699,7 @@ public:
         relation_info output_info {};
         output_info.reserve(left_info.columns().size());
 
+        context_.consume_elements<typename operator_type::group_key_pair>(left_columns.size());
         std::vector<typename operator_type::group_key_pair> mappings {};
         mappings.reserve(left_info.columns().size());
         for (std::size_t index = 0, size = left_columns.size(); index < size; ++index) {
@@ -669,6 +718,7 @@ public:
                 std::move(mappings)));
         result.left() << left.output();
         result.right() << right.output();
+        context_.consume_memory(output_info.memory_usage());
         return { result.output(), std::move(output_info) };
     }
 
@@ -865,12 +915,15 @@ public:
             return {};
         }
 
+        context_.consume_elements<trelation::scan::column>(info.columns().size());
+        context_.consume_memory(info.memory_usage());
         auto columns = create_vector<trelation::scan::column>(info.columns().size());
         for (auto&& column : info.columns()) {
             columns.emplace_back(factory_(*column.declaration()), column.variable());
         }
 
-        auto&& op = graph_.emplace<trelation::scan>(
+        auto&& op = context_.emplace<trelation::scan>(
+                graph_,
                 factory_(*index),
                 std::move(columns),
                 trelation::scan::endpoint {},
@@ -890,6 +943,8 @@ public:
         trelation::graph_type subgraph {};
         trelation::merge_into(query->query_graph(), subgraph);
 
+        context_.consume_elements<::yugawara::extension::relation::subquery::mapping_type>(
+                query->output_columns().size());
         std::vector<::yugawara::extension::relation::subquery::mapping_type> mappings {};
         mappings.reserve(query->output_columns().size());
 
@@ -913,7 +968,9 @@ public:
                     std::move(name),
             });
         }
-        auto&& op = graph_.emplace<::yugawara::extension::relation::subquery>(
+        context_.consume_memory(info.memory_usage());
+        auto&& op = context_.emplace<::yugawara::extension::relation::subquery>(
+                graph_,
                 std::move(subgraph),
                 std::move(mappings),
                 // NOTE: mark it cloned because we always take a copy of subgraph,
@@ -1077,6 +1134,7 @@ public:
                     expr.region());
             return {};
         }
+        context_.consume_elements<trelation::apply::column_type>(table_type.columns().size());
         std::vector<trelation::apply::column_type> columns {};
         columns.reserve(table_type.columns().size());
         for (auto&& column_decl : table_type.columns()) {
@@ -1137,9 +1195,11 @@ public:
                     std::move(name),
             });
         }
+        context_.consume_memory(info.memory_usage());
         scope.add(std::move(info));
 
-        auto&& op = graph_.emplace<trelation::apply>(
+        auto&& op = context_.emplace<trelation::apply>(
+                graph_,
                 *operator_kind,
                 factory_(std::move(target)),
                 std::move(arguments),
@@ -1207,6 +1267,7 @@ public:
 
         auto column = factory_.stream_variable(maybe_column_name(elem.name()).value_or(""));
         column.region() = result.value().region();
+        context_.consume_elements<trelation::project::column>(1);
         target.columns().emplace_back(column, result.release());
         info.add({
                 {},
@@ -1441,12 +1502,14 @@ private:
             optional_ptr<query_scope> parent,
             row_value_context const& val,
             bool continue_scope = false) {
+        context_.check_cancellation();
         return ast::query::dispatch(*this, expr, std::move(parent), val, continue_scope);
     }
 
     [[nodiscard]] optional_ptr<output_port> dispatch(
             ast::table::expression const& expr,
             query_scope& scope) {
+        context_.check_cancellation();
         return ast::table::dispatch(*this, expr, scope);
     }
 
@@ -1564,7 +1627,8 @@ private:
             // we'll treat it as VALUES()
             auto rows = create_vector<trelation::values::row>(1);
             rows.emplace_back(create_ref_vector<tscalar::expression>());
-            auto&& op = graph_.emplace<trelation::values>(
+            auto&& op = context_.emplace<trelation::values>(
+                    graph_,
                     create_vector<trelation::values::column>(),
                     std::move(rows));
             if (!context_.resolve(op)) {
@@ -1584,8 +1648,8 @@ private:
                 output = std::move(next);
             } else {
                 // cross join
-                auto&& join = graph_.emplace<trelation::intermediate::join>(trelation::join_kind::inner);
-                if (!context_.resolve(join)) {
+                auto&& join = context_.emplace<trelation::intermediate::join>(graph_, trelation::join_kind::inner);
+                if (!context_.resolve_later(join)) {
                     return {};
                 }
                 join.left().connect_to(*output);
@@ -1654,11 +1718,12 @@ private:
             }
         }
 
-        auto&& op = graph_.emplace<trelation::intermediate::join>(
+        auto&& op = context_.emplace<trelation::intermediate::join>(
+                graph_,
                 join_type,
                 std::move(condition));
         op.region() = context_.convert(expr.region());
-        if (!context_.resolve(op)) {
+        if (!context_.resolve_later(op)) {
             return {};
         }
         op.left().connect_to(*left);
@@ -1720,7 +1785,9 @@ private:
             }
         }
 
-        auto&& op = graph_.emplace<trelation::intermediate::union_>(
+        context_.consume_elements<trelation::intermediate::union_::mapping>(mappings.size());
+        auto&& op = context_.emplace<trelation::intermediate::union_>(
+                graph_,
                 trelation::set_quantifier::all,
                 std::move(mappings));
         op.region() = context_.convert(expr.region());
@@ -1765,8 +1832,18 @@ analyze_query_expression_result analyze_query_expression(
         ast::query::expression const& expression,
         optional_ptr<query_scope> parent,
         row_value_context const& value_context) {
+    auto timer = context.measure(analyzer_context::phase::query_expression);
+    auto pending = context.pending_resolution_size();
     engine e { context, graph };
-    return e.process(expression, std::move(parent), value_context);
+    auto result = e.process(expression, std::move(parent), value_context);
+    if (!result) {
+        context.discard_pending(pending);
+        return result;
+    }
+    if (!context.resolve_pending(pending)) {
+        return {};
+    }
+    return result;
 }
 
 [[nodiscard]] relation_info build_relation_info(
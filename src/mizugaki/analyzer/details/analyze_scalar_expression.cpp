@@ -1,5 +1,7 @@
 #include <mizugaki/analyzer/details/analyze_scalar_expression.h>
 
+#include <memory>
+#include <variant>
 #include <vector>
 
 #include <takatori/type/primitive.h>
@@ -46,6 +48,7 @@
 #include <mizugaki/analyzer/details/analyze_name.h>
 #include <mizugaki/analyzer/details/analyze_type.h>
 #include <mizugaki/analyzer/details/analyze_query_expression.h>
+#include <mizugaki/analyzer/details/constant_folding.h>
 
 #include "name_print_support.h"
 
@@ -73,13 +76,10 @@ public:
     [[nodiscard]] result_type process(
             ast::scalar::expression const& expression,
             value_context const& value_context) {
-        auto r = dispatch(expression, value_context);
+        auto r = finish(dispatch(expression, value_context));
         if (!r) {
             return {};
         }
-        if (!validate(*r)) {
-            return {};
-        }
         return result_type {
                 std::move(r),
                 saw_aggregate_,
@@ -131,6 +131,7 @@ public:
         }
         if (auto host_parameters = context_.host_parameters()) {
             if (auto variable = host_parameters->find(identifier)) {
+                context_.add_host_parameter_reference(variable);
                 auto descriptor = context_.bless(factory_(std::move(variable)), expr.region());
                 return context_.create<tscalar::variable_reference>(
                         expr.region(),
@@ -262,19 +263,7 @@ public:
     [[nodiscard]] std::unique_ptr<tscalar::expression> operator()(
             ast::scalar::unary_expression const& expr,
             value_context const&) {
-        auto operator_ = convert(expr.operator_kind());
-        if (!operator_) {
-            return {};
-        }
-        auto operand = process(*expr.operand(), {});
-        if (!operand) {
-            return {};
-        }
-        auto result = context_.create<tscalar::unary>(
-                expr.region(),
-                *operator_,
-                operand.release());
-        return result;
+        return process_operators(expr);
     }
 
     [[nodiscard]] std::optional<tscalar::unary_operator> convert(
@@ -311,24 +300,99 @@ public:
             return process_is(expr, {});
         }
 
-        auto operator_ = convert(expr.operator_kind());
-        if (!operator_) {
-            return {};
+        return process_operators(expr);
+    }
+
+    [[nodiscard]] static bool is_operator_node(ast::scalar::expression const& expr) noexcept {
+        if (expr.node_kind() == ast::scalar::kind::unary_expression) {
+            return true;
         }
-        auto left = process(*expr.left(), {});
-        if (!left) {
-            return {};
+        if (expr.node_kind() == ast::scalar::kind::binary_expression) {
+            auto&& binary = unsafe_downcast<ast::scalar::binary_expression>(expr);
+            return binary.operator_kind() != ast::scalar::binary_operator::is
+                    && binary.operator_kind() != ast::scalar::binary_operator::is_not;
         }
-        auto right = process(*expr.right(), {});
-        if (!right) {
-            return {};
+        return false;
+    }
+
+    /**
+     * @brief processes a tree of unary and binary operators without recursion.
+     * @details Machine generated SQL often contains very long operator chains (e.g. `a OR b OR ...`), so that
+     *      this uses explicit stacks instead of the call stack, and only recurses into the other kind of nodes.
+     *      The results, including diagnostics, are the same as processing each operand via process().
+     * @param root the root operator expression
+     * @return the analyzed expression, which is not yet passed to finish()
+     * @return empty if an error was occurred
+     */
+    [[nodiscard]] std::unique_ptr<tscalar::expression> process_operators(ast::scalar::expression const& root) {
+        struct frame {
+            ast::scalar::expression const* node;
+            bool expanded;
+        };
+        std::vector<frame> frames {};
+        std::vector<std::unique_ptr<tscalar::expression>> operands {};
+        frames.push_back({ std::addressof(root), false });
+        while (!frames.empty()) {
+            auto [node, expanded] = frames.back();
+            frames.pop_back();
+            if (!expanded) {
+                if (node != std::addressof(root) && !is_operator_node(*node)) {
+                    auto r = process(*node, {});
+                    if (!r) {
+                        return {};
+                    }
+                    operands.emplace_back(r.release());
+                    continue;
+                }
+                // NOTE: check the operator before processing its operands, as the diagnostics order
+                frames.push_back({ node, true });
+                if (node->node_kind() == ast::scalar::kind::unary_expression) {
+                    auto&& expr = unsafe_downcast<ast::scalar::unary_expression>(*node);
+                    if (!convert(expr.operator_kind())) {
+                        return {};
+                    }
+                    frames.push_back({ expr.operand().get(), false });
+                } else {
+                    auto&& expr = unsafe_downcast<ast::scalar::binary_expression>(*node);
+                    if (!convert(expr.operator_kind())) {
+                        return {};
+                    }
+                    // process left operand first
+                    frames.push_back({ expr.right().get(), false });
+                    frames.push_back({ expr.left().get(), false });
+                }
+                continue;
+            }
+            std::unique_ptr<tscalar::expression> result {};
+            if (node->node_kind() == ast::scalar::kind::unary_expression) {
+                auto&& expr = unsafe_downcast<ast::scalar::unary_expression>(*node);
+                auto operand = std::move(operands.back());
+                operands.pop_back();
+                result = context_.create<tscalar::unary>(
+                        expr.region(),
+                        *convert(expr.operator_kind()),
+                        std::move(operand));
+            } else {
+                auto&& expr = unsafe_downcast<ast::scalar::binary_expression>(*node);
+                auto right = std::move(operands.back());
+                operands.pop_back();
+                auto left = std::move(operands.back());
+                operands.pop_back();
+                result = context_.create<tscalar::binary>(
+                        expr.region(),
+                        *convert(expr.operator_kind()),
+                        std::move(left),
+                        std::move(right));
+            }
+            if (node != std::addressof(root)) {
+                result = finish(std::move(result));
+                if (!result) {
+                    return {};
+                }
+            }
+            operands.emplace_back(std::move(result));
         }
-        auto result = context_.create<tscalar::binary>(
-                expr.region(),
-                *operator_,
-                left.release(),
-                right.release());
-        return result;
+        return std::move(operands.back());
     }
 
     [[nodiscard]] std::optional<tscalar::binary_operator> convert(
@@ -1227,6 +1291,15 @@ public:
             argument_types.emplace_back(type);
         }
 
+        // reuse the previous overload resolution of the same function and argument types
+        if (auto cached = context_.overloads().find(*expr.name(), argument_types)) {
+            if (auto const* function = std::get_if<overload_cache::function_type>(cached.get())) {
+                return build_function_call(expr, *function, std::move(arguments));
+            }
+            auto&& aggregate = std::get<overload_cache::aggregate_type>(*cached);
+            return build_aggregate_function_call(expr, aggregate, std::move(arguments));
+        }
+
         // search for scalar functions
         auto function_list = analyze_function_name(context_, *expr.name(), expr.arguments().size());
         std::vector<std::shared_ptr<::yugawara::function::declaration const>> function_candidates {};
@@ -1245,11 +1318,8 @@ public:
             if (!target) {
                 return {};
             }
-            auto result = context_.create<tscalar::function_call>(
-                    expr.region(),
-                    factory_(std::move(target)),
-                    std::move(arguments));
-            return result;
+            context_.overloads().add(*expr.name(), argument_types, target);
+            return build_function_call(expr, std::move(target), std::move(arguments));
         }
 
         // search for set functions
@@ -1266,12 +1336,8 @@ public:
             if (!target) {
                 return {};
             }
-            auto result = context_.create<::yugawara::extension::scalar::aggregate_function_call>(
-                    expr.region(),
-                    factory_(std::move(target)),
-                    std::move(arguments));
-            saw_aggregate_ = true;
-            return result;
+            context_.overloads().add(*expr.name(), argument_types, target);
+            return build_aggregate_function_call(expr, std::move(target), std::move(arguments));
         }
 
         string_builder buffer {};
@@ -1285,6 +1351,29 @@ public:
         return {};
     }
 
+    [[nodiscard]] std::unique_ptr<tscalar::expression> build_function_call(
+            ast::scalar::function_invocation const& expr,
+            overload_cache::function_type target,
+            ::takatori::util::reference_vector<tscalar::expression> arguments) {
+        auto result = context_.create<tscalar::function_call>(
+                expr.region(),
+                factory_(std::move(target)),
+                std::move(arguments));
+        return result;
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::expression> build_aggregate_function_call(
+            ast::scalar::function_invocation const& expr,
+            overload_cache::aggregate_type target,
+            ::takatori::util::reference_vector<tscalar::expression> arguments) {
+        auto result = context_.create<::yugawara::extension::scalar::aggregate_function_call>(
+                expr.region(),
+                factory_(std::move(target)),
+                std::move(arguments));
+        saw_aggregate_ = true;
+        return result;
+    }
+
     [[nodiscard]] std::unique_ptr<tscalar::expression> operator()(
             ast::scalar::builtin_function_invocation const& expr,
             value_context const& context) {
@@ -1613,6 +1702,7 @@ public:
         }
         if (auto host_parameters = context_.host_parameters()) {
             if (auto variable = host_parameters->find(identifier)) {
+                context_.add_host_parameter_reference(variable);
                 auto descriptor = context_.bless(factory_(std::move(variable)), expr.region());
                 return context_.create<tscalar::variable_reference>(
                         expr.region(),
@@ -1641,9 +1731,23 @@ private:
     [[nodiscard]] std::unique_ptr<tscalar::expression> dispatch(
             ast::scalar::expression const& expression,
             value_context const& value_context) {
+        context_.check_cancellation();
         return ast::scalar::dispatch(*this, expression, value_context);
     }
 
+    [[nodiscard]] std::unique_ptr<tscalar::expression> finish(std::unique_ptr<tscalar::expression> expression) {
+        if (!expression) {
+            return {};
+        }
+        if (context_.options()->fold_constant_expressions()) {
+            expression = fold_constant(context_, std::move(expression));
+        }
+        if (!validate(*expression)) {
+            return {};
+        }
+        return expression;
+    }
+
     [[nodiscard]] bool validate(tscalar::expression const& expression) {
         if (context_.options()->validate_scalar_expressions()) {
             auto r = context_.resolve(expression, true);
@@ -1699,6 +1803,7 @@ result_type analyze_scalar_expression(
         ast::scalar::expression const& expression,
         query_scope& scope,
         value_context const& value_context) {
+    auto timer = context.measure(analyzer_context::phase::scalar_expression);
     engine e { context, scope };
     return e.process(expression, value_context);
 }
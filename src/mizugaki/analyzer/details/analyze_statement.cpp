@@ -57,6 +57,8 @@
 #include <mizugaki/analyzer/details/analyze_query_expression.h>
 #include <mizugaki/analyzer/details/analyze_scalar_expression.h>
 #include <mizugaki/analyzer/details/analyze_type.h>
+#include <mizugaki/analyzer/details/prune_scan_columns.h>
+#include <mizugaki/analyzer/details/bind_primary_key_lookup.h>
 
 #include "name_print_support.h"
 
@@ -174,6 +176,12 @@ public:
                 std::move(columns)));
         op.input().connect_to(result.output());
 
+        if (context_.options()->primary_key_lookup()) {
+            (void) bind_primary_key_lookup(context_, *graph);
+        }
+        if (context_.options()->prune_scan_columns()) {
+            (void) prune_scan_columns(*graph);
+        }
         return graph;
     }
 
@@ -545,6 +553,9 @@ public:
                 std::move(write_columns)));
         op_write.input().connect_to(*upstream);
 
+        if (context_.options()->primary_key_lookup()) {
+            (void) bind_primary_key_lookup(context_, *graph);
+        }
         return graph;
     }
 
@@ -584,6 +595,9 @@ public:
                 create_vector<trelation::write::key>()));
         op_write.input().connect_to(*upstream);
 
+        if (context_.options()->primary_key_lookup()) {
+            (void) bind_primary_key_lookup(context_, *graph);
+        }
         return graph;
     }
 
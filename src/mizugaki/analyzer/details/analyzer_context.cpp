@@ -1,5 +1,7 @@
 #include <mizugaki/analyzer/details/analyzer_context.h>
 
+#include <cstdlib>
+
 #include <takatori/util/exception.h>
 
 #include <yugawara/binding/factory.h>
@@ -33,14 +35,32 @@ finalizer analyzer_context::initialize(
     comments_ = comments;
     placeholders_ = placeholders;
     host_parameters_ = host_parameters;
+    host_parameter_references_.clear();
 
     diagnostics_.clear();
+    if (options.enable_metrics()) {
+        metrics_.emplace();
+    } else {
+        metrics_.reset();
+    }
+    phase_depths_.fill(0);
+    memory_budget_ = options.memory_budget();
+    memory_usage_ = 0;
+    if (options.cancellation()) {
+        cancellation_ = options.cancellation();
+    } else {
+        cancellation_ = {};
+    }
+    cancellation_counter_ = cancellation_check_interval - 1;
     types_.clear();
     values_.clear();
+    snapshot_.clear();
+    overloads_.clear();
     expression_analyzer_.clear_diagnostics();
     expression_analyzer_.variables().clear();
     expression_analyzer_.expressions().clear();
     expression_analyzer_.allow_unresolved(false);
+    pending_resolutions_.clear();
 
     return f;
 }
@@ -51,26 +71,55 @@ void analyzer_context::finalize() {
     comments_ = {};
     placeholders_ = {};
     host_parameters_ = {};
+    host_parameter_references_.clear();
 
     diagnostics_.clear();
+    metrics_.reset();
+    memory_budget_ = 0;
+    memory_usage_ = 0;
+    cancellation_ = {};
     types_.clear();
     values_.clear();
+    snapshot_.clear();
+    overloads_.clear();
     expression_analyzer_.clear_diagnostics();
     expression_analyzer_.variables().clear();
     expression_analyzer_.expressions().clear();
+    pending_resolutions_.clear();
 
     initialized_.store(false, std::memory_order_release);
 }
 
+void analyzer_context::add_host_parameter_reference(
+        std::shared_ptr<::yugawara::variable::declaration const> declaration) {
+    // NOTE: statements rarely have many host parameters, so that we use linear search here
+    for (auto&& reference : host_parameter_references_) {
+        if (reference == declaration) {
+            return;
+        }
+    }
+    host_parameter_references_.emplace_back(std::move(declaration));
+}
+
+metrics_timer analyzer_context::measure(phase kind) noexcept {
+    if (!metrics_) {
+        return {};
+    }
+    auto&& depth = phase_depths_[static_cast<std::size_t>(kind)]; // NOLINT(*-constant-array-index)
+    switch (kind) {
+        case phase::name_resolution: return { metrics_->name_resolution_time(), depth };
+        case phase::scalar_expression: return { metrics_->scalar_expression_time(), depth };
+        case phase::query_expression: return { metrics_->query_expression_time(), depth };
+        case phase::type_resolution: return { metrics_->type_resolution_time(), depth };
+    }
+    std::abort();
+}
+
 std::shared_ptr<::takatori::type::data const>
 analyzer_context::resolve(::takatori::scalar::expression const& expression, bool validate) {
+    auto timer = measure(phase::type_resolution);
     auto result = expression_analyzer_.resolve(expression, validate, types_);
-    if (expression_analyzer_.has_diagnostics()) {
-        for (auto&& d : expression_analyzer_.diagnostics()) {
-            auto code = convert_code(d.code());
-            report(code, d.message(), d.location());
-        }
-        expression_analyzer_.clear_diagnostics();
+    if (!report_resolution_diagnostics()) {
         return {};
     }
     if (!result) {
@@ -83,13 +132,9 @@ analyzer_context::resolve(::takatori::scalar::expression const& expression, bool
 }
 
 bool analyzer_context::resolve(::takatori::relation::expression const& expression, bool validate) {
+    auto timer = measure(phase::type_resolution);
     auto result = expression_analyzer_.resolve(expression, validate, false, types_);
-    if (expression_analyzer_.has_diagnostics()) {
-        for (auto&& d : expression_analyzer_.diagnostics()) {
-            auto code = convert_code(d.code());
-            report(code, d.message(), d.location());
-        }
-        expression_analyzer_.clear_diagnostics();
+    if (!report_resolution_diagnostics()) {
         return false;
     }
     if (!result) {
@@ -101,6 +146,60 @@ bool analyzer_context::resolve(::takatori::relation::expression const& expressio
     return true;
 }
 
+bool analyzer_context::resolve_later(::takatori::relation::expression const& expression) {
+    if (!options_->batch_relation_resolution()) {
+        return resolve(expression);
+    }
+    pending_resolutions_.push_back(std::addressof(expression));
+    return true;
+}
+
+bool analyzer_context::resolve_pending(std::size_t offset) {
+    if (offset >= pending_resolutions_.size()) {
+        return true;
+    }
+    auto timer = measure(phase::type_resolution);
+    bool success = true;
+    // NOTE: the pending operators are ordered by their creation, and they never define any variables
+    for (auto iter = pending_resolutions_.begin() + static_cast<std::ptrdiff_t>(offset);
+            iter != pending_resolutions_.end();
+            ++iter) {
+        auto&& expression = **iter;
+        if (!expression_analyzer_.resolve(expression, false, false, types_)
+                && !expression_analyzer_.has_diagnostics()) {
+            report(sql_analyzer_code::unknown,
+                    "unknown error occurred while analyzing type of scalar expression",
+                    expression.region());
+            success = false;
+        }
+    }
+    if (!report_resolution_diagnostics()) {
+        success = false;
+    }
+    discard_pending(offset);
+    return success;
+}
+
+void analyzer_context::discard_pending(std::size_t offset) noexcept {
+    if (offset < pending_resolutions_.size()) {
+        pending_resolutions_.erase(
+                pending_resolutions_.begin() + static_cast<std::ptrdiff_t>(offset),
+                pending_resolutions_.end());
+    }
+}
+
+bool analyzer_context::report_resolution_diagnostics() {
+    if (!expression_analyzer_.has_diagnostics()) {
+        return true;
+    }
+    for (auto&& d : expression_analyzer_.diagnostics()) {
+        auto code = convert_code(d.code());
+        report(code, d.message(), d.location());
+    }
+    expression_analyzer_.clear_diagnostics();
+    return false;
+}
+
 void analyzer_context::clear_expression_resolution() {
     expression_analyzer_.expressions().clear();
 }
@@ -176,11 +275,17 @@ void analyzer_context::report(
     diagnostics_.emplace_back(code, std::move(message), convert(region));
 }
 
-::takatori::descriptor::variable analyzer_context::stream_variable(ast::scalar::expression const& expression) const {
+::takatori::descriptor::variable analyzer_context::stream_variable(ast::scalar::expression const& expression) {
+    if (metrics_) {
+        ++metrics_->variable_count();
+    }
     return bless(::yugawara::binding::factory {}.stream_variable(), expression.region());
 }
 
-takatori::descriptor::variable analyzer_context::local_variable(ast::scalar::expression const& expression) const {
+takatori::descriptor::variable analyzer_context::local_variable(ast::scalar::expression const& expression) {
+    if (metrics_) {
+        ++metrics_->variable_count();
+    }
     return bless(::yugawara::binding::factory {}.local_variable(), expression.region());
 }
 
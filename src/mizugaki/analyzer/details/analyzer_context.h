@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include <takatori/type/data.h>
 #include <takatori/value/data.h>
@@ -8,18 +12,29 @@
 #include <takatori/scalar/expression.h>
 
 #include <takatori/relation/expression.h>
+#include <takatori/relation/graph.h>
 
+#include <takatori/util/exception.h>
 #include <takatori/util/finalizer.h>
 
 #include <yugawara/compiled_info.h>
 
 #include <yugawara/analyzer/expression_analyzer.h>
 
+#include <yugawara/variable/declaration.h>
+
 #include <yugawara/util/object_repository.h>
 
 #include <mizugaki/ast/scalar/expression.h>
 
 #include <mizugaki/analyzer/sql_analyzer.h>
+#include <mizugaki/analyzer/sql_analyzer_metrics.h>
+
+#include "analysis_cancelled.h"
+#include "catalog_snapshot.h"
+#include "memory_budget_exceeded.h"
+#include "metrics_timer.h"
+#include "overload_cache.h"
 
 namespace mizugaki::analyzer::details {
 
@@ -29,6 +44,13 @@ public:
     using result_type = sql_analyzer::result_type;
     using diagnostic_type = result_type::diagnostic_type;
 
+    enum class phase : std::size_t {
+        name_resolution,
+        scalar_expression,
+        query_expression,
+        type_resolution,
+    };
+
     [[nodiscard]] ::takatori::util::finalizer initialize(
             options_type const& options,
             ::takatori::util::optional_ptr<::takatori::document::document const> source = {},
@@ -56,6 +78,66 @@ public:
         return host_parameters_;
     }
 
+    [[nodiscard]] std::vector<std::shared_ptr<::yugawara::variable::declaration const>> const&
+    host_parameter_references() const noexcept {
+        return host_parameter_references_;
+    }
+
+    void add_host_parameter_reference(std::shared_ptr<::yugawara::variable::declaration const> declaration);
+
+    [[nodiscard]] std::optional<sql_analyzer_metrics>& metrics() noexcept {
+        return metrics_;
+    }
+
+    [[nodiscard]] metrics_timer measure(phase kind) noexcept;
+
+    /**
+     * @brief adds the estimated memory usage of the current analysis.
+     * @param bytes the number of bytes
+     * @throws memory_budget_exceeded if the estimated memory usage exceeds sql_analyzer_options::memory_budget()
+     */
+    void consume_memory(std::size_t bytes) {
+        memory_usage_ += bytes;
+        if (memory_budget_ != 0 && memory_usage_ > memory_budget_) {
+            ::takatori::util::throw_exception(memory_budget_exceeded {});
+        }
+    }
+
+    /**
+     * @brief adds the estimated memory usage of the given number of elements.
+     * @tparam T the element type
+     * @param count the number of elements
+     * @throws memory_budget_exceeded if the estimated memory usage exceeds sql_analyzer_options::memory_budget()
+     */
+    template<class T>
+    void consume_elements(std::size_t count) {
+        consume_memory(sizeof(T) * count);
+    }
+
+    [[nodiscard]] std::size_t memory_usage() const noexcept {
+        return memory_usage_;
+    }
+
+    /// @brief the number of check_cancellation() calls between individual checks of the cancellation token.
+    static constexpr std::size_t cancellation_check_interval = 64;
+
+    /**
+     * @brief checks whether the current analysis should be interrupted.
+     * @details This only checks the cancellation token for every cancellation_check_interval calls,
+     *      including the first one.
+     * @throws analysis_cancelled if the analysis was cancelled or has exceeded its deadline
+     * @see sql_analyzer_options::cancellation()
+     */
+    void check_cancellation() {
+        if (!cancellation_ || ++cancellation_counter_ < cancellation_check_interval) {
+            return;
+        }
+        cancellation_counter_ = 0;
+        if (auto status = cancellation_->status(); status != cancellation_status::none) {
+            ::takatori::util::throw_exception(analysis_cancelled { status });
+        }
+    }
+
     [[nodiscard]] std::vector<result_type::diagnostic_type>& diagnostics() noexcept {
         return diagnostics_;
     }
@@ -64,20 +146,52 @@ public:
         return diagnostics_;
     }
 
-    [[nodiscard]] ::yugawara::util::object_repository<::takatori::type::data>& types() noexcept {
+    /**
+     * @brief returns the type repository.
+     * @details Each call site interns at most one type, so this charges the memory budget for one entry.
+     * @return the type repository
+     * @throws memory_budget_exceeded if the estimated memory usage exceeds sql_analyzer_options::memory_budget()
+     */
+    [[nodiscard]] ::yugawara::util::object_repository<::takatori::type::data>& types() {
+        consume_memory(repository_entry_size<::takatori::type::data>);
         return types_;
     }
 
-    [[nodiscard]] ::yugawara::util::object_repository<::takatori::value::data>& values() noexcept {
+    /**
+     * @brief returns the value repository.
+     * @details Each call site interns at most one value, so this charges the memory budget for one entry.
+     * @return the value repository
+     * @throws memory_budget_exceeded if the estimated memory usage exceeds sql_analyzer_options::memory_budget()
+     */
+    [[nodiscard]] ::yugawara::util::object_repository<::takatori::value::data>& values() {
+        consume_memory(repository_entry_size<::takatori::value::data>);
         return values_;
     }
 
+    [[nodiscard]] catalog_snapshot& snapshot() noexcept {
+        return snapshot_;
+    }
+
+    [[nodiscard]] overload_cache& overloads() noexcept {
+        return overloads_;
+    }
+
     [[nodiscard]] std::shared_ptr<::takatori::type::data const> resolve(
             ::takatori::scalar::expression const& expression,
             bool validate = false);
 
     [[nodiscard]] bool resolve(::takatori::relation::expression const& expression, bool validate = false);
 
+    [[nodiscard]] bool resolve_later(::takatori::relation::expression const& expression);
+
+    [[nodiscard]] std::size_t pending_resolution_size() const noexcept {
+        return pending_resolutions_.size();
+    }
+
+    [[nodiscard]] bool resolve_pending(std::size_t offset = 0);
+
+    void discard_pending(std::size_t offset = 0) noexcept;
+
     [[nodiscard]] bool is_resolved(::takatori::descriptor::variable const& variable) const;
 
     void resolve_as(
@@ -113,22 +227,43 @@ public:
             ast::node_region region);
 
     template<class T, class... Args>
-    [[nodiscard]] std::unique_ptr<T> create(::takatori::document::region region, Args&&... args) const {
+    [[nodiscard]] std::unique_ptr<T> create(::takatori::document::region region, Args&&... args) {
+        consume_memory(sizeof(T));
         auto r = std::make_unique<T>(std::forward<Args>(args)...);
         r->region() = region;
         return r;
     }
 
     template<class T, class... Args>
-    [[nodiscard]] std::unique_ptr<T> create(ast::node_region region, Args&&... args) const {
+    [[nodiscard]] std::unique_ptr<T> create(ast::node_region region, Args&&... args) {
         return create<T>(convert(region), std::forward<Args>(args)...);
     }
 
-    [[nodiscard]] ::takatori::descriptor::variable stream_variable(ast::scalar::expression const& expression) const;
+    /**
+     * @brief creates a new relational operator on the given graph.
+     * @details This charges the memory budget only for the operator itself,
+     *      so that callers must charge its element vectors by using consume_elements().
+     * @tparam T the operator type
+     * @param graph the destination graph
+     * @param args the constructor arguments
+     * @return the created operator
+     * @throws memory_budget_exceeded if the estimated memory usage exceeds sql_analyzer_options::memory_budget()
+     */
+    template<class T, class... Args>
+    T& emplace(::takatori::relation::graph_type& graph, Args&&... args) {
+        consume_memory(sizeof(T));
+        return graph.template emplace<T>(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] ::takatori::descriptor::variable stream_variable(ast::scalar::expression const& expression);
 
-    [[nodiscard]] ::takatori::descriptor::variable local_variable(ast::scalar::expression const& expression) const;
+    [[nodiscard]] ::takatori::descriptor::variable local_variable(ast::scalar::expression const& expression);
 
 private:
+    /// @brief the estimated size of each repository entry, including its allocation and hash table slot.
+    template<class T>
+    static constexpr std::size_t repository_entry_size = sizeof(T) + sizeof(std::shared_ptr<T const>) * 2;
+
     std::atomic<bool> initialized_ { false };
 
     ::takatori::util::optional_ptr<options_type const> options_ {};
@@ -136,14 +271,26 @@ private:
     ::takatori::util::sequence_view<ast::node_region const> comments_ {};
     ::takatori::util::optional_ptr<placeholder_map const> placeholders_ {};
     ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters_ {};
+    std::vector<std::shared_ptr<::yugawara::variable::declaration const>> host_parameter_references_ {};
 
     std::vector<diagnostic_type> diagnostics_ {};
+    std::optional<sql_analyzer_metrics> metrics_ {};
+    std::array<std::size_t, 4> phase_depths_ {};
+    std::size_t memory_budget_ {};
+    std::size_t memory_usage_ {};
+    ::takatori::util::optional_ptr<cancellation_token const> cancellation_ {};
+    std::size_t cancellation_counter_ {};
     ::yugawara::util::object_repository<::takatori::type::data> types_ {};
     ::yugawara::util::object_repository<::takatori::value::data> values_ {};
+    catalog_snapshot snapshot_ {};
+    overload_cache overloads_ {};
     ::yugawara::analyzer::expression_analyzer expression_analyzer_ {};
+    std::vector<::takatori::relation::expression const*> pending_resolutions_ {};
 
     void finalize();
 
+    [[nodiscard]] bool report_resolution_diagnostics();
+
     static sql_analyzer_code convert_code(
             ::yugawara::analyzer::expression_analyzer_code code) noexcept;
 
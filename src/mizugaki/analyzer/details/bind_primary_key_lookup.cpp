@@ -0,0 +1,374 @@
+#include <mizugaki/analyzer/details/bind_primary_key_lookup.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <takatori/type/primitive.h>
+
+#include <takatori/value/primitive.h>
+
+#include <takatori/descriptor/variable.h>
+
+#include <takatori/scalar/binary.h>
+#include <takatori/scalar/cast.h>
+#include <takatori/scalar/compare.h>
+#include <takatori/scalar/immediate.h>
+#include <takatori/scalar/variable_reference.h>
+
+#include <takatori/relation/endpoint_kind.h>
+#include <takatori/relation/filter.h>
+#include <takatori/relation/scan.h>
+
+#include <takatori/util/clonable.h>
+#include <takatori/util/downcast.h>
+
+#include <yugawara/binding/extract.h>
+#include <yugawara/binding/variable_info.h>
+
+#include <yugawara/storage/column.h>
+#include <yugawara/storage/index.h>
+
+namespace mizugaki::analyzer::details {
+
+namespace ttype = ::takatori::type;
+namespace tvalue = ::takatori::value;
+namespace tdescriptor = ::takatori::descriptor;
+namespace tscalar = ::takatori::scalar;
+namespace trelation = ::takatori::relation;
+
+using ::takatori::util::clone_unique;
+using ::takatori::util::unsafe_downcast;
+
+namespace {
+
+[[nodiscard]] std::size_t integer_width(ttype::data const& type) noexcept {
+    switch (type.kind()) {
+        case ttype::int1::tag: return 1;
+        case ttype::int2::tag: return 2;
+        case ttype::int4::tag: return 4;
+        case ttype::int8::tag: return 8;
+        default: return 0;
+    }
+}
+
+[[nodiscard]] std::optional<std::int64_t> integer_value(tscalar::expression const& expr) noexcept {
+    if (expr.kind() != tscalar::immediate::tag) {
+        return {};
+    }
+    auto&& value = unsafe_downcast<tscalar::immediate>(expr).value();
+    switch (value.kind()) {
+        case tvalue::int4::tag: return unsafe_downcast<tvalue::int4>(value).get();
+        case tvalue::int8::tag: return unsafe_downcast<tvalue::int8>(value).get();
+        default: return {};
+    }
+}
+
+[[nodiscard]] bool is_in_range(std::int64_t value, std::size_t width) noexcept {
+    if (width == 0) {
+        return false;
+    }
+    if (width >= sizeof(std::int64_t)) {
+        return true;
+    }
+    auto bits = width * 8U - 1U;
+    auto max = (static_cast<std::int64_t>(1) << bits) - 1;
+    auto min = -max - 1;
+    return min <= value && value <= max;
+}
+
+[[nodiscard]] bool is_conjunction(tscalar::expression const& expr) noexcept {
+    return expr.kind() == tscalar::binary::tag
+            && unsafe_downcast<tscalar::binary>(expr).operator_kind() == tscalar::binary_operator::conditional_and;
+}
+
+class engine {
+public:
+    explicit engine(analyzer_context& context) noexcept :
+        context_ { context }
+    {}
+
+    [[nodiscard]] bool process(trelation::graph_type& graph) {
+        // NOTE: collect the targets first, because rewriting them may remove filters from the graph
+        std::vector<std::pair<trelation::scan*, trelation::filter*>> targets {};
+        for (auto&& op : graph) {
+            if (op.kind() != trelation::scan::tag) {
+                continue;
+            }
+            auto&& scan = unsafe_downcast<trelation::scan>(op);
+            auto next = scan.output().opposite();
+            if (!next || next->owner().kind() != trelation::filter::tag) {
+                continue;
+            }
+            targets.emplace_back(std::addressof(scan), std::addressof(unsafe_downcast<trelation::filter>(next->owner())));
+        }
+        bool rewritten = false;
+        for (auto [scan, filter] : targets) {
+            if (process(graph, *scan, *filter)) {
+                rewritten = true;
+            }
+        }
+        return rewritten;
+    }
+
+private:
+    /**
+     * @brief an equivalent condition on a key column.
+     */
+    struct key_condition {
+        tdescriptor::variable const* column {};
+        tscalar::compare const* condition {};
+        bool value_on_right {};
+    };
+
+    analyzer_context& context_;
+    ::yugawara::storage::index const* index_ {};
+    std::vector<std::pair<tdescriptor::variable const*, std::size_t>> key_variables_ {};
+    std::vector<key_condition> conditions_ {};
+
+    [[nodiscard]] bool process(trelation::graph_type& graph, trelation::scan& scan, trelation::filter& filter) {
+        if (scan.lower().kind() != trelation::endpoint_kind::unbound
+                || scan.upper().kind() != trelation::endpoint_kind::unbound
+                || scan.limit()) {
+            return false;
+        }
+        if (!prepare(scan)) {
+            return false;
+        }
+        collect(filter.condition());
+        for (auto&& condition : conditions_) {
+            if (condition.column == nullptr || condition.condition == nullptr) {
+                return false;
+            }
+        }
+
+        std::vector<std::unique_ptr<tscalar::expression>> consumed {};
+        consumed.reserve(conditions_.size());
+        auto rest = strip(filter.release_condition(), consumed);
+        bind(scan, consumed);
+
+        if (rest) {
+            filter.condition(std::move(rest));
+            return true;
+        }
+
+        // the filter has no more conditions
+        auto downstream = filter.output().opposite();
+        scan.output().disconnect_from(filter.input());
+        if (downstream) {
+            filter.output().disconnect_from(*downstream);
+            scan.output().connect_to(*downstream);
+        }
+        for (auto iter = graph.begin(); iter != graph.end(); ++iter) {
+            if (std::addressof(*iter) == std::addressof(filter)) {
+                graph.erase(iter);
+                break;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool prepare(trelation::scan const& scan) {
+        index_ = std::addressof(::yugawara::binding::extract<::yugawara::storage::index>(scan.source()));
+        auto&& keys = index_->keys();
+        if (keys.empty()) {
+            return false;
+        }
+        key_variables_.clear();
+        conditions_.clear();
+        conditions_.resize(keys.size());
+        for (auto&& column : scan.columns()) {
+            auto&& source = ::yugawara::binding::extract<::yugawara::storage::column>(column.source());
+            for (std::size_t position = 0; position < keys.size(); ++position) {
+                if (std::addressof(keys[position].column()) == std::addressof(source)) {
+                    conditions_[position].column = std::addressof(column.source());
+                    key_variables_.emplace_back(std::addressof(column.destination()), position);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    void collect(tscalar::expression const& expr) {
+        if (is_conjunction(expr)) {
+            auto&& binary = unsafe_downcast<tscalar::binary>(expr);
+            collect(binary.left());
+            collect(binary.right());
+            return;
+        }
+        if (expr.kind() != tscalar::compare::tag) {
+            return;
+        }
+        auto&& compare = unsafe_downcast<tscalar::compare>(expr);
+        if (compare.operator_kind() != tscalar::comparison_operator::equal) {
+            return;
+        }
+        if (!match(compare, compare.left(), compare.right(), true)) {
+            (void) match(compare, compare.right(), compare.left(), false);
+        }
+    }
+
+    [[nodiscard]] bool match(
+            tscalar::compare const& compare,
+            tscalar::expression const& column,
+            tscalar::expression const& value,
+            bool value_on_right) {
+        if (column.kind() != tscalar::variable_reference::tag) {
+            return false;
+        }
+        auto&& variable = unsafe_downcast<tscalar::variable_reference>(column).variable();
+        for (auto&& [key_variable, position] : key_variables_) {
+            if (*key_variable != variable) {
+                continue;
+            }
+            auto&& condition = conditions_[position];
+            if (condition.condition != nullptr || !is_constant(value)) {
+                return false;
+            }
+            auto type = context_.resolve(value);
+            auto&& column_type = index_->keys()[position].column().type();
+            if (!type || (!is_assignable(*type, column_type) && !is_narrowable(value, column_type))) {
+                return false;
+            }
+            condition.condition = std::addressof(compare);
+            condition.value_on_right = value_on_right;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool is_constant(tscalar::expression const& expr) const {
+        switch (expr.kind()) {
+            case tscalar::immediate::tag:
+                return true;
+            case tscalar::variable_reference::tag:
+                return ::yugawara::binding::kind_of(unsafe_downcast<tscalar::variable_reference>(expr).variable())
+                        == ::yugawara::binding::variable_info_kind::external_variable;
+            case tscalar::cast::tag:
+                return is_constant(unsafe_downcast<tscalar::cast>(expr).operand());
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] static bool is_assignable(ttype::data const& value, ttype::data const& column) {
+        if (value == column) {
+            return true;
+        }
+        // widening integers never change their values
+        auto value_width = integer_width(value);
+        auto column_width = integer_width(column);
+        return value_width > 0 && column_width > 0 && value_width <= column_width;
+    }
+
+    [[nodiscard]] static bool is_narrowable(tscalar::expression const& value, ttype::data const& column) noexcept {
+        // integer literals are int8 by default, so we accept them if they fit into the narrower key column
+        auto integer = integer_value(value);
+        return integer && is_in_range(*integer, integer_width(column));
+    }
+
+    [[nodiscard]] bool is_consumed(tscalar::expression const& expr) const noexcept {
+        for (auto&& condition : conditions_) {
+            if (condition.condition == std::addressof(expr)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::expression> strip(
+            std::unique_ptr<tscalar::expression> expr,
+            std::vector<std::unique_ptr<tscalar::expression>>& consumed) {
+        if (is_consumed(*expr)) {
+            consumed.emplace_back(std::move(expr));
+            return {};
+        }
+        if (!is_conjunction(*expr)) {
+            return expr;
+        }
+        auto&& binary = unsafe_downcast<tscalar::binary>(*expr);
+        auto left = strip(binary.release_left(), consumed);
+        auto right = strip(binary.release_right(), consumed);
+        if (!left || !right) {
+            context_.clear_expression_resolution(binary);
+            return left ? std::move(left) : std::move(right);
+        }
+        binary.left(std::move(left));
+        binary.right(std::move(right));
+        return expr;
+    }
+
+    void bind(trelation::scan& scan, std::vector<std::unique_ptr<tscalar::expression>>& consumed) {
+        std::vector<trelation::scan::key> lower {};
+        std::vector<trelation::scan::key> upper {};
+        lower.reserve(conditions_.size());
+        upper.reserve(conditions_.size());
+        for (std::size_t position = 0; position < conditions_.size(); ++position) {
+            auto&& condition = conditions_[position];
+            auto&& compare = find_consumed(consumed, *condition.condition);
+            context_.clear_expression_resolution(condition.value_on_right ? compare.left() : compare.right());
+            context_.clear_expression_resolution(compare);
+            auto value = condition.value_on_right ? compare.release_right() : compare.release_left();
+            value = convert(std::move(value), index_->keys()[position].column());
+            auto copy = clone_unique(*value);
+            lower.emplace_back(*condition.column, std::move(value));
+            upper.emplace_back(*condition.column, std::move(copy));
+        }
+        scan.lower() = trelation::scan::endpoint {
+                std::move(lower),
+                trelation::endpoint_kind::inclusive,
+        };
+        scan.upper() = trelation::scan::endpoint {
+                std::move(upper),
+                trelation::endpoint_kind::inclusive,
+        };
+    }
+
+    [[nodiscard]] static tscalar::compare& find_consumed(
+            std::vector<std::unique_ptr<tscalar::expression>>& consumed,
+            tscalar::compare const& condition) {
+        for (auto&& expr : consumed) {
+            if (expr.get() == std::addressof(condition)) {
+                return unsafe_downcast<tscalar::compare>(*expr);
+            }
+        }
+        std::abort();
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::expression> convert(
+            std::unique_ptr<tscalar::expression> value,
+            ::yugawara::storage::column const& column) {
+        auto type = context_.resolve(*value);
+        if (type && *type == column.type()) {
+            return value;
+        }
+        auto region = value->region();
+        if (auto width = integer_width(column.type());
+                width > 0 && width < sizeof(std::int64_t) && (!type || integer_width(*type) > width)) {
+            // only narrowable immediates reach here, so we rebuild them with the key column type
+            auto integer = integer_value(*value);
+            return context_.create<tscalar::immediate>(
+                    region,
+                    context_.values().get(tvalue::int4 { static_cast<std::int32_t>(*integer) }),
+                    column.shared_type());
+        }
+        return context_.create<tscalar::cast>(
+                region,
+                column.shared_type(),
+                tscalar::cast_loss_policy::error,
+                std::move(value));
+    }
+};
+
+} // namespace
+
+bool bind_primary_key_lookup(analyzer_context& context, trelation::graph_type& graph) {
+    engine e { context };
+    return e.process(graph);
+}
+
+} // namespace mizugaki::analyzer::details
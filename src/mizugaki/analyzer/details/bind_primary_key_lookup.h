@@ -0,0 +1,28 @@
+#pragma once
+
+#include <takatori/relation/graph.h>
+
+#include <mizugaki/analyzer/details/analyzer_context.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief converts table scans filtered by equivalent conditions on the whole primary key into point lookups.
+ * @details For each table scan on the primary index which is directly followed by a filter,
+ *      this looks for the equivalent conditions `<key-column> = <value>` in the top level conjunction of the filter,
+ *      where each value is a constant or a host parameter.
+ *      If they cover all the primary key columns, this moves them into the both ends of the scan range,
+ *      and then removes the filter if no other conditions are left.
+ *
+ *      The value must have the same type as the key column, or be an integer whose type is narrower than it.
+ *      Additionally, integer immediates of wider types are accepted if their values fit into the key column,
+ *      and they are rebuilt as immediates of the key column type.
+ *      This only rewrites the operators in the top level graph, and leaves the others as is.
+ * @param context the current analyzer context
+ * @param graph the target graph, must be complete
+ * @return true if this rewrote any table scans
+ * @return false if the graph was left as is
+ */
+bool bind_primary_key_lookup(analyzer_context& context, ::takatori::relation::graph_type& graph);
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,103 @@
+#include <mizugaki/analyzer/details/catalog_snapshot.h>
+
+namespace mizugaki::analyzer::details {
+
+using schema_decl = ::yugawara::schema::declaration;
+
+catalog_snapshot::schema_type const& catalog_snapshot::find_schema(catalog_type const& parent, std::string_view name) {
+    build_key(std::addressof(parent), name);
+    return find(schemas_, [&] {
+        return parent.schema_provider().find(name);
+    });
+}
+
+catalog_snapshot::relation_type const& catalog_snapshot::find_relation(schema_decl const& parent, std::string_view name) {
+    build_key(std::addressof(parent), name);
+    return find(relations_, [&] {
+        return parent.storage_provider().find_relation(name);
+    });
+}
+
+catalog_snapshot::table_type const& catalog_snapshot::find_table(schema_decl const& parent, std::string_view name) {
+    build_key(std::addressof(parent), name);
+    return find(tables_, [&] {
+        return parent.storage_provider().find_table(name);
+    });
+}
+
+catalog_snapshot::index_type const& catalog_snapshot::find_index(schema_decl const& parent, std::string_view name) {
+    build_key(std::addressof(parent), name);
+    return find(indices_, [&] {
+        return parent.storage_provider().find_index(name);
+    });
+}
+
+catalog_snapshot::variable_type const& catalog_snapshot::find_variable(schema_decl const& parent, std::string_view name) {
+    build_key(std::addressof(parent), name);
+    return find(variables_, [&] {
+        return parent.variable_provider().find(name);
+    });
+}
+
+std::vector<catalog_snapshot::function_type> const& catalog_snapshot::find_functions(
+        schema_decl const& parent,
+        std::string_view name,
+        std::size_t argument_count) {
+    build_key(std::addressof(parent), name, argument_count);
+    return find(functions_, [&] {
+        std::vector<function_type> result {};
+        parent.function_provider().each(
+                name,
+                argument_count,
+                [&](function_type const& f) -> void {
+                    result.push_back(f);
+                });
+        return result;
+    });
+}
+
+std::vector<catalog_snapshot::aggregation_type> const& catalog_snapshot::find_aggregations(
+        schema_decl const& parent,
+        std::string_view name,
+        std::size_t argument_count) {
+    build_key(std::addressof(parent), name, argument_count);
+    return find(aggregations_, [&] {
+        std::vector<aggregation_type> result {};
+        parent.set_function_provider().each(
+                name,
+                argument_count,
+                [&](aggregation_type const& f) -> void {
+                    result.push_back(f);
+                });
+        return result;
+    });
+}
+
+void catalog_snapshot::clear() noexcept {
+    schemas_.clear();
+    relations_.clear();
+    tables_.clear();
+    indices_.clear();
+    variables_.clear();
+    functions_.clear();
+    aggregations_.clear();
+}
+
+void catalog_snapshot::build_key(void const* parent, std::string_view name, std::size_t argument_count) {
+    key_buffer_.clear();
+    key_buffer_.append(reinterpret_cast<char const*>(&parent), sizeof(parent)); // NOLINT(*-reinterpret-cast)
+    key_buffer_.append(reinterpret_cast<char const*>(&argument_count), sizeof(argument_count)); // NOLINT(*-reinterpret-cast)
+    key_buffer_.append(name);
+}
+
+template<class T, class Loader>
+T const& catalog_snapshot::find(map_type<T>& entries, Loader&& loader) {
+    if (auto iter = entries.find(key_buffer_); iter != entries.end()) {
+        return *iter->second;
+    }
+    auto [iter, success] = entries.emplace(key_buffer_, std::make_unique<T const>(loader()));
+    (void) success;
+    return *iter->second;
+}
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tsl/hopscotch_map.h>
+
+#include <yugawara/schema/catalog.h>
+#include <yugawara/schema/declaration.h>
+
+#include <yugawara/storage/relation.h>
+#include <yugawara/storage/table.h>
+#include <yugawara/storage/index.h>
+
+#include <yugawara/variable/declaration.h>
+
+#include <yugawara/function/declaration.h>
+#include <yugawara/aggregate/declaration.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief memorizes the catalog lookups during an analysis.
+ * @details The first lookup of each name consults the underlying providers, and the following lookups of the same
+ *      name only refer the memorized result, including the "not found" results.
+ *      Consequently, each statement observes a consistent view of the catalog even if it is modified concurrently.
+ */
+class catalog_snapshot {
+public:
+    using catalog_type = ::yugawara::schema::catalog;
+    using schema_type = std::shared_ptr<::yugawara::schema::declaration const>;
+    using relation_type = std::shared_ptr<::yugawara::storage::relation const>;
+    using table_type = std::shared_ptr<::yugawara::storage::table const>;
+    using index_type = std::shared_ptr<::yugawara::storage::index const>;
+    using variable_type = std::shared_ptr<::yugawara::variable::declaration const>;
+    using function_type = std::shared_ptr<::yugawara::function::declaration const>;
+    using aggregation_type = std::shared_ptr<::yugawara::aggregate::declaration const>;
+
+    [[nodiscard]] schema_type const& find_schema(catalog_type const& parent, std::string_view name);
+
+    [[nodiscard]] relation_type const& find_relation(::yugawara::schema::declaration const& parent, std::string_view name);
+
+    [[nodiscard]] table_type const& find_table(::yugawara::schema::declaration const& parent, std::string_view name);
+
+    [[nodiscard]] index_type const& find_index(::yugawara::schema::declaration const& parent, std::string_view name);
+
+    [[nodiscard]] variable_type const& find_variable(::yugawara::schema::declaration const& parent, std::string_view name);
+
+    [[nodiscard]] std::vector<function_type> const& find_functions(
+            ::yugawara::schema::declaration const& parent,
+            std::string_view name,
+            std::size_t argument_count);
+
+    [[nodiscard]] std::vector<aggregation_type> const& find_aggregations(
+            ::yugawara::schema::declaration const& parent,
+            std::string_view name,
+            std::size_t argument_count);
+
+    void clear() noexcept;
+
+private:
+    // NOTE: hopscotch_map may move its values, so that we must not return references to them
+    template<class T>
+    using map_type = ::tsl::hopscotch_map<std::string, std::unique_ptr<T const>, std::hash<std::string_view>, std::equal_to<>>;
+
+    map_type<schema_type> schemas_ {};
+    map_type<relation_type> relations_ {};
+    map_type<table_type> tables_ {};
+    map_type<index_type> indices_ {};
+    map_type<variable_type> variables_ {};
+    map_type<std::vector<function_type>> functions_ {};
+    map_type<std::vector<aggregation_type>> aggregations_ {};
+    std::string key_buffer_ {};
+
+    void build_key(void const* parent, std::string_view name, std::size_t argument_count = 0);
+
+    template<class T, class Loader>
+    [[nodiscard]] T const& find(map_type<T>& entries, Loader&& loader);
+};
+
+} // namespace mizugaki::analyzer::details
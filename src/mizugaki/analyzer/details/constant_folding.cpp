@@ -0,0 +1,487 @@
+#include <mizugaki/analyzer/details/constant_folding.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <takatori/datetime/conversion.h>
+
+#include <takatori/type/primitive.h>
+#include <takatori/type/character.h>
+#include <takatori/type/date.h>
+
+#include <takatori/value/primitive.h>
+#include <takatori/value/character.h>
+#include <takatori/value/date.h>
+
+#include <takatori/scalar/immediate.h>
+#include <takatori/scalar/cast.h>
+#include <takatori/scalar/unary.h>
+#include <takatori/scalar/binary.h>
+#include <takatori/scalar/compare.h>
+
+#include <takatori/util/downcast.h>
+
+namespace mizugaki::analyzer::details {
+
+namespace ttype = ::takatori::type;
+namespace tvalue = ::takatori::value;
+namespace tscalar = ::takatori::scalar;
+
+using ::takatori::util::unsafe_downcast;
+
+namespace {
+
+class engine {
+public:
+    explicit engine(analyzer_context& context) noexcept :
+        context_ { context }
+    {}
+
+    [[nodiscard]] std::unique_ptr<tscalar::expression> process(std::unique_ptr<tscalar::expression> expression) {
+        std::unique_ptr<tscalar::immediate> result {};
+        switch (expression->kind()) {
+            case tscalar::unary::tag:
+                result = fold_unary(unsafe_downcast<tscalar::unary>(*expression));
+                break;
+            case tscalar::binary::tag:
+                result = fold_binary(unsafe_downcast<tscalar::binary>(*expression));
+                break;
+            case tscalar::compare::tag:
+                result = fold_compare(unsafe_downcast<tscalar::compare>(*expression));
+                break;
+            case tscalar::cast::tag:
+                result = fold_cast(unsafe_downcast<tscalar::cast>(*expression));
+                break;
+            default:
+                break;
+        }
+        if (!result) {
+            return expression;
+        }
+        result->region() = expression->region();
+        release(*expression);
+        return result;
+    }
+
+private:
+    analyzer_context& context_;
+
+    // NOTE: operands may be already resolved if validate_scalar_expressions() is enabled
+    void release(tscalar::expression const& expression) {
+        switch (expression.kind()) {
+            case tscalar::unary::tag:
+                context_.clear_expression_resolution(unsafe_downcast<tscalar::unary>(expression).operand());
+                break;
+            case tscalar::binary::tag: {
+                auto&& binary = unsafe_downcast<tscalar::binary>(expression);
+                context_.clear_expression_resolution(binary.left());
+                context_.clear_expression_resolution(binary.right());
+                break;
+            }
+            case tscalar::compare::tag: {
+                auto&& compare = unsafe_downcast<tscalar::compare>(expression);
+                context_.clear_expression_resolution(compare.left());
+                context_.clear_expression_resolution(compare.right());
+                break;
+            }
+            case tscalar::cast::tag:
+                context_.clear_expression_resolution(unsafe_downcast<tscalar::cast>(expression).operand());
+                break;
+            default:
+                break;
+        }
+        context_.clear_expression_resolution(expression);
+    }
+
+    [[nodiscard]] static tscalar::immediate const* as_immediate(tscalar::expression const& expression) noexcept {
+        if (expression.kind() != tscalar::immediate::tag) {
+            return nullptr;
+        }
+        return std::addressof(unsafe_downcast<tscalar::immediate>(expression));
+    }
+
+    [[nodiscard]] static std::optional<std::int32_t> as_int4(tscalar::immediate const& expression) noexcept {
+        if (expression.type().kind() == ttype::type_kind::int4
+                && expression.value().kind() == tvalue::value_kind::int4) {
+            return unsafe_downcast<tvalue::int4>(expression.value()).get();
+        }
+        return {};
+    }
+
+    [[nodiscard]] static std::optional<std::int64_t> as_int8(tscalar::immediate const& expression) noexcept {
+        if (expression.type().kind() == ttype::type_kind::int8
+                && expression.value().kind() == tvalue::value_kind::int8) {
+            return unsafe_downcast<tvalue::int8>(expression.value()).get();
+        }
+        return {};
+    }
+
+    [[nodiscard]] static std::optional<std::int64_t> as_integer(tscalar::immediate const& expression) noexcept {
+        if (auto v = as_int4(expression)) {
+            return *v;
+        }
+        return as_int8(expression);
+    }
+
+    [[nodiscard]] static std::optional<double> as_float8(tscalar::immediate const& expression) noexcept {
+        if (expression.type().kind() == ttype::type_kind::float8
+                && expression.value().kind() == tvalue::value_kind::float8) {
+            return unsafe_downcast<tvalue::float8>(expression.value()).get();
+        }
+        return {};
+    }
+
+    [[nodiscard]] static std::optional<bool> as_boolean(tscalar::immediate const& expression) noexcept {
+        if (expression.type().kind() == ttype::type_kind::boolean
+                && expression.value().kind() == tvalue::value_kind::boolean) {
+            return unsafe_downcast<tvalue::boolean>(expression.value()).get();
+        }
+        return {};
+    }
+
+    // NOTE: only treats `VARCHAR(*)`, to avoid computing the resulting string length
+    [[nodiscard]] static std::optional<std::string_view> as_flexible_varchar(
+            tscalar::immediate const& expression) noexcept {
+        if (expression.type().kind() != ttype::type_kind::character
+                || expression.value().kind() != tvalue::value_kind::character) {
+            return {};
+        }
+        auto&& type = unsafe_downcast<ttype::character>(expression.type());
+        if (!type.varying() || type.length()) {
+            return {};
+        }
+        return unsafe_downcast<tvalue::character>(expression.value()).get();
+    }
+
+    template<class... Args>
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> create_immediate(Args&&... args) {
+        // NOTE: the region is set in process()
+        return context_.create<tscalar::immediate>(
+                ::takatori::document::region {},
+                std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> create_int4(std::int32_t value) {
+        return create_immediate(
+                context_.values().get(tvalue::int4 { value }),
+                context_.types().get(ttype::int4 {}));
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> create_int8(std::int64_t value) {
+        return create_immediate(
+                context_.values().get(tvalue::int8 { value }),
+                context_.types().get(ttype::int8 {}));
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> create_float8(double value) {
+        if (!std::isfinite(value)) {
+            return {};
+        }
+        return create_immediate(
+                context_.values().get(tvalue::float8 { value }),
+                context_.types().get(ttype::float8 {}));
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> create_boolean(bool value) {
+        return create_immediate(
+                context_.values().get(tvalue::boolean { value }),
+                context_.types().get(ttype::boolean {}));
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> fold_unary(tscalar::unary const& expression) {
+        auto operand = as_immediate(expression.operand());
+        if (!operand) {
+            return {};
+        }
+        using kind = tscalar::unary_operator;
+        switch (expression.operator_kind()) {
+            case kind::plus:
+                if (auto v = as_int4(*operand)) {
+                    return create_int4(*v);
+                }
+                if (auto v = as_int8(*operand)) {
+                    return create_int8(*v);
+                }
+                if (auto v = as_float8(*operand)) {
+                    return create_float8(*v);
+                }
+                break;
+            case kind::sign_inversion:
+                if (auto v = as_int4(*operand); v && *v != std::numeric_limits<std::int32_t>::min()) {
+                    return create_int4(-*v);
+                }
+                if (auto v = as_int8(*operand); v && *v != std::numeric_limits<std::int64_t>::min()) {
+                    return create_int8(-*v);
+                }
+                if (auto v = as_float8(*operand)) {
+                    return create_float8(-*v);
+                }
+                break;
+            case kind::conditional_not:
+                if (auto v = as_boolean(*operand)) {
+                    return create_boolean(!*v);
+                }
+                break;
+            default:
+                break;
+        }
+        return {};
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> fold_binary(tscalar::binary const& expression) {
+        auto left = as_immediate(expression.left());
+        auto right = as_immediate(expression.right());
+        if (!left || !right) {
+            return {};
+        }
+        using kind = tscalar::binary_operator;
+        switch (expression.operator_kind()) {
+            case kind::add:
+            case kind::subtract:
+            case kind::multiply:
+            case kind::divide:
+            case kind::remainder:
+                return fold_arithmetic(expression.operator_kind(), *left, *right);
+            case kind::concat:
+                if (auto l = as_flexible_varchar(*left)) {
+                    if (auto r = as_flexible_varchar(*right)) {
+                        context_.consume_memory(l->size() + r->size());
+                        std::string buffer {};
+                        buffer.reserve(l->size() + r->size());
+                        buffer.append(*l);
+                        buffer.append(*r);
+                        return create_immediate(
+                                context_.values().get(tvalue::character { std::move(buffer) }),
+                                context_.types().get(ttype::character { ttype::varying }));
+                    }
+                }
+                break;
+            case kind::conditional_and:
+                if (auto l = as_boolean(*left)) {
+                    if (auto r = as_boolean(*right)) {
+                        return create_boolean(*l && *r);
+                    }
+                }
+                break;
+            case kind::conditional_or:
+                if (auto l = as_boolean(*left)) {
+                    if (auto r = as_boolean(*right)) {
+                        return create_boolean(*l || *r);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        return {};
+    }
+
+    template<class T>
+    [[nodiscard]] static std::optional<T> compute_integer(tscalar::binary_operator operator_kind, T left, T right) {
+        T result {};
+        using kind = tscalar::binary_operator;
+        switch (operator_kind) {
+            case kind::add:
+                if (__builtin_add_overflow(left, right, &result)) {
+                    return {};
+                }
+                return result;
+            case kind::subtract:
+                if (__builtin_sub_overflow(left, right, &result)) {
+                    return {};
+                }
+                return result;
+            case kind::multiply:
+                if (__builtin_mul_overflow(left, right, &result)) {
+                    return {};
+                }
+                return result;
+            case kind::divide:
+                if (right == 0 || (left == std::numeric_limits<T>::min() && right == -1)) {
+                    return {};
+                }
+                return static_cast<T>(left / right);
+            case kind::remainder:
+                if (right == 0 || (left == std::numeric_limits<T>::min() && right == -1)) {
+                    return {};
+                }
+                return static_cast<T>(left % right);
+            default:
+                break;
+        }
+        return {};
+    }
+
+    [[nodiscard]] static std::optional<double> compute_float(tscalar::binary_operator operator_kind, double left, double right) {
+        using kind = tscalar::binary_operator;
+        switch (operator_kind) {
+            case kind::add: return left + right;
+            case kind::subtract: return left - right;
+            case kind::multiply: return left * right;
+            case kind::divide:
+                if (right == 0) {
+                    return {};
+                }
+                return left / right;
+            default:
+                break;
+        }
+        return {};
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> fold_arithmetic(
+            tscalar::binary_operator operator_kind,
+            tscalar::immediate const& left,
+            tscalar::immediate const& right) {
+        // NOTE: only folds operations between the same types, to avoid re-implementing type promotion rules
+        if (auto l = as_int4(left)) {
+            if (auto r = as_int4(right)) {
+                if (auto v = compute_integer<std::int32_t>(operator_kind, *l, *r)) {
+                    return create_int4(*v);
+                }
+            }
+            return {};
+        }
+        if (auto l = as_int8(left)) {
+            if (auto r = as_int8(right)) {
+                if (auto v = compute_integer<std::int64_t>(operator_kind, *l, *r)) {
+                    return create_int8(*v);
+                }
+            }
+            return {};
+        }
+        if (auto l = as_float8(left)) {
+            if (auto r = as_float8(right)) {
+                if (auto v = compute_float(operator_kind, *l, *r)) {
+                    return create_float8(*v);
+                }
+            }
+            return {};
+        }
+        return {};
+    }
+
+    template<class T>
+    [[nodiscard]] static bool compare(tscalar::comparison_operator operator_kind, T const& left, T const& right) {
+        using kind = tscalar::comparison_operator;
+        switch (operator_kind) {
+            case kind::equal: return left == right;
+            case kind::not_equal: return left != right;
+            case kind::less: return left < right;
+            case kind::less_equal: return left <= right;
+            case kind::greater: return left > right;
+            case kind::greater_equal: return left >= right;
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> fold_compare(tscalar::compare const& expression) {
+        auto left = as_immediate(expression.left());
+        auto right = as_immediate(expression.right());
+        if (!left || !right) {
+            return {};
+        }
+        if (auto l = as_int4(*left)) {
+            if (auto r = as_int4(*right)) {
+                return create_boolean(compare(expression.operator_kind(), *l, *r));
+            }
+            return {};
+        }
+        if (auto l = as_int8(*left)) {
+            if (auto r = as_int8(*right)) {
+                return create_boolean(compare(expression.operator_kind(), *l, *r));
+            }
+            return {};
+        }
+        if (auto l = as_boolean(*left)) {
+            if (auto r = as_boolean(*right)) {
+                return create_boolean(compare(expression.operator_kind(), *l, *r));
+            }
+            return {};
+        }
+        return {};
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> fold_cast(tscalar::cast const& expression) {
+        auto operand = as_immediate(expression.operand());
+        if (!operand) {
+            return {};
+        }
+        auto&& target = expression.type();
+        if (operand->type() == target) {
+            return create_immediate(
+                    context_.values().get(operand->value()),
+                    context_.types().get(target));
+        }
+        switch (target.kind()) {
+            case ttype::type_kind::int1:
+                return cast_integer<std::int8_t, tvalue::int4>(*operand, target);
+            case ttype::type_kind::int2:
+                return cast_integer<std::int16_t, tvalue::int4>(*operand, target);
+            case ttype::type_kind::int4:
+                return cast_integer<std::int32_t, tvalue::int4>(*operand, target);
+            case ttype::type_kind::int8:
+                return cast_integer<std::int64_t, tvalue::int8>(*operand, target);
+            case ttype::type_kind::date:
+                return cast_date(*operand, target);
+            default:
+                break;
+        }
+        return {};
+    }
+
+    template<class T, class V>
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> cast_integer(
+            tscalar::immediate const& operand,
+            ttype::data const& target) {
+        auto value = as_integer(operand);
+        // NOTE: out of range values are reported at run-time, following the loss policy
+        if (!value || *value < std::numeric_limits<T>::min() || *value > std::numeric_limits<T>::max()) {
+            return {};
+        }
+        return create_immediate(
+                context_.values().get(V { static_cast<typename V::entity_type>(*value) }),
+                context_.types().get(target));
+    }
+
+    [[nodiscard]] std::unique_ptr<tscalar::immediate> cast_date(
+            tscalar::immediate const& operand,
+            ttype::data const& target) {
+        if (operand.type().kind() != ttype::type_kind::character
+                || operand.value().kind() != tvalue::value_kind::character) {
+            return {};
+        }
+        auto contents = unsafe_downcast<tvalue::character>(operand.value()).get();
+        auto result = ::takatori::datetime::parse_date(contents);
+        if (!result) {
+            // NOTE: keep the cast operation to raise the error at run-time
+            return {};
+        }
+        auto&& info = result.value();
+        return create_immediate(
+                context_.values().get(tvalue::date { ::takatori::datetime::date {
+                        static_cast<std::int32_t>(info.year),
+                        static_cast<std::uint32_t>(info.month),
+                        static_cast<std::uint32_t>(info.day),
+                } }),
+                context_.types().get(target));
+    }
+};
+
+} // namespace
+
+std::unique_ptr<tscalar::expression> fold_constant(
+        analyzer_context& context,
+        std::unique_ptr<tscalar::expression> expression) {
+    if (!expression) {
+        return expression;
+    }
+    engine e { context };
+    return e.process(std::move(expression));
+}
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+#include <takatori/scalar/expression.h>
+
+#include <mizugaki/analyzer/details/analyzer_context.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief folds the given scalar expression into an immediate value if all of its operands are immediate values.
+ * @details This only folds the top level operation, so that callers must apply this to each sub-expression
+ *      from leaves to root.
+ *      If evaluating the operation may raise an error (e.g. overflow or division by zero),
+ *      this leaves the expression as is, to keep the error semantics at run-time.
+ * @param context the current analyzer context
+ * @param expression the target expression
+ * @return the folded immediate expression
+ * @return the original expression if it cannot be folded
+ */
+[[nodiscard]] std::unique_ptr<::takatori::scalar::expression> fold_constant(
+        analyzer_context& context,
+        std::unique_ptr<::takatori::scalar::expression> expression);
+
+} // namespace mizugaki::analyzer::details
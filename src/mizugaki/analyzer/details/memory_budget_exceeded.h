@@ -0,0 +1,20 @@
+#pragma once
+
+#include <new>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief an exception which aborts the current analysis because it exceeds its memory budget.
+ * @details This is only thrown in the analyzer, and sql_analyzer reports it as
+ *      sql_analyzer_code::memory_budget_exceeded.
+ * @see sql_analyzer_options::memory_budget()
+ */
+class memory_budget_exceeded : public std::bad_alloc {
+public:
+    [[nodiscard]] char const* what() const noexcept override {
+        return "analysis exceeds its memory budget";
+    }
+};
+
+} // namespace mizugaki::analyzer::details
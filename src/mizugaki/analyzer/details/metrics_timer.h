@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief measures elapsed time of an analysis phase while this object is alive.
+ * @details This does nothing if it was created by the default constructor.
+ *      If the same phase is re-entered, only the outermost timer adds the elapsed time.
+ */
+class metrics_timer {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration_type = std::chrono::nanoseconds;
+
+    metrics_timer() = default;
+
+    metrics_timer(duration_type& target, std::size_t& depth) noexcept :
+        target_ { depth == 0 ? &target : nullptr },
+        depth_ { &depth }
+    {
+        ++depth;
+        if (target_ != nullptr) {
+            started_ = clock::now();
+        }
+    }
+
+    ~metrics_timer() {
+        if (depth_ != nullptr) {
+            --*depth_;
+        }
+        if (target_ != nullptr) {
+            *target_ += clock::now() - started_;
+        }
+    }
+
+    metrics_timer(metrics_timer const&) = delete;
+    metrics_timer& operator=(metrics_timer const&) = delete;
+    metrics_timer(metrics_timer&&) = delete;
+    metrics_timer& operator=(metrics_timer&&) = delete;
+
+private:
+    duration_type* target_ {};
+    std::size_t* depth_ {};
+    clock::time_point started_ {};
+};
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,64 @@
+#include <mizugaki/analyzer/details/overload_cache.h>
+
+#include <mizugaki/ast/name/simple.h>
+
+namespace mizugaki::analyzer::details {
+
+using ::takatori::util::optional_ptr;
+
+optional_ptr<overload_cache::entry_type const> overload_cache::find(
+        ast::name::name const& name,
+        type_list const& argument_types) {
+    if (entries_.empty()) {
+        return {};
+    }
+    build_key(name, argument_types);
+    auto iter = entries_.find(key_buffer_);
+    if (iter == entries_.end()) {
+        return {};
+    }
+    // double check the argument types, in case of the key collision
+    auto&& cached_types = iter->second.argument_types;
+    if (cached_types.size() != argument_types.size()) {
+        return {};
+    }
+    for (std::size_t i = 0; i < cached_types.size(); ++i) {
+        if (cached_types[i].get() != argument_types[i].get()) {
+            return {};
+        }
+    }
+    ++hits_;
+    return iter->second.entry;
+}
+
+void overload_cache::add(ast::name::name const& name, type_list const& argument_types, entry_type entry) {
+    build_key(name, argument_types);
+    entries_.insert_or_assign(key_buffer_, element { argument_types, std::move(entry) });
+}
+
+void overload_cache::clear() noexcept {
+    entries_.clear();
+    hits_ = 0;
+}
+
+void overload_cache::build_key(ast::name::name const& name, type_list const& argument_types) {
+    key_buffer_.clear();
+    // the number of arguments, and their type identities
+    auto count = argument_types.size();
+    key_buffer_.append(reinterpret_cast<char const*>(&count), sizeof(count)); // NOLINT(*-reinterpret-cast)
+    for (auto&& type : argument_types) {
+        auto const* address = type.get();
+        key_buffer_.append(reinterpret_cast<char const*>(&address), sizeof(address)); // NOLINT(*-reinterpret-cast)
+    }
+    // name segments, from the last to the first
+    for (optional_ptr<ast::name::name const> current { name }; current; current = current->optional_qualifier()) {
+        auto&& segment = current->last_name();
+        auto&& identifier = segment.identifier();
+        auto size = identifier.size();
+        key_buffer_.push_back(segment.identifier_kind() == ast::name::identifier_kind::regular ? 'r' : 'd');
+        key_buffer_.append(reinterpret_cast<char const*>(&size), sizeof(size)); // NOLINT(*-reinterpret-cast)
+        key_buffer_.append(identifier);
+    }
+}
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <tsl/hopscotch_map.h>
+
+#include <takatori/type/data.h>
+
+#include <takatori/util/optional_ptr.h>
+
+#include <yugawara/function/declaration.h>
+#include <yugawara/aggregate/declaration.h>
+
+#include <mizugaki/ast/name/name.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief memorizes the results of function overload resolution.
+ * @details Each entry is keyed on the function name as written, and the identities of its argument types.
+ *      Different spellings of the same function, or equivalent but distinct type objects only miss the cache.
+ */
+class overload_cache {
+public:
+    using type_list = std::vector<std::shared_ptr<::takatori::type::data const>>;
+    using function_type = std::shared_ptr<::yugawara::function::declaration const>;
+    using aggregate_type = std::shared_ptr<::yugawara::aggregate::declaration const>;
+    using entry_type = std::variant<function_type, aggregate_type>;
+
+    [[nodiscard]] ::takatori::util::optional_ptr<entry_type const> find(
+            ast::name::name const& name,
+            type_list const& argument_types);
+
+    void add(ast::name::name const& name, type_list const& argument_types, entry_type entry);
+
+    void clear() noexcept;
+
+    // the number of successful find() since the last clear()
+    [[nodiscard]] std::size_t hits() const noexcept {
+        return hits_;
+    }
+
+private:
+    struct element {
+        // NOTE: keep the argument types alive, because the key refers their addresses
+        type_list argument_types;
+        entry_type entry;
+    };
+
+    ::tsl::hopscotch_map<std::string, element, std::hash<std::string_view>, std::equal_to<>> entries_ {};
+    std::string key_buffer_ {};
+    std::size_t hits_ {};
+
+    void build_key(ast::name::name const& name, type_list const& argument_types);
+};
+
+} // namespace mizugaki::analyzer::details
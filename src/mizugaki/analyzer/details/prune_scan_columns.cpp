@@ -0,0 +1,329 @@
+#include <mizugaki/analyzer/details/prune_scan_columns.h>
+
+#include <algorithm>
+
+#include <tsl/hopscotch_set.h>
+
+#include <takatori/descriptor/variable.h>
+
+#include <takatori/scalar/dispatch.h>
+
+#include <takatori/relation/scan.h>
+#include <takatori/relation/values.h>
+#include <takatori/relation/filter.h>
+#include <takatori/relation/project.h>
+#include <takatori/relation/emit.h>
+#include <takatori/relation/write.h>
+#include <takatori/relation/intermediate/join.h>
+#include <takatori/relation/intermediate/aggregate.h>
+#include <takatori/relation/intermediate/distinct.h>
+#include <takatori/relation/intermediate/limit.h>
+#include <takatori/relation/intermediate/union.h>
+
+#include <takatori/util/downcast.h>
+
+#include <yugawara/extension/relation/subquery.h>
+
+#include <yugawara/extension/scalar/subquery.h>
+#include <yugawara/extension/scalar/exists.h>
+#include <yugawara/extension/scalar/quantified_compare.h>
+
+namespace mizugaki::analyzer::details {
+
+namespace tdescriptor = ::takatori::descriptor;
+namespace tscalar = ::takatori::scalar;
+namespace trelation = ::takatori::relation;
+
+using ::takatori::util::unsafe_downcast;
+
+namespace {
+
+class engine {
+public:
+    [[nodiscard]] bool collect(trelation::graph_type const& graph) {
+        for (auto&& op : graph) {
+            if (!collect(op)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool used(tdescriptor::variable const& variable) const {
+        return used_.find(variable) != used_.end();
+    }
+
+    // relation operators
+
+    [[nodiscard]] bool collect(trelation::expression const& expr) {
+        switch (expr.kind()) {
+            case trelation::scan::tag:
+                return collect(unsafe_downcast<trelation::scan>(expr));
+            case trelation::values::tag:
+                return collect(unsafe_downcast<trelation::values>(expr));
+            case trelation::filter::tag:
+                return collect_scalar(unsafe_downcast<trelation::filter>(expr).condition());
+            case trelation::project::tag:
+                return collect(unsafe_downcast<trelation::project>(expr));
+            case trelation::emit::tag:
+                return collect(unsafe_downcast<trelation::emit>(expr));
+            case trelation::write::tag:
+                return collect(unsafe_downcast<trelation::write>(expr));
+            case trelation::intermediate::join::tag:
+                return collect(unsafe_downcast<trelation::intermediate::join>(expr));
+            case trelation::intermediate::aggregate::tag:
+                return collect(unsafe_downcast<trelation::intermediate::aggregate>(expr));
+            case trelation::intermediate::distinct::tag:
+                return collect(unsafe_downcast<trelation::intermediate::distinct>(expr));
+            case trelation::intermediate::limit::tag:
+                return collect(unsafe_downcast<trelation::intermediate::limit>(expr));
+            case trelation::intermediate::union_::tag:
+                return collect(unsafe_downcast<trelation::intermediate::union_>(expr));
+            case trelation::extension::tag:
+                // NOTE: sub-queries in FROM clause never refer the outer relations
+                return unsafe_downcast<trelation::extension>(expr).extension_id()
+                        == ::yugawara::extension::relation::subquery::extension_tag;
+            default:
+                // we don't know which variables are referred from the operator
+                return false;
+        }
+    }
+
+    [[nodiscard]] bool collect(trelation::scan const& expr) {
+        return collect(expr.lower()) && collect(expr.upper());
+    }
+
+    [[nodiscard]] bool collect(trelation::values const& expr) {
+        for (auto&& row : expr.rows()) {
+            for (auto&& element : row.elements()) {
+                if (!collect_scalar(element)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::project const& expr) {
+        for (auto&& column : expr.columns()) {
+            if (!collect_scalar(column.value())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::emit const& expr) {
+        for (auto&& column : expr.columns()) {
+            use(column.source());
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::write const& expr) {
+        for (auto&& key : expr.keys()) {
+            use(key.source());
+        }
+        for (auto&& column : expr.columns()) {
+            use(column.source());
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::intermediate::join const& expr) {
+        if (auto condition = expr.condition()) {
+            if (!collect_scalar(*condition)) {
+                return false;
+            }
+        }
+        return collect(expr.lower()) && collect(expr.upper());
+    }
+
+    [[nodiscard]] bool collect(trelation::intermediate::aggregate const& expr) {
+        for (auto&& key : expr.group_keys()) {
+            use(key);
+        }
+        for (auto&& column : expr.columns()) {
+            for (auto&& argument : column.arguments()) {
+                use(argument);
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::intermediate::distinct const& expr) {
+        for (auto&& key : expr.group_keys()) {
+            use(key);
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::intermediate::limit const& expr) {
+        for (auto&& key : expr.group_keys()) {
+            use(key);
+        }
+        for (auto&& key : expr.sort_keys()) {
+            use(key.variable());
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::intermediate::union_ const& expr) {
+        for (auto&& mapping : expr.mappings()) {
+            if (auto&& left = mapping.left()) {
+                use(*left);
+            }
+            if (auto&& right = mapping.right()) {
+                use(*right);
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool collect(trelation::endpoint const& endpoint) {
+        for (auto&& key : endpoint.keys()) {
+            if (!collect_scalar(key.value())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // scalar expressions
+
+    [[nodiscard]] bool collect_scalar(tscalar::expression const& expr) {
+        return tscalar::dispatch(*this, expr);
+    }
+
+    [[nodiscard]] bool operator()(tscalar::expression const&) noexcept {
+        return false;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::immediate const&) noexcept {
+        return true;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::variable_reference const& expr) {
+        use(expr.variable());
+        return true;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::cast const& expr) {
+        return collect_scalar(expr.operand());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::unary const& expr) {
+        return collect_scalar(expr.operand());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::binary const& expr) {
+        return collect_scalar(expr.left()) && collect_scalar(expr.right());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::compare const& expr) {
+        return collect_scalar(expr.left()) && collect_scalar(expr.right());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::match const& expr) {
+        return collect_scalar(expr.input())
+                && collect_scalar(expr.pattern())
+                && collect_scalar(expr.escape());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::conditional const& expr) {
+        for (auto&& element : expr.alternatives()) {
+            if (!collect_scalar(element.condition()) || !collect_scalar(element.body())) {
+                return false;
+            }
+        }
+        if (auto&& default_expression = expr.default_expression()) {
+            return collect_scalar(*default_expression);
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::coalesce const& expr) {
+        for (auto&& element : expr.alternatives()) {
+            if (!collect_scalar(element)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::let const& expr) {
+        for (auto&& element : expr.variables()) {
+            if (!collect_scalar(element.value())) {
+                return false;
+            }
+        }
+        return collect_scalar(expr.body());
+    }
+
+    [[nodiscard]] bool operator()(tscalar::function_call const& expr) {
+        for (auto&& argument : expr.arguments()) {
+            if (!collect_scalar(argument)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool operator()(tscalar::extension const& expr) {
+        // NOTE: sub-queries only refer the outer relations via their parameters
+        using namespace ::yugawara::extension::scalar;
+        switch (expr.extension_id()) {
+            case subquery::extension_tag:
+                return collect_parameters(unsafe_downcast<subquery>(expr));
+            case exists::extension_tag:
+                return collect_parameters(unsafe_downcast<exists>(expr));
+            case quantified_compare::extension_tag: {
+                auto&& compare = unsafe_downcast<quantified_compare>(expr);
+                return collect_scalar(compare.left()) && collect_parameters(compare);
+            }
+            default:
+                return false;
+        }
+    }
+
+private:
+    ::tsl::hopscotch_set<tdescriptor::variable> used_ {};
+
+    void use(tdescriptor::variable const& variable) {
+        used_.insert(variable);
+    }
+
+    template<class T>
+    [[nodiscard]] bool collect_parameters(T const& expr) {
+        for (auto&& parameter : expr.parameters()) {
+            use(parameter.source());
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool prune_scan_columns(trelation::graph_type& graph) {
+    engine e {};
+    if (!e.collect(graph)) {
+        return false;
+    }
+    for (auto&& op : graph) {
+        if (op.kind() != trelation::scan::tag) {
+            continue;
+        }
+        auto&& columns = unsafe_downcast<trelation::scan>(op).columns();
+        columns.erase(
+                std::remove_if(
+                        columns.begin(),
+                        columns.end(),
+                        [&](trelation::scan::column const& column) {
+                            return !e.used(column.destination());
+                        }),
+                columns.end());
+    }
+    return true;
+}
+
+} // namespace mizugaki::analyzer::details
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <takatori/relation/graph.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief removes the columns of table scans which are never referenced in the given graph.
+ * @details This only prunes the scan operators in the top level graph,
+ *      and leaves the graph as is if it contains operators or expressions whose variable references
+ *      are not traceable here.
+ * @param graph the target graph, must be complete
+ * @return true if this pruned the scan columns
+ * @return false if the graph was left as is
+ */
+bool prune_scan_columns(::takatori::relation::graph_type& graph);
+
+} // namespace mizugaki::analyzer::details
@@ -78,6 +78,14 @@ column_info& relation_info::add(column_info info) {
     return build_internal(position);
 }
 
+std::size_t relation_info::memory_usage() const noexcept {
+    return sizeof(relation_info)
+            + identifier_.capacity()
+            + columns_.capacity() * sizeof(column_info)
+            + name_map_.bucket_count() * (sizeof(std::string) + sizeof(position_type))
+            + declaration_map_.bucket_count() * (sizeof(::yugawara::storage::column const*) + sizeof(position_type));
+}
+
 void relation_info::erase(position_type first, position_type last) {
     if (first >= last) {
         return;
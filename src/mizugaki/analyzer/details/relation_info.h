@@ -55,6 +55,12 @@ public:
 
     void rebuild();
 
+    /**
+     * @brief returns the estimated memory usage of this relation.
+     * @return the estimated number of bytes, including the column list and its lookup tables
+     */
+    [[nodiscard]] std::size_t memory_usage() const noexcept;
+
     [[nodiscard]] ::takatori::util::optional_ptr<column_info> next(column_info const& column);
     [[nodiscard]] ::takatori::util::optional_ptr<column_info const> next(column_info const& column) const;
 
@@ -0,0 +1,98 @@
+#include <mizugaki/analyzer/details/scalar_expression_hash.h>
+
+#include <takatori/descriptor/variable.h>
+
+#include <takatori/scalar/dispatch.h>
+
+namespace mizugaki::analyzer::details {
+
+namespace tscalar = ::takatori::scalar;
+
+namespace {
+
+class engine {
+public:
+    [[nodiscard]] std::size_t process(tscalar::expression const& expr) const noexcept {
+        return combine(static_cast<std::size_t>(expr.kind()), tscalar::dispatch(*this, expr));
+    }
+
+    // NOTE: other expressions only contribute their kind, and leave the rest to the equality check
+    [[nodiscard]] std::size_t operator()(tscalar::expression const&) const noexcept {
+        return 0;
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::variable_reference const& expr) const noexcept {
+        return std::hash<::takatori::descriptor::variable> {}(expr.variable());
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::unary const& expr) const noexcept {
+        return combine(static_cast<std::size_t>(expr.operator_kind()), process(expr.operand()));
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::cast const& expr) const noexcept {
+        return process(expr.operand());
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::binary const& expr) const noexcept {
+        return combine(
+                static_cast<std::size_t>(expr.operator_kind()),
+                combine(process(expr.left()), process(expr.right())));
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::compare const& expr) const noexcept {
+        return combine(
+                static_cast<std::size_t>(expr.operator_kind()),
+                combine(process(expr.left()), process(expr.right())));
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::match const& expr) const noexcept {
+        return combine(
+                static_cast<std::size_t>(expr.operator_kind()),
+                combine(process(expr.input()), process(expr.pattern())));
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::conditional const& expr) const noexcept {
+        std::size_t result = expr.alternatives().size();
+        for (auto&& element : expr.alternatives()) {
+            result = combine(result, combine(process(element.condition()), process(element.body())));
+        }
+        if (auto&& default_expression = expr.default_expression()) {
+            result = combine(result, process(*default_expression));
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::coalesce const& expr) const noexcept {
+        std::size_t result = expr.alternatives().size();
+        for (auto&& element : expr.alternatives()) {
+            result = combine(result, process(element));
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::size_t operator()(tscalar::function_call const& expr) const noexcept {
+        std::size_t result = expr.arguments().size();
+        for (auto&& element : expr.arguments()) {
+            result = combine(result, process(element));
+        }
+        return result;
+    }
+
+private:
+    [[nodiscard]] static constexpr std::size_t combine(std::size_t a, std::size_t b) noexcept {
+        return a * 31 + b;
+    }
+};
+
+} // namespace
+
+std::size_t scalar_expression_hash::operator()(tscalar::expression const& expression) const noexcept {
+    engine e {};
+    return e.process(expression);
+}
+
+bool scalar_expression_equal::operator()(tscalar::expression const& a, tscalar::expression const& b) const noexcept {
+    return a == b;
+}
+
+} // namespace mizugaki::analyzer::details
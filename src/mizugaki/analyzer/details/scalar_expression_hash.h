@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <takatori/scalar/expression.h>
+
+namespace mizugaki::analyzer::details {
+
+/**
+ * @brief computes structural hash code of analyzed scalar expressions.
+ * @details The hash code does not depend on the regions of the individual expressions,
+ *      so that it is consistent with `operator==` of ::takatori::scalar::expression.
+ */
+struct scalar_expression_hash {
+    /**
+     * @brief returns the structural hash code of the given expression.
+     * @param expression the target expression
+     * @return the hash code
+     */
+    [[nodiscard]] std::size_t operator()(::takatori::scalar::expression const& expression) const noexcept;
+};
+
+/**
+ * @brief compares analyzed scalar expressions structurally.
+ * @details This ignores the regions of the individual expressions.
+ */
+struct scalar_expression_equal {
+    /**
+     * @brief returns whether or not the two expressions are structurally equivalent.
+     * @param a the first expression
+     * @param b the second expression
+     * @return true if they are equivalent
+     * @return false otherwise
+     */
+    [[nodiscard]] bool operator()(
+            ::takatori::scalar::expression const& a,
+            ::takatori::scalar::expression const& b) const noexcept;
+};
+
+} // namespace mizugaki::analyzer::details
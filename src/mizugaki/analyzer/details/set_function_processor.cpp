@@ -368,17 +368,19 @@ void set_function_processor::consume(ownership_reference<tscalar::expression> ex
         arguments.emplace_back(std::move(replacement));
     }
 
+    auto region = invocation.region();
     auto existing = find_aggregation(invocation.function(), arguments);
     if (existing) {
-        expression.set(std::make_unique<tscalar::variable_reference>(*existing));
+        expression.set(context_.create<tscalar::variable_reference>(region, *existing));
     } else {
         // FIXME: add debug string
         auto replacement = ::yugawara::binding::factory {}.stream_variable();
+        context_.consume_elements<::takatori::relation::intermediate::aggregate::column>(1);
         aggregations_store().columns().emplace_back(
                 std::move(invocation.function()),
                 std::move(arguments),
                 replacement);
-        expression.set(std::make_unique<tscalar::variable_reference>(replacement));
+        expression.set(context_.create<tscalar::variable_reference>(region, replacement));
         aggregated_columns_.insert(std::move(replacement));
     }
 }
@@ -386,7 +388,7 @@ void set_function_processor::consume(ownership_reference<tscalar::expression> ex
 ::takatori::relation::project& set_function_processor::arguments_store() {
     if (!arguments_) {
         using ::takatori::relation::project;
-        arguments_ = graph_.emplace<project>(std::vector<project::column> {});
+        arguments_ = context_.emplace<project>(graph_, std::vector<project::column> {});
     }
     return *arguments_;
 }
@@ -394,7 +396,8 @@ void set_function_processor::consume(ownership_reference<tscalar::expression> ex
 ::takatori::relation::intermediate::aggregate &set_function_processor::aggregations_store() {
     if (!aggregations_) {
         using ::takatori::relation::intermediate::aggregate;
-        aggregations_ = graph_.emplace<aggregate>(
+        aggregations_ = context_.emplace<aggregate>(
+                graph_,
                 std::vector<tdescriptor::variable> {},
                 std::vector<aggregate::column> {});
     }
@@ -406,8 +409,9 @@ tdescriptor::variable set_function_processor::replace_argument(ownership_referen
     // FIXME: add debug string
     auto replacement = ::yugawara::binding::factory {}.stream_variable();
     auto&& origin = expression.exchange(
-            std::make_unique<tscalar::variable_reference>(replacement));
+            context_.create<tscalar::variable_reference>(expression.get().region(), replacement));
     replacement.region() = origin->region();
+    context_.consume_elements<::takatori::relation::project::column>(1);
     arguments_store().columns().emplace_back(std::move(origin), replacement);
     return replacement;
 }
@@ -48,4 +48,31 @@ sql_analyzer::result_type sql_analyzer::operator()(
             host_parameters);
 }
 
+sql_analyzer::prepared_statement_type sql_analyzer::prepare(
+        options_type const& options,
+        ast::statement::statement const& statement,
+        ast::compilation_unit const& source,
+        ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters) {
+    return prepare(
+            options,
+            statement,
+            optional_ptr { source.document().get() },
+            sequence_view { source.comments() },
+            host_parameters);
+}
+
+sql_analyzer::prepared_statement_type sql_analyzer::prepare(
+        options_type const& options,
+        ast::statement::statement const& statement,
+        optional_ptr<::takatori::document::document const> source,
+        sequence_view<ast::node_region const> comments,
+        ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters) {
+    return impl_->prepare(
+            options,
+            statement,
+            std::move(source),
+            comments,
+            host_parameters);
+}
+
 } // namespace mizugaki::analyzer
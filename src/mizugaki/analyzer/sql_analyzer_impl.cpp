@@ -1,6 +1,14 @@
 #include <mizugaki/analyzer/sql_analyzer_impl.h>
 
+#include <chrono>
+
+#include <takatori/util/string_builder.h>
+
+#include <mizugaki/parser/sql_fingerprint.h>
+
+#include <mizugaki/analyzer/details/analysis_cancelled.h>
 #include <mizugaki/analyzer/details/analyze_statement.h>
+#include <mizugaki/analyzer/details/memory_budget_exceeded.h>
 
 namespace mizugaki::analyzer {
 
@@ -8,6 +16,7 @@ using impl = sql_analyzer::impl;
 
 using ::takatori::util::optional_ptr;
 using ::takatori::util::sequence_view;
+using ::takatori::util::string_builder;
 
 impl::result_type impl::process(
         options_type const& options,
@@ -16,9 +25,109 @@ impl::result_type impl::process(
         sequence_view<ast::node_region const> comments,
         placeholder_map const& placeholders,
         ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters) {
-    using namespace details;
     auto finalizer = context_.initialize(options, source, comments, placeholders, host_parameters);
-    auto result = analyze_statement(context_, statement);
+    return analyze(statement);
+}
+
+impl::prepared_statement_type impl::prepare(
+        options_type const& options,
+        ast::statement::statement const& statement,
+        optional_ptr<::takatori::document::document const> source,
+        sequence_view<ast::node_region const> comments,
+        ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters) {
+    // NOTE: never resolve host parameters as immediate values
+    placeholder_map const placeholders {};
+    auto finalizer = context_.initialize(options, source, comments, placeholders, host_parameters);
+    auto result = analyze(statement);
+    if (!result) {
+        return { std::move(result), {} };
+    }
+    return {
+            std::move(result),
+            context_.host_parameter_references(),
+    };
+}
+
+impl::result_type impl::analyze(ast::statement::statement const& statement) {
+    auto&& statistics = context_.options()->statistics();
+    if (!context_.metrics() && !statistics) {
+        return build_result(statement);
+    }
+    using clock = std::chrono::steady_clock;
+    auto started = clock::now();
+    auto result = build_result(statement);
+    auto elapsed = clock::now() - started;
+    std::size_t diagnostic_count {};
+    if (result.kind() == sql_analyzer_result_kind::diagnostics) {
+        diagnostic_count = result.element<sql_analyzer_result_kind::diagnostics>().size();
+    } else {
+        diagnostic_count = context_.diagnostics().size();
+    }
+    if (statistics) {
+        record(*statistics, statement, elapsed, diagnostic_count);
+    }
+    if (!context_.metrics()) {
+        return result;
+    }
+    auto&& metrics = *context_.metrics();
+    metrics.total_time() = elapsed;
+    if (result.kind() == sql_analyzer_result_kind::execution_plan) {
+        metrics.relation_count() = result.element<sql_analyzer_result_kind::execution_plan>().size();
+    }
+    metrics.diagnostic_count() = diagnostic_count;
+    metrics.memory_usage() = context_.memory_usage();
+    result.metrics() = std::move(context_.metrics());
+    return result;
+}
+
+void impl::record(
+        statement_statistics& statistics,
+        ast::statement::statement const& statement,
+        std::chrono::steady_clock::duration elapsed,
+        std::size_t diagnostic_count) {
+    auto source = context_.source();
+    auto region = statement.region();
+    if (!source || !region) {
+        return;
+    }
+    if (!fingerprint_stream_) {
+        fingerprint_stream_ = std::make_unique<parser::sql_token_stream>();
+    }
+    fingerprint_stream_->reset(::takatori::util::maybe_shared_ptr { source.get() }, region);
+    auto fingerprint = parser::compute_sql_fingerprint(*fingerprint_stream_);
+    fingerprint_stream_->reset({});
+
+    statistics.record_analysis(
+            fingerprint,
+            source->contents(region.first(), region.size()),
+            std::chrono::duration_cast<statement_statistics::duration_type>(elapsed),
+            diagnostic_count);
+}
+
+impl::result_type impl::build_result(ast::statement::statement const& statement) {
+    using namespace details;
+    analyze_statement_result_type result {};
+    try {
+        result = analyze_statement(context_, statement);
+    } catch (memory_budget_exceeded const& e) {
+        context_.report(
+                sql_analyzer_code::memory_budget_exceeded,
+                string_builder {}
+                        << e.what() << ": "
+                        << "estimated " << context_.memory_usage() << " bytes, "
+                        << "budget " << context_.options()->memory_budget() << " bytes"
+                        << string_builder::to_string,
+                statement.region());
+        return std::move(context_.diagnostics());
+    } catch (analysis_cancelled const& e) {
+        context_.report(
+                e.status() == cancellation_status::deadline_exceeded
+                        ? sql_analyzer_code::deadline_exceeded
+                        : sql_analyzer_code::cancelled,
+                e.what(),
+                statement.region());
+        return std::move(context_.diagnostics());
+    }
     if (std::holds_alternative<erroneous_result_type>(result)) {
         return std::move(context_.diagnostics());
     }
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+
 #include <takatori/type/data.h>
 #include <takatori/value/data.h>
 
 #include <yugawara/util/object_repository.h>
 
 #include <mizugaki/placeholder_map.h>
+#include <mizugaki/statement_statistics.h>
+#include <mizugaki/parser/sql_token_stream.h>
 #include <mizugaki/analyzer/sql_analyzer.h>
 #include <mizugaki/analyzer/details/analyzer_context.h>
 
@@ -15,6 +20,7 @@ class sql_analyzer::impl {
 public:
     using options_type = sql_analyzer::options_type;
     using result_type = sql_analyzer::result_type;
+    using prepared_statement_type = sql_analyzer::prepared_statement_type;
     using context_type = details::analyzer_context;
 
     [[nodiscard]] result_type process(
@@ -25,8 +31,25 @@ public:
             placeholder_map const& placeholders,
             ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters);
 
+    [[nodiscard]] prepared_statement_type prepare(
+            options_type const& options,
+            ast::statement::statement const& statement,
+            ::takatori::util::optional_ptr<::takatori::document::document const> source,
+            ::takatori::util::sequence_view<ast::node_region const> comments,
+            ::takatori::util::optional_ptr<::yugawara::variable::provider const> host_parameters);
+
 private:
     context_type context_;
+    std::unique_ptr<parser::sql_token_stream> fingerprint_stream_ {};
+
+    [[nodiscard]] result_type analyze(ast::statement::statement const& statement);
+    [[nodiscard]] result_type build_result(ast::statement::statement const& statement);
+
+    void record(
+            statement_statistics& statistics,
+            ast::statement::statement const& statement,
+            std::chrono::steady_clock::duration elapsed,
+            std::size_t diagnostic_count);
 };
 
 } // namespace mizugaki::analyzer
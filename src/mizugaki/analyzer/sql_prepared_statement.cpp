@@ -0,0 +1,112 @@
+#include <mizugaki/analyzer/sql_prepared_statement.h>
+
+#include <takatori/document/region.h>
+
+#include <takatori/util/string_builder.h>
+
+namespace mizugaki::analyzer {
+
+using ::takatori::util::sequence_view;
+using ::takatori::util::string_builder;
+
+sql_prepared_statement::binding::binding(std::vector<value_type> values) noexcept
+    : values_(std::move(values))
+{}
+
+sql_prepared_statement::binding::binding(std::vector<diagnostic_type> diagnostics) noexcept
+    : diagnostics_(std::move(diagnostics))
+{}
+
+bool sql_prepared_statement::binding::is_valid() const noexcept {
+    return values_.has_value();
+}
+
+sql_prepared_statement::binding::operator bool() const noexcept {
+    return is_valid();
+}
+
+sequence_view<sql_prepared_statement::value_type const> sql_prepared_statement::binding::values() const noexcept {
+    if (values_) {
+        return *values_;
+    }
+    return {};
+}
+
+sequence_view<sql_prepared_statement::diagnostic_type const>
+sql_prepared_statement::binding::diagnostics() const noexcept {
+    return diagnostics_;
+}
+
+sql_prepared_statement::sql_prepared_statement(result_type result, std::vector<parameter_type> parameters) noexcept
+    : result_(std::move(result))
+    , parameters_(std::move(parameters))
+{}
+
+bool sql_prepared_statement::is_valid() const noexcept {
+    return result_.is_valid();
+}
+
+sql_prepared_statement::operator bool() const noexcept {
+    return is_valid();
+}
+
+sql_prepared_statement::result_type const& sql_prepared_statement::result() const noexcept {
+    return result_;
+}
+
+sequence_view<sql_prepared_statement::parameter_type const> sql_prepared_statement::parameters() const noexcept {
+    return parameters_;
+}
+
+std::optional<std::size_t> sql_prepared_statement::find_parameter(std::string_view name) const noexcept {
+    for (std::size_t index = 0, size = parameters_.size(); index < size; ++index) {
+        if (parameters_[index]->name() == name) {
+            return index;
+        }
+    }
+    return {};
+}
+
+sql_prepared_statement::binding sql_prepared_statement::bind(placeholder_map const& values) const {
+    std::vector<value_type> results {};
+    std::vector<diagnostic_type> diagnostics {};
+    results.reserve(parameters_.size());
+    for (auto&& parameter : parameters_) {
+        auto entry = values.find(parameter->name());
+        if (!entry) {
+            diagnostics.emplace_back(
+                    sql_analyzer_code::variable_not_found,
+                    string_builder {}
+                            << "parameter is not bound: "
+                            << parameter->name()
+                            << string_builder::to_string,
+                    ::takatori::document::region {});
+            continue;
+        }
+        if (*entry->type() != parameter->type()) {
+            diagnostics.emplace_back(
+                    sql_analyzer_code::inconsistent_type,
+                    string_builder {}
+                            << "parameter type is inconsistent: "
+                            << parameter->name() << " "
+                            << "(expected: " << parameter->type() << ", "
+                            << "bound: " << *entry->type() << ")"
+                            << string_builder::to_string,
+                    ::takatori::document::region {});
+            continue;
+        }
+        results.emplace_back(entry->value());
+    }
+    if (!diagnostics.empty()) {
+        return binding { std::move(diagnostics) };
+    }
+    return binding { std::move(results) };
+}
+
+std::ostream& operator<<(std::ostream& out, sql_prepared_statement const& value) {
+    return out << "sql_prepared_statement("
+               << "result=" << value.result_ << ", "
+               << "parameters=" << value.parameters_.size() << ")";
+}
+
+} // namespace mizugaki::analyzer
@@ -0,0 +1,2579 @@
+#include <mizugaki/ast/binary_format.h>
+
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <mizugaki/ast/common/regioned.h>
+
+#include <mizugaki/ast/statement/dispatch.h>
+#include <mizugaki/ast/query/dispatch.h>
+#include <mizugaki/ast/table/dispatch.h>
+#include <mizugaki/ast/scalar/dispatch.h>
+#include <mizugaki/ast/literal/dispatch.h>
+#include <mizugaki/ast/type/dispatch.h>
+#include <mizugaki/ast/name/dispatch.h>
+
+namespace mizugaki::ast::binary_format {
+
+namespace {
+
+constexpr std::size_t header_size = magic.size() + sizeof(version);
+
+std::uint64_t to_zigzag(std::int64_t value) noexcept {
+    return (static_cast<std::uint64_t>(value) << 1U) ^ (value < 0 ? ~std::uint64_t {} : std::uint64_t {});
+}
+
+std::int64_t from_zigzag(std::uint64_t bits) noexcept {
+    return static_cast<std::int64_t>(bits >> 1U) ^ -static_cast<std::int64_t>(bits & 1U);
+}
+
+/**
+ * @brief writes the AST nodes.
+ * @details Each polymorphic node is written as its node kind (or 0 if it is absent), its region, and its properties
+ *      in order of the constructor parameters. The other elements are written as their region and properties.
+ */
+class encoder {
+public:
+    encoder() {
+        buffer_.append(magic);
+        buffer_.push_back(static_cast<char>(version));
+    }
+
+    void write(compilation_unit const& value) {
+        auto&& document = value.document();
+        put(static_cast<bool>(document));
+        if (document) {
+            put_symbol(document->location());
+        }
+        put(value.statements());
+        put(value.comments());
+    }
+
+    [[nodiscard]] std::string release() noexcept {
+        symbols_.clear();
+        return std::move(buffer_);
+    }
+
+    void put(node_region value) {
+        if (!value) {
+            put_varint(0);
+            return;
+        }
+        // the regions are almost increasing
+        put_varint(to_zigzag(static_cast<std::int64_t>(value.begin) - static_cast<std::int64_t>(last_position_)) + 1);
+        put_varint(to_zigzag(static_cast<std::int64_t>(value.end) - static_cast<std::int64_t>(value.begin)));
+        last_position_ = value.begin;
+    }
+
+    void put(bool value) {
+        buffer_.push_back(static_cast<char>(value ? 1 : 0));
+    }
+
+    void put(std::size_t value) {
+        put_varint(value);
+    }
+
+    void put(common::chars const& value) {
+        put_symbol(value);
+    }
+
+    template<class T>
+    std::enable_if_t<std::is_enum_v<T>> put(T value) {
+        put_varint(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(value)));
+    }
+
+    template<class T>
+    void put(common::regioned<T> const& value) {
+        put(value.value());
+        put(value.region());
+    }
+
+    template<class T>
+    void put(std::optional<T> const& value) {
+        put(value.has_value());
+        if (value) {
+            put(*value);
+        }
+    }
+
+    template<class T>
+    void put(std::vector<T> const& values) {
+        put_varint(values.size());
+        for (auto&& value : values) {
+            put(value);
+        }
+    }
+
+    template<class T>
+    void put(std::unique_ptr<T> const& value) {
+        if (!value) {
+            put_varint(0);
+            return;
+        }
+        put_varint(static_cast<std::uint64_t>(value->node_kind()) + 1);
+        put(value->region());
+        visit(*value);
+    }
+
+    void put(common::sort_element const& value) {
+        put(value.region());
+        put(value.key());
+        put(value.collation());
+        put(value.direction());
+        put(value.null_location());
+    }
+
+    void put(common::target_element const& value) {
+        put(value.region());
+        put(value.target());
+        put(value.indicator());
+    }
+
+    void put(query::corresponding_clause const& value) {
+        put(value.region());
+        put(value.column_names());
+    }
+
+    void put(query::group_by_clause const& value) {
+        put(value.region());
+        put(value.elements());
+    }
+
+    void put(query::with_element const& value) {
+        put(value.region());
+        put(value.name());
+        put(value.column_names());
+        put(value.expression());
+    }
+
+    void put(scalar::case_when_clause const& value) {
+        put(value.region());
+        put(value.when());
+        put(value.result());
+    }
+
+    void put(statement::column_constraint_definition const& value) {
+        put(value.region());
+        put(value.name());
+        put(value.body());
+    }
+
+    void put(statement::privilege_action const& value) {
+        put(value.region());
+        put(value.action_kind());
+    }
+
+    void put(statement::privilege_object const& value) {
+        put(value.region());
+        put(value.object_kind());
+        put(value.object_name());
+    }
+
+    void put(statement::privilege_user const& value) {
+        put(value.region());
+        put(value.user_kind());
+        put(value.authorization_identifier());
+    }
+
+    void put(statement::set_element const& value) {
+        put(value.region());
+        put(value.target());
+        put(value.value());
+    }
+
+    void put(statement::storage_parameter const& value) {
+        put(value.region());
+        put(value.name());
+        put(value.value());
+    }
+
+    void put(table::correlation_clause const& value) {
+        put(value.region());
+        put(value.correlation_name());
+        put(value.column_names());
+    }
+
+    void put(type::field_definition const& value) {
+        put(value.region());
+        put(value.name());
+        put(value.type());
+        put(value.collation());
+    }
+
+    void visit(statement::statement const& value) {
+        statement::dispatch(*this, value);
+    }
+
+    void visit(statement::table_element const& value) {
+        statement::dispatch(*this, value);
+    }
+
+    void visit(statement::constraint const& value) {
+        statement::dispatch(*this, value);
+    }
+
+    void visit(statement::alter_table_action const& value) {
+        statement::dispatch(*this, value);
+    }
+
+    void visit(statement::alter_index_action const& value) {
+        statement::dispatch(*this, value);
+    }
+
+    void visit(query::expression const& value) {
+        query::dispatch(*this, value);
+    }
+
+    void visit(query::select_element const& value) {
+        query::dispatch(*this, value);
+    }
+
+    void visit(query::grouping_element const& value) {
+        query::dispatch(*this, value);
+    }
+
+    void visit(table::expression const& value) {
+        table::dispatch(*this, value);
+    }
+
+    void visit(table::join_specification const& value) {
+        table::dispatch(*this, value);
+    }
+
+    void visit(scalar::expression const& value) {
+        scalar::dispatch(*this, value);
+    }
+
+    void visit(literal::literal const& value) {
+        literal::dispatch(*this, value);
+    }
+
+    void visit(type::type const& value) {
+        type::dispatch(*this, value);
+    }
+
+    void visit(name::name const& value) {
+        name::dispatch(*this, value);
+    }
+
+    void operator()(statement::empty_statement const& value) {
+        (void) value;
+    }
+
+    void operator()(statement::select_statement const& value) {
+        put(value.expression());
+        put(value.targets());
+    }
+
+    void operator()(statement::insert_statement const& value) {
+        put(value.table_name());
+        put(value.columns());
+        put(value.expression());
+        put(value.options());
+    }
+
+    void operator()(statement::update_statement const& value) {
+        put(value.table_name());
+        put(value.alias_name());
+        put(value.elements());
+        put(value.where());
+    }
+
+    void operator()(statement::delete_statement const& value) {
+        put(value.table_name());
+        put(value.alias_name());
+        put(value.where());
+    }
+
+    void operator()(statement::table_definition const& value) {
+        put(value.name());
+        put(value.elements());
+        put(value.options());
+        put(value.parameters());
+        put(value.description());
+    }
+
+    void operator()(statement::index_definition const& value) {
+        put(value.name());
+        put(value.table_name());
+        put(value.keys());
+        put(value.values());
+        put(value.predicate());
+        put(value.options());
+        put(value.parameters());
+        put(value.description());
+    }
+
+    void operator()(statement::view_definition const& value) {
+        put(value.name());
+        put(value.columns());
+        put(value.query());
+        put(value.options());
+        put(value.parameters());
+        put(value.description());
+    }
+
+    void operator()(statement::sequence_definition const& value) {
+        put(value.name());
+        put(value.type());
+        put(value.initial_value());
+        put(value.increment_value());
+        put(value.min_value());
+        put(value.max_value());
+        put(value.owner());
+        put(value.options());
+        put(value.description());
+    }
+
+    void operator()(statement::schema_definition const& value) {
+        put(value.name());
+        put(value.user_name());
+        put(value.elements());
+        put(value.options());
+        put(value.description());
+    }
+
+    void operator()(statement::alter_table_statement const& value) {
+        put(value.if_exists());
+        put(value.name());
+        put(value.action());
+    }
+
+    void operator()(statement::alter_index_statement const& value) {
+        put(value.if_exists());
+        put(value.name());
+        put(value.action());
+    }
+
+    void operator()(statement::drop_statement const& value) {
+        put(value.statement_kind());
+        put(value.name());
+        put(value.options());
+    }
+
+    void operator()(statement::truncate_table_statement const& value) {
+        put(value.name());
+        put(value.identity_column_option());
+    }
+
+    void operator()(statement::grant_privilege_statement const& value) {
+        put(value.actions());
+        put(value.objects());
+        put(value.users());
+    }
+
+    void operator()(statement::revoke_privilege_statement const& value) {
+        put(value.actions());
+        put(value.objects());
+        put(value.users());
+    }
+
+    void operator()(statement::column_definition const& value) {
+        put(value.name());
+        put(value.type());
+        put(value.constraints());
+        put(value.description());
+    }
+
+    void operator()(statement::table_constraint_definition const& value) {
+        put(value.name());
+        put(value.body());
+    }
+
+    void operator()(statement::simple_constraint const& value) {
+        put(value.constraint_kind());
+    }
+
+    void operator()(statement::expression_constraint const& value) {
+        put(value.constraint_kind());
+        put(value.expression());
+    }
+
+    void operator()(statement::key_constraint const& value) {
+        put(value.constraint_kind());
+        put(value.key());
+        put(value.values());
+        put(value.parameters());
+    }
+
+    void operator()(statement::referential_constraint const& value) {
+        put(value.columns());
+        put(value.target());
+        put(value.target_columns());
+        put(value.on_update());
+        put(value.on_delete());
+    }
+
+    void operator()(statement::identity_constraint const& value) {
+        put(value.generation());
+        put(value.initial_value());
+        put(value.increment_value());
+        put(value.min_value());
+        put(value.max_value());
+        put(value.cycle());
+    }
+
+    void operator()(statement::rename_table_action const& value) {
+        put(value.replacement());
+    }
+
+    void operator()(statement::rename_column_action const& value) {
+        put(value.if_exists());
+        put(value.column_name());
+        put(value.replacement());
+    }
+
+    void operator()(statement::rename_index_action const& value) {
+        put(value.replacement());
+    }
+
+    void operator()(query::query const& value) {
+        put(value.quantifier());
+        put(value.elements());
+        put(value.from());
+        put(value.where());
+        put(value.group_by());
+        put(value.having());
+        put(value.order_by());
+        put(value.limit());
+    }
+
+    void operator()(query::table_reference const& value) {
+        put(value.name());
+    }
+
+    void operator()(query::table_value_constructor const& value) {
+        put(value.elements());
+    }
+
+    void operator()(query::binary_expression const& value) {
+        put(value.left());
+        put(value.operator_kind());
+        put(value.quantifier());
+        put(value.corresponding());
+        put(value.right());
+    }
+
+    void operator()(query::with_expression const& value) {
+        put(value.is_recursive());
+        put(value.elements());
+        put(value.expression());
+    }
+
+    void operator()(query::select_column const& value) {
+        put(value.value());
+        put(value.name());
+    }
+
+    void operator()(query::select_asterisk const& value) {
+        put(value.qualifier());
+    }
+
+    void operator()(query::grouping_column const& value) {
+        put(value.column());
+        put(value.collation());
+    }
+
+    void operator()(table::table_reference const& value) {
+        put(value.is_only());
+        put(value.name());
+        put(value.correlation());
+    }
+
+    void operator()(table::unnest const& value) {
+        put(value.expression());
+        put(value.with_ordinality());
+        put(value.correlation());
+    }
+
+    void operator()(table::join const& value) {
+        put(value.left());
+        put(value.operator_kind());
+        put(value.right());
+        put(value.specification());
+    }
+
+    void operator()(table::subquery const& value) {
+        put(value.is_lateral());
+        put(value.expression());
+        put(value.correlation());
+    }
+
+    void operator()(table::apply const& value) {
+        put(value.operand());
+        put(value.operator_kind());
+        put(value.name());
+        put(value.arguments());
+        put(value.correlation());
+    }
+
+    void operator()(table::join_condition const& value) {
+        put(value.expression());
+    }
+
+    void operator()(table::join_columns const& value) {
+        put(value.columns());
+    }
+
+    void operator()(scalar::literal_expression const& value) {
+        put(value.value());
+    }
+
+    void operator()(scalar::variable_reference const& value) {
+        put(value.name());
+    }
+
+    void operator()(scalar::host_parameter_reference const& value) {
+        put(value.name());
+    }
+
+    void operator()(scalar::field_reference const& value) {
+        put(value.value());
+        put(value.operator_kind());
+        put(value.name());
+    }
+
+    void operator()(scalar::case_expression const& value) {
+        put(value.operand());
+        put(value.when_clauses());
+        put(value.default_result());
+    }
+
+    void operator()(scalar::cast_expression const& value) {
+        put(value.operator_kind());
+        put(value.operand());
+        put(value.type());
+    }
+
+    void operator()(scalar::unary_expression const& value) {
+        put(value.operator_kind());
+        put(value.operand());
+    }
+
+    void operator()(scalar::binary_expression const& value) {
+        put(value.left());
+        put(value.operator_kind());
+        put(value.right());
+    }
+
+    void operator()(scalar::extract_expression const& value) {
+        put(value.field());
+        put(value.subsecond_digits());
+        put(value.operand());
+    }
+
+    void operator()(scalar::trim_expression const& value) {
+        put(value.specification());
+        put(value.character());
+        put(value.source());
+    }
+
+    void operator()(scalar::value_constructor const& value) {
+        put(value.operator_kind());
+        put(value.elements());
+    }
+
+    void operator()(scalar::subquery const& value) {
+        put(value.query());
+        put(value.context_kind());
+    }
+
+    void operator()(scalar::comparison_predicate const& value) {
+        put(value.left());
+        put(value.operator_kind());
+        put(value.right());
+    }
+
+    void operator()(scalar::quantified_comparison_predicate const& value) {
+        put(value.left());
+        put(value.operator_kind());
+        put(value.quantifier());
+        put(value.right());
+    }
+
+    void operator()(scalar::between_predicate const& value) {
+        put(value.target());
+        put(value.is_not());
+        put(value.operator_kind());
+        put(value.left());
+        put(value.right());
+    }
+
+    void operator()(scalar::in_predicate const& value) {
+        put(value.left());
+        put(value.is_not());
+        put(value.right());
+    }
+
+    void operator()(scalar::pattern_match_predicate const& value) {
+        put(value.match_value());
+        put(value.is_not());
+        put(value.operator_kind());
+        put(value.pattern());
+        put(value.escape());
+    }
+
+    void operator()(scalar::table_predicate const& value) {
+        put(value.operator_kind());
+        put(value.operand());
+    }
+
+    void operator()(scalar::function_invocation const& value) {
+        put(value.name());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::builtin_function_invocation const& value) {
+        put(value.function());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::builtin_set_function_invocation const& value) {
+        put(value.function());
+        put(value.quantifier());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::new_invocation const& value) {
+        put(value.type());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::method_invocation const& value) {
+        put(value.value());
+        put(value.operator_kind());
+        put(value.name());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::static_method_invocation const& value) {
+        put(value.type());
+        put(value.name());
+        put(value.arguments());
+    }
+
+    void operator()(scalar::current_of_cursor const& value) {
+        put(value.name());
+    }
+
+    void operator()(scalar::placeholder_reference const& value) {
+        put(value.index());
+    }
+
+    void operator()(literal::boolean const& value) {
+        put(value.value());
+    }
+
+    void operator()(literal::numeric const& value) {
+        put(value.value_kind());
+        put(value.sign());
+        put(value.unsigned_value());
+    }
+
+    void operator()(literal::string const& value) {
+        put(value.value_kind());
+        put(value.value());
+        put(value.concatenations());
+    }
+
+    void operator()(literal::datetime const& value) {
+        put(value.value_kind());
+        put(value.value());
+    }
+
+    void operator()(literal::interval const& value) {
+        put(value.sign());
+        put(value.value());
+    }
+
+    template<literal::kind Kind>
+    void operator()(literal::special<Kind> const& value) {
+        (void) value;
+    }
+
+    void operator()(type::simple const& value) {
+        put(value.type_kind());
+    }
+
+    void operator()(type::character_string const& value) {
+        put(value.type_kind());
+        put(value.length());
+    }
+
+    void operator()(type::bit_string const& value) {
+        put(value.type_kind());
+        put(value.length());
+    }
+
+    void operator()(type::octet_string const& value) {
+        put(value.type_kind());
+        put(value.length());
+    }
+
+    void operator()(type::decimal const& value) {
+        put(value.type_kind());
+        put(value.precision());
+        put(value.scale());
+    }
+
+    void operator()(type::binary_numeric const& value) {
+        put(value.type_kind());
+        put(value.precision());
+    }
+
+    void operator()(type::datetime const& value) {
+        put(value.type_kind());
+        put(value.has_time_zone());
+    }
+
+    void operator()(type::interval const& value) {
+        (void) value;
+    }
+
+    void operator()(type::row const& value) {
+        put(value.elements());
+    }
+
+    void operator()(type::user_defined const& value) {
+        put(value.name());
+    }
+
+    void operator()(type::collection const& value) {
+        put(value.element());
+        put(value.length());
+    }
+
+    void operator()(name::simple const& value) {
+        put(value.identifier());
+        put(value.identifier_kind());
+    }
+
+    void operator()(name::qualified const& value) {
+        put(value.qualifier());
+        put(value.last());
+    }
+
+private:
+    std::string buffer_ {};
+    std::unordered_map<std::string, std::size_t> symbols_ {};
+    node_region::position_type last_position_ {};
+
+    void put_varint(std::uint64_t value) {
+        while (value >= 0x80U) {
+            buffer_.push_back(static_cast<char>((value & 0x7fU) | 0x80U));
+            value >>= 7U;
+        }
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    void put_symbol(std::string_view value) {
+        auto [iter, added] = symbols_.try_emplace(std::string { value }, symbols_.size());
+        put_varint(iter->second);
+        if (added) {
+            put_varint(value.size());
+            buffer_.append(value);
+        }
+    }
+};
+
+template<class T>
+struct type_tag {};
+
+/*
+ * The last enumerator of each enum type in the AST.
+ * All of them are numbered from zero without gaps, so that decoded values are validated against these.
+ */
+
+constexpr common::null_ordering_specification last_enumerator(type_tag<common::null_ordering_specification>) noexcept {
+    return common::null_ordering_specification::last;
+}
+
+constexpr common::ordering_specification last_enumerator(type_tag<common::ordering_specification>) noexcept {
+    return common::ordering_specification::desc;
+}
+
+constexpr literal::boolean_kind last_enumerator(type_tag<literal::boolean_kind>) noexcept {
+    return literal::boolean_kind::unknown;
+}
+
+constexpr literal::kind last_enumerator(type_tag<literal::kind>) noexcept {
+    return literal::kind::default_;
+}
+
+constexpr literal::sign last_enumerator(type_tag<literal::sign>) noexcept {
+    return literal::sign::minus;
+}
+
+constexpr name::identifier_kind last_enumerator(type_tag<name::identifier_kind>) noexcept {
+    return name::identifier_kind::delimited;
+}
+
+constexpr name::kind last_enumerator(type_tag<name::kind>) noexcept {
+    return name::kind::qualified;
+}
+
+constexpr query::binary_operator last_enumerator(type_tag<query::binary_operator>) noexcept {
+    return query::binary_operator::intersect;
+}
+
+constexpr query::grouping_element_kind last_enumerator(type_tag<query::grouping_element_kind>) noexcept {
+    return query::grouping_element_kind::column;
+}
+
+constexpr query::kind last_enumerator(type_tag<query::kind>) noexcept {
+    return query::kind::with_expression;
+}
+
+constexpr query::select_element_kind last_enumerator(type_tag<query::select_element_kind>) noexcept {
+    return query::select_element_kind::asterisk;
+}
+
+constexpr scalar::between_operator last_enumerator(type_tag<scalar::between_operator>) noexcept {
+    return scalar::between_operator::symmetric;
+}
+
+constexpr scalar::binary_operator last_enumerator(type_tag<scalar::binary_operator>) noexcept {
+    return scalar::binary_operator::have_elements_in_common;
+}
+
+constexpr scalar::builtin_function_kind last_enumerator(type_tag<scalar::builtin_function_kind>) noexcept {
+    return scalar::builtin_function_kind::current_path;
+}
+
+constexpr scalar::builtin_set_function_kind last_enumerator(type_tag<scalar::builtin_set_function_kind>) noexcept {
+    return scalar::builtin_set_function_kind::bool_or;
+}
+
+constexpr scalar::cast_operator last_enumerator(type_tag<scalar::cast_operator>) noexcept {
+    return scalar::cast_operator::generalize;
+}
+
+constexpr scalar::comparison_operator last_enumerator(type_tag<scalar::comparison_operator>) noexcept {
+    return scalar::comparison_operator::greater_than_or_equals;
+}
+
+constexpr scalar::expression_context_kind last_enumerator(type_tag<scalar::expression_context_kind>) noexcept {
+    return scalar::expression_context_kind::row;
+}
+
+constexpr scalar::extract_field_kind last_enumerator(type_tag<scalar::extract_field_kind>) noexcept {
+    return scalar::extract_field_kind::year_to_second;
+}
+
+constexpr scalar::kind last_enumerator(type_tag<scalar::kind>) noexcept {
+    return scalar::kind::placeholder_reference;
+}
+
+constexpr scalar::pattern_match_operator last_enumerator(type_tag<scalar::pattern_match_operator>) noexcept {
+    return scalar::pattern_match_operator::similar_to;
+}
+
+constexpr scalar::quantifier last_enumerator(type_tag<scalar::quantifier>) noexcept {
+    return scalar::quantifier::any;
+}
+
+constexpr scalar::reference_operator last_enumerator(type_tag<scalar::reference_operator>) noexcept {
+    return scalar::reference_operator::arrow;
+}
+
+constexpr scalar::set_quantifier last_enumerator(type_tag<scalar::set_quantifier>) noexcept {
+    return scalar::set_quantifier::all;
+}
+
+constexpr scalar::table_operator last_enumerator(type_tag<scalar::table_operator>) noexcept {
+    return scalar::table_operator::unique;
+}
+
+constexpr scalar::trim_specification last_enumerator(type_tag<scalar::trim_specification>) noexcept {
+    return scalar::trim_specification::both;
+}
+
+constexpr scalar::unary_operator last_enumerator(type_tag<scalar::unary_operator>) noexcept {
+    return scalar::unary_operator::reference_resolution;
+}
+
+constexpr scalar::value_constructor_kind last_enumerator(type_tag<scalar::value_constructor_kind>) noexcept {
+    return scalar::value_constructor_kind::row;
+}
+
+constexpr statement::alter_index_action_kind last_enumerator(type_tag<statement::alter_index_action_kind>) noexcept {
+    return statement::alter_index_action_kind::rename_index;
+}
+
+constexpr statement::alter_table_action_kind last_enumerator(type_tag<statement::alter_table_action_kind>) noexcept {
+    return statement::alter_table_action_kind::rename_column;
+}
+
+constexpr statement::constraint_kind last_enumerator(type_tag<statement::constraint_kind>) noexcept {
+    return statement::constraint_kind::identity_column;
+}
+
+constexpr statement::drop_statement_option last_enumerator(type_tag<statement::drop_statement_option>) noexcept {
+    return statement::drop_statement_option::cascade;
+}
+
+constexpr statement::identity_column_restart_option last_enumerator(type_tag<statement::identity_column_restart_option>) noexcept {
+    return statement::identity_column_restart_option::restart_identity;
+}
+
+constexpr statement::identity_generation_type last_enumerator(type_tag<statement::identity_generation_type>) noexcept {
+    return statement::identity_generation_type::by_default;
+}
+
+constexpr statement::index_definition_option last_enumerator(type_tag<statement::index_definition_option>) noexcept {
+    return statement::index_definition_option::if_not_exists;
+}
+
+constexpr statement::insert_statement_option last_enumerator(type_tag<statement::insert_statement_option>) noexcept {
+    return statement::insert_statement_option::or_ignore;
+}
+
+constexpr statement::kind last_enumerator(type_tag<statement::kind>) noexcept {
+    return statement::kind::empty_statement;
+}
+
+constexpr statement::privilege_action_kind last_enumerator(type_tag<statement::privilege_action_kind>) noexcept {
+    return statement::privilege_action_kind::delete_;
+}
+
+constexpr statement::privilege_object_kind last_enumerator(type_tag<statement::privilege_object_kind>) noexcept {
+    return statement::privilege_object_kind::schema;
+}
+
+constexpr statement::privilege_user_kind last_enumerator(type_tag<statement::privilege_user_kind>) noexcept {
+    return statement::privilege_user_kind::public_;
+}
+
+constexpr statement::referential_action last_enumerator(type_tag<statement::referential_action>) noexcept {
+    return statement::referential_action::no_action;
+}
+
+constexpr statement::schema_definition_option last_enumerator(type_tag<statement::schema_definition_option>) noexcept {
+    return statement::schema_definition_option::if_not_exists;
+}
+
+constexpr statement::sequence_definition_option last_enumerator(type_tag<statement::sequence_definition_option>) noexcept {
+    return statement::sequence_definition_option::if_not_exists;
+}
+
+constexpr statement::table_definition_option last_enumerator(type_tag<statement::table_definition_option>) noexcept {
+    return statement::table_definition_option::if_not_exists;
+}
+
+constexpr statement::table_element_kind last_enumerator(type_tag<statement::table_element_kind>) noexcept {
+    return statement::table_element_kind::constraint_definition;
+}
+
+constexpr statement::view_definition_option last_enumerator(type_tag<statement::view_definition_option>) noexcept {
+    return statement::view_definition_option::if_not_exists;
+}
+
+constexpr table::apply_type last_enumerator(type_tag<table::apply_type>) noexcept {
+    return table::apply_type::outer;
+}
+
+constexpr table::join_specification_kind last_enumerator(type_tag<table::join_specification_kind>) noexcept {
+    return table::join_specification_kind::columns;
+}
+
+constexpr table::join_type last_enumerator(type_tag<table::join_type>) noexcept {
+    return table::join_type::union_;
+}
+
+constexpr table::kind last_enumerator(type_tag<table::kind>) noexcept {
+    return table::kind::apply;
+}
+
+constexpr type::kind last_enumerator(type_tag<type::kind>) noexcept {
+    return type::kind::collection;
+}
+/**
+ * @brief reads the AST nodes written by encoder.
+ * @details If the data is broken, this stops reading, and the subsequent operations return empty values.
+ */
+class decoder {
+public:
+    explicit decoder(std::string_view data, std::size_t tree_depth_limit) noexcept :
+        data_ { data },
+        tree_depth_limit_ { tree_depth_limit }
+    {}
+
+    [[nodiscard]] std::unique_ptr<compilation_unit> read(
+            ::takatori::util::maybe_shared_ptr<::takatori::document::document const> document) {
+        if (get<bool>()) {
+            auto location = get_symbol();
+            if (document && document->location() != location) {
+                return {};
+            }
+        }
+        auto statements = get<std::vector<std::unique_ptr<statement::statement>>>();
+        auto comments = get<std::vector<node_region>>();
+        if (failed_ || position_ != data_.size()) {
+            return {};
+        }
+        return std::make_unique<compilation_unit>(std::move(statements), std::move(comments), std::move(document));
+    }
+
+    template<class T>
+    [[nodiscard]] T get() {
+        return read(type_tag<T> {});
+    }
+
+    [[nodiscard]] node_region read(type_tag<node_region>) {
+        auto head = get_varint();
+        if (head == 0) {
+            return {};
+        }
+        auto begin = static_cast<node_region::position_type>(
+                static_cast<std::int64_t>(last_position_) + from_zigzag(head - 1));
+        auto end = static_cast<node_region::position_type>(
+                static_cast<std::int64_t>(begin) + from_zigzag(get_varint()));
+        last_position_ = begin;
+        return { begin, end };
+    }
+
+    [[nodiscard]] bool read(type_tag<bool>) {
+        if (failed_ || position_ >= data_.size()) {
+            fail();
+            return {};
+        }
+        auto value = static_cast<std::uint8_t>(data_[position_++]);
+        if (value > 1) {
+            fail();
+            return {};
+        }
+        return value != 0;
+    }
+
+    [[nodiscard]] std::size_t read(type_tag<std::size_t>) {
+        return static_cast<std::size_t>(get_varint());
+    }
+
+    [[nodiscard]] common::chars read(type_tag<common::chars>) {
+        return common::chars { get_symbol() };
+    }
+
+    template<class T>
+    [[nodiscard]] std::enable_if_t<std::is_enum_v<T>, T> read(type_tag<T>) {
+        auto value = get_varint();
+        if (value > static_cast<std::uint64_t>(last_enumerator(type_tag<T> {}))) {
+            fail();
+            return {};
+        }
+        return static_cast<T>(static_cast<std::underlying_type_t<T>>(value));
+    }
+
+    template<class T>
+    [[nodiscard]] common::regioned<T> read(type_tag<common::regioned<T>>) {
+        auto value = get<T>();
+        auto region = get<node_region>();
+        return { std::move(value), region };
+    }
+
+    template<class T>
+    [[nodiscard]] std::optional<T> read(type_tag<std::optional<T>>) {
+        if (!get<bool>()) {
+            return {};
+        }
+        return get<T>();
+    }
+
+    template<class T>
+    [[nodiscard]] std::vector<T> read(type_tag<std::vector<T>>) {
+        auto size = get_varint();
+        // each element occupies at least one byte
+        if (size > data_.size() - position_) {
+            fail();
+            return {};
+        }
+        std::vector<T> results {};
+        results.reserve(size);
+        for (std::uint64_t i = 0; i < size && !failed_; ++i) {
+            results.emplace_back(get<T>());
+        }
+        return results;
+    }
+
+    template<class T>
+    [[nodiscard]] std::unique_ptr<T> read(type_tag<std::unique_ptr<T>>) {
+        auto head = get_varint();
+        if (head == 0) {
+            return {};
+        }
+        auto region = get<node_region>();
+        if (failed_) {
+            return {};
+        }
+        if (tree_depth_limit_ != 0 && depth_ >= tree_depth_limit_) {
+            return broken();
+        }
+        ++depth_;
+        auto result = read_node(type_tag<T> {}, head - 1, region);
+        --depth_;
+        // the node kind is also carried by some properties, like drop_statement::statement_kind
+        if (result && static_cast<std::uint64_t>(result->node_kind()) != head - 1) {
+            return broken();
+        }
+        return result;
+    }
+
+    [[nodiscard]] common::sort_element read(type_tag<common::sort_element>) {
+        common::sort_element result {};
+        result.region() = get<node_region>();
+        result.key() = get<std::unique_ptr<scalar::expression>>();
+        result.collation() = get<std::unique_ptr<ast::name::name>>();
+        result.direction() = get<std::optional<common::sort_element::direction_type>>();
+        result.null_location() = get<std::optional<common::sort_element::null_location_type>>();
+        return result;
+    }
+
+    [[nodiscard]] common::target_element read(type_tag<common::target_element>) {
+        auto region = get<node_region>();
+        auto target = get<std::unique_ptr<ast::name::name>>();
+        auto indicator = get<std::unique_ptr<ast::name::simple>>();
+        return common::target_element { std::move(target), std::move(indicator), region };
+    }
+
+    [[nodiscard]] query::corresponding_clause read(type_tag<query::corresponding_clause>) {
+        auto region = get<node_region>();
+        auto column_names = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        return query::corresponding_clause { std::move(column_names), region };
+    }
+
+    [[nodiscard]] query::group_by_clause read(type_tag<query::group_by_clause>) {
+        auto region = get<node_region>();
+        auto elements = get<std::vector<std::unique_ptr<ast::query::grouping_element>>>();
+        return query::group_by_clause { std::move(elements), region };
+    }
+
+    [[nodiscard]] query::with_element read(type_tag<query::with_element>) {
+        query::with_element result {};
+        result.region() = get<node_region>();
+        result.name() = get<std::unique_ptr<ast::name::simple>>();
+        result.column_names() = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        result.expression() = get<std::unique_ptr<ast::query::expression>>();
+        return result;
+    }
+
+    [[nodiscard]] scalar::case_when_clause read(type_tag<scalar::case_when_clause>) {
+        scalar::case_when_clause result {};
+        result.region() = get<node_region>();
+        result.when() = get<std::unique_ptr<scalar::expression>>();
+        result.result() = get<std::unique_ptr<scalar::expression>>();
+        return result;
+    }
+
+    [[nodiscard]] statement::column_constraint_definition read(type_tag<statement::column_constraint_definition>) {
+        statement::column_constraint_definition result {};
+        result.region() = get<node_region>();
+        result.name() = get<std::unique_ptr<ast::name::name>>();
+        result.body() = get<std::unique_ptr<statement::constraint>>();
+        return result;
+    }
+
+    [[nodiscard]] statement::privilege_action read(type_tag<statement::privilege_action>) {
+        statement::privilege_action result {};
+        result.region() = get<node_region>();
+        result.action_kind() = get<statement::privilege_action::action_kind_type>();
+        return result;
+    }
+
+    [[nodiscard]] statement::privilege_object read(type_tag<statement::privilege_object>) {
+        statement::privilege_object result {};
+        result.region() = get<node_region>();
+        result.object_kind() = get<std::optional<statement::privilege_object::object_kind_type>>();
+        result.object_name() = get<std::unique_ptr<ast::name::name>>();
+        return result;
+    }
+
+    [[nodiscard]] statement::privilege_user read(type_tag<statement::privilege_user>) {
+        auto region = get<node_region>();
+        auto user_kind = get<statement::privilege_user::user_kind_type>();
+        auto authorization_identifier = get<std::unique_ptr<ast::name::simple>>();
+        return statement::privilege_user { user_kind, std::move(authorization_identifier), region };
+    }
+
+    [[nodiscard]] statement::set_element read(type_tag<statement::set_element>) {
+        statement::set_element result {};
+        result.region() = get<node_region>();
+        result.target() = get<std::unique_ptr<ast::name::name>>();
+        result.value() = get<std::unique_ptr<scalar::expression>>();
+        return result;
+    }
+
+    [[nodiscard]] statement::storage_parameter read(type_tag<statement::storage_parameter>) {
+        statement::storage_parameter result {};
+        result.region() = get<node_region>();
+        result.name() = get<std::unique_ptr<ast::name::name>>();
+        result.value() = get<std::unique_ptr<scalar::expression>>();
+        return result;
+    }
+
+    [[nodiscard]] table::correlation_clause read(type_tag<table::correlation_clause>) {
+        table::correlation_clause result {};
+        result.region() = get<node_region>();
+        result.correlation_name() = get<std::unique_ptr<ast::name::simple>>();
+        result.column_names() = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        return result;
+    }
+
+    [[nodiscard]] type::field_definition read(type_tag<type::field_definition>) {
+        type::field_definition result {};
+        result.region() = get<node_region>();
+        result.name() = get<std::unique_ptr<ast::name::simple>>();
+        result.type() = get<std::unique_ptr<ast::type::type>>();
+        result.collation() = get<std::unique_ptr<ast::name::name>>();
+        return result;
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::statement> read_node(
+            type_tag<statement::statement>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = statement::statement::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case statement::select_statement::tag: return read_body(type_tag<statement::select_statement> {}, region);
+            case statement::insert_statement::tag: return read_body(type_tag<statement::insert_statement> {}, region);
+            case statement::update_statement::tag: return read_body(type_tag<statement::update_statement> {}, region);
+            case statement::delete_statement::tag: return read_body(type_tag<statement::delete_statement> {}, region);
+            case statement::table_definition::tag: return read_body(type_tag<statement::table_definition> {}, region);
+            case statement::view_definition::tag: return read_body(type_tag<statement::view_definition> {}, region);
+            case statement::index_definition::tag: return read_body(type_tag<statement::index_definition> {}, region);
+            case statement::sequence_definition::tag: return read_body(type_tag<statement::sequence_definition> {}, region);
+            case statement::schema_definition::tag: return read_body(type_tag<statement::schema_definition> {}, region);
+            case statement::alter_table_statement::tag: return read_body(type_tag<statement::alter_table_statement> {}, region);
+            case statement::alter_index_statement::tag: return read_body(type_tag<statement::alter_index_statement> {}, region);
+            case statement::kind::drop_table_statement:
+            case statement::kind::drop_index_statement:
+            case statement::kind::drop_view_statement:
+            case statement::kind::drop_sequence_statement:
+            case statement::kind::drop_schema_statement:
+                return read_body(type_tag<statement::drop_statement> {}, region);
+            case statement::kind::truncate_table_statement:
+                return read_body(type_tag<statement::truncate_table_statement> {}, region);
+            case statement::kind::grant_privilege_statement:
+                return read_body(type_tag<statement::grant_privilege_statement> {}, region);
+            case statement::kind::revoke_privilege_statement:
+                return read_body(type_tag<statement::revoke_privilege_statement> {}, region);
+            case statement::empty_statement::tag: return std::make_unique<statement::empty_statement>(region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::table_element> read_node(
+            type_tag<statement::table_element>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = statement::table_element::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case statement::column_definition::tag:
+                return read_body(type_tag<statement::column_definition> {}, region);
+            case statement::table_constraint_definition::tag:
+                return read_body(type_tag<statement::table_constraint_definition> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::constraint> read_node(
+            type_tag<statement::constraint>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = statement::constraint::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case statement::constraint_kind::null:
+            case statement::constraint_kind::not_null:
+                return read_body(type_tag<statement::simple_constraint> {}, region);
+            case statement::constraint_kind::check:
+            case statement::constraint_kind::default_clause:
+            case statement::constraint_kind::generation_clause:
+                return read_body(type_tag<statement::expression_constraint> {}, region);
+            case statement::constraint_kind::unique:
+            case statement::constraint_kind::primary_key:
+                return read_body(type_tag<statement::key_constraint> {}, region);
+            case statement::referential_constraint::tag:
+                return read_body(type_tag<statement::referential_constraint> {}, region);
+            case statement::identity_constraint::tag:
+                return read_body(type_tag<statement::identity_constraint> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::alter_table_action> read_node(
+            type_tag<statement::alter_table_action>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = statement::alter_table_action::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case statement::rename_table_action::tag:
+                return read_body(type_tag<statement::rename_table_action> {}, region);
+            case statement::rename_column_action::tag:
+                return read_body(type_tag<statement::rename_column_action> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::alter_index_action> read_node(
+            type_tag<statement::alter_index_action>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = statement::alter_index_action::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case statement::rename_index_action::tag:
+                return read_body(type_tag<statement::rename_index_action> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::expression> read_node(
+            type_tag<query::expression>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = query::expression::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case query::query::tag: return read_body(type_tag<query::query> {}, region);
+            case query::table_reference::tag: return read_body(type_tag<query::table_reference> {}, region);
+            case query::table_value_constructor::tag: return read_body(type_tag<query::table_value_constructor> {}, region);
+            case query::binary_expression::tag: return read_body(type_tag<query::binary_expression> {}, region);
+            case query::with_expression::tag: return read_body(type_tag<query::with_expression> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::select_element> read_node(
+            type_tag<query::select_element>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = query::select_element::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case query::select_column::tag: return read_body(type_tag<query::select_column> {}, region);
+            case query::select_asterisk::tag: return read_body(type_tag<query::select_asterisk> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::grouping_element> read_node(
+            type_tag<query::grouping_element>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = query::grouping_element::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case query::grouping_column::tag: return read_body(type_tag<query::grouping_column> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<table::expression> read_node(
+            type_tag<table::expression>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = table::expression::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case table::table_reference::tag: return read_body(type_tag<table::table_reference> {}, region);
+            case table::unnest::tag: return read_body(type_tag<table::unnest> {}, region);
+            case table::join::tag: return read_body(type_tag<table::join> {}, region);
+            case table::subquery::tag: return read_body(type_tag<table::subquery> {}, region);
+            case table::apply::tag: return read_body(type_tag<table::apply> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<table::join_specification> read_node(
+            type_tag<table::join_specification>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = table::join_specification::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case table::join_condition::tag: return read_body(type_tag<table::join_condition> {}, region);
+            case table::join_columns::tag: return read_body(type_tag<table::join_columns> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::expression> read_node(
+            type_tag<scalar::expression>,
+            std::uint64_t kind,
+            node_region region) {
+        using node_kind_type = scalar::expression::node_kind_type;
+        switch (static_cast<node_kind_type>(kind)) {
+            case scalar::literal_expression::tag:
+                return read_body(type_tag<scalar::literal_expression> {}, region);
+            case scalar::variable_reference::tag:
+                return read_body(type_tag<scalar::variable_reference> {}, region);
+            case scalar::host_parameter_reference::tag:
+                return read_body(type_tag<scalar::host_parameter_reference> {}, region);
+            case scalar::field_reference::tag:
+                return read_body(type_tag<scalar::field_reference> {}, region);
+            case scalar::case_expression::tag:
+                return read_body(type_tag<scalar::case_expression> {}, region);
+            case scalar::cast_expression::tag:
+                return read_body(type_tag<scalar::cast_expression> {}, region);
+            case scalar::unary_expression::tag:
+                return read_body(type_tag<scalar::unary_expression> {}, region);
+            case scalar::binary_expression::tag:
+                return read_body(type_tag<scalar::binary_expression> {}, region);
+            case scalar::extract_expression::tag:
+                return read_body(type_tag<scalar::extract_expression> {}, region);
+            case scalar::trim_expression::tag:
+                return read_body(type_tag<scalar::trim_expression> {}, region);
+            case scalar::value_constructor::tag:
+                return read_body(type_tag<scalar::value_constructor> {}, region);
+            case scalar::subquery::tag:
+                return read_body(type_tag<scalar::subquery> {}, region);
+            case scalar::comparison_predicate::tag:
+                return read_body(type_tag<scalar::comparison_predicate> {}, region);
+            case scalar::quantified_comparison_predicate::tag:
+                return read_body(type_tag<scalar::quantified_comparison_predicate> {}, region);
+            case scalar::between_predicate::tag:
+                return read_body(type_tag<scalar::between_predicate> {}, region);
+            case scalar::in_predicate::tag:
+                return read_body(type_tag<scalar::in_predicate> {}, region);
+            case scalar::pattern_match_predicate::tag:
+                return read_body(type_tag<scalar::pattern_match_predicate> {}, region);
+            case scalar::table_predicate::tag:
+                return read_body(type_tag<scalar::table_predicate> {}, region);
+            case scalar::function_invocation::tag:
+                return read_body(type_tag<scalar::function_invocation> {}, region);
+            case scalar::builtin_function_invocation::tag:
+                return read_body(type_tag<scalar::builtin_function_invocation> {}, region);
+            case scalar::builtin_set_function_invocation::tag:
+                return read_body(type_tag<scalar::builtin_set_function_invocation> {}, region);
+            case scalar::new_invocation::tag:
+                return read_body(type_tag<scalar::new_invocation> {}, region);
+            case scalar::method_invocation::tag:
+                return read_body(type_tag<scalar::method_invocation> {}, region);
+            case scalar::static_method_invocation::tag:
+                return read_body(type_tag<scalar::static_method_invocation> {}, region);
+            case scalar::current_of_cursor::tag:
+                return read_body(type_tag<scalar::current_of_cursor> {}, region);
+            case scalar::placeholder_reference::tag:
+                return read_body(type_tag<scalar::placeholder_reference> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::literal> read_node(
+            type_tag<literal::literal>,
+            std::uint64_t kind,
+            node_region region) {
+        switch (static_cast<literal::kind>(kind)) {
+            case literal::kind::boolean:
+                return read_body(type_tag<literal::boolean> {}, region);
+            case literal::kind::exact_numeric:
+            case literal::kind::approximate_numeric:
+                return read_body(type_tag<literal::numeric> {}, region);
+            case literal::kind::character_string:
+            case literal::kind::bit_string:
+            case literal::kind::hex_string:
+                return read_body(type_tag<literal::string> {}, region);
+            case literal::kind::date:
+            case literal::kind::time:
+            case literal::kind::time_with_time_zone:
+            case literal::kind::timestamp:
+            case literal::kind::timestamp_with_time_zone:
+                return read_body(type_tag<literal::datetime> {}, region);
+            case literal::kind::interval:
+                return read_body(type_tag<literal::interval> {}, region);
+            case literal::kind::null: return std::make_unique<literal::null>(region);
+            case literal::kind::empty: return std::make_unique<literal::empty>(region);
+            case literal::kind::default_: return std::make_unique<literal::default_>(region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::type> read_node(
+            type_tag<type::type>,
+            std::uint64_t kind,
+            node_region region) {
+        switch (static_cast<type::kind>(kind)) {
+            case type::kind::unknown:
+            case type::kind::character_large_object:
+            case type::kind::binary_large_object:
+            case type::kind::tiny_integer:
+            case type::kind::small_integer:
+            case type::kind::integer:
+            case type::kind::big_integer:
+            case type::kind::float_:
+            case type::kind::real:
+            case type::kind::double_precision:
+            case type::kind::boolean:
+            case type::kind::date:
+                return read_body(type_tag<type::simple> {}, region);
+            case type::kind::character:
+            case type::kind::character_varying:
+                return read_body(type_tag<type::character_string> {}, region);
+            case type::kind::bit:
+            case type::kind::bit_varying:
+                return read_body(type_tag<type::bit_string> {}, region);
+            case type::kind::octet:
+            case type::kind::octet_varying:
+                return read_body(type_tag<type::octet_string> {}, region);
+            case type::kind::numeric:
+            case type::kind::decimal:
+                return read_body(type_tag<type::decimal> {}, region);
+            case type::kind::binary_integer:
+            case type::kind::binary_float:
+                return read_body(type_tag<type::binary_numeric> {}, region);
+            case type::kind::time:
+            case type::kind::timestamp:
+                return read_body(type_tag<type::datetime> {}, region);
+            case type::kind::interval: return std::make_unique<type::interval>(region);
+            case type::kind::row: return read_body(type_tag<type::row> {}, region);
+            case type::kind::user_defined: return read_body(type_tag<type::user_defined> {}, region);
+            case type::kind::collection: return read_body(type_tag<type::collection> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::name::name> read_node(
+            type_tag<name::name>,
+            std::uint64_t kind,
+            node_region region) {
+        switch (static_cast<name::kind>(kind)) {
+            case name::simple::tag: return read_body(type_tag<name::simple> {}, region);
+            case name::qualified::tag: return read_body(type_tag<name::qualified> {}, region);
+        }
+        return broken();
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::name::simple> read_node(
+            type_tag<name::simple>,
+            std::uint64_t kind,
+            node_region region) {
+        if (static_cast<name::kind>(kind) != name::simple::tag) {
+            return broken();
+        }
+        return read_body(type_tag<name::simple> {}, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::select_statement> read_body(
+            type_tag<statement::select_statement>,
+            node_region region) {
+        auto expression = get<std::unique_ptr<ast::query::expression>>();
+        auto targets = get<std::vector<common::target_element>>();
+        return std::make_unique<statement::select_statement>(std::move(expression), std::move(targets), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::insert_statement> read_body(
+            type_tag<statement::insert_statement>,
+            node_region region) {
+        auto table_name = get<std::unique_ptr<ast::name::name>>();
+        auto columns = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        auto expression = get<std::unique_ptr<ast::query::expression>>();
+        auto options = get<std::vector<statement::insert_statement::option_type>>();
+        return std::make_unique<statement::insert_statement>(
+                std::move(table_name),
+                std::move(columns),
+                std::move(expression),
+                std::move(options),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::update_statement> read_body(
+            type_tag<statement::update_statement>,
+            node_region region) {
+        auto table_name = get<std::unique_ptr<ast::name::name>>();
+        auto alias_name = get<std::unique_ptr<ast::name::simple>>();
+        auto elements = get<std::vector<statement::set_element>>();
+        auto where = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<statement::update_statement>(
+                std::move(table_name),
+                std::move(alias_name),
+                std::move(elements),
+                std::move(where),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::delete_statement> read_body(
+            type_tag<statement::delete_statement>,
+            node_region region) {
+        auto table_name = get<std::unique_ptr<ast::name::name>>();
+        auto alias_name = get<std::unique_ptr<ast::name::simple>>();
+        auto where = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<statement::delete_statement>(
+                std::move(table_name),
+                std::move(alias_name),
+                std::move(where),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::table_definition> read_body(
+            type_tag<statement::table_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto elements = get<std::vector<std::unique_ptr<statement::table_element>>>();
+        auto options = get<std::vector<statement::table_definition::option_type>>();
+        auto parameters = get<std::vector<statement::storage_parameter>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::table_definition>(
+                std::move(name),
+                std::move(elements),
+                std::move(options),
+                std::move(parameters),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::index_definition> read_body(
+            type_tag<statement::index_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto table_name = get<std::unique_ptr<ast::name::name>>();
+        auto keys = get<std::vector<common::sort_element>>();
+        auto values = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        auto predicate = get<std::unique_ptr<scalar::expression>>();
+        auto options = get<std::vector<statement::index_definition::option_type>>();
+        auto parameters = get<std::vector<statement::storage_parameter>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::index_definition>(
+                std::move(name),
+                std::move(table_name),
+                std::move(keys),
+                std::move(values),
+                std::move(predicate),
+                std::move(options),
+                std::move(parameters),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::view_definition> read_body(
+            type_tag<statement::view_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto columns = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        auto query = get<std::unique_ptr<ast::query::expression>>();
+        auto options = get<std::vector<statement::view_definition::option_type>>();
+        auto parameters = get<std::vector<statement::storage_parameter>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::view_definition>(
+                std::move(name),
+                std::move(columns),
+                std::move(query),
+                std::move(options),
+                std::move(parameters),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::sequence_definition> read_body(
+            type_tag<statement::sequence_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto type = get<std::unique_ptr<ast::type::type>>();
+        auto initial_value = get<std::unique_ptr<scalar::expression>>();
+        auto increment_value = get<std::unique_ptr<scalar::expression>>();
+        auto min_value = get<std::unique_ptr<scalar::expression>>();
+        auto max_value = get<std::unique_ptr<scalar::expression>>();
+        auto owner = get<std::unique_ptr<ast::name::name>>();
+        auto options = get<std::vector<statement::sequence_definition::option_type>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::sequence_definition>(
+                std::move(name),
+                std::move(type),
+                std::move(initial_value),
+                std::move(increment_value),
+                std::move(min_value),
+                std::move(max_value),
+                std::move(owner),
+                std::move(options),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::schema_definition> read_body(
+            type_tag<statement::schema_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto user_name = get<std::unique_ptr<ast::name::simple>>();
+        auto elements = get<std::vector<std::unique_ptr<statement::statement>>>();
+        auto options = get<std::vector<statement::schema_definition::option_type>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::schema_definition>(
+                std::move(name),
+                std::move(user_name),
+                std::move(elements),
+                std::move(options),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::alter_table_statement> read_body(
+            type_tag<statement::alter_table_statement>,
+            node_region region) {
+        auto if_exists = get<statement::alter_table_statement::bool_type>();
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto action = get<std::unique_ptr<statement::alter_table_action>>();
+        return std::make_unique<statement::alter_table_statement>(
+                std::move(if_exists),
+                std::move(name),
+                std::move(action),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::alter_index_statement> read_body(
+            type_tag<statement::alter_index_statement>,
+            node_region region) {
+        auto if_exists = get<statement::alter_index_statement::bool_type>();
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto action = get<std::unique_ptr<statement::alter_index_action>>();
+        return std::make_unique<statement::alter_index_statement>(
+                std::move(if_exists),
+                std::move(name),
+                std::move(action),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::drop_statement> read_body(
+            type_tag<statement::drop_statement>,
+            node_region region) {
+        auto statement_kind = get<statement::drop_statement::statement_kind_type>();
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto options = get<std::vector<statement::drop_statement::option_type>>();
+        return std::make_unique<statement::drop_statement>(
+                std::move(statement_kind),
+                std::move(name),
+                std::move(options),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::truncate_table_statement> read_body(
+            type_tag<statement::truncate_table_statement>,
+            node_region region) {
+        using identity_column_option_type = statement::truncate_table_statement::identity_column_option_type;
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto identity_column_option = get<std::optional<identity_column_option_type>>();
+        return std::make_unique<statement::truncate_table_statement>(
+                std::move(name),
+                std::move(identity_column_option),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::grant_privilege_statement> read_body(
+            type_tag<statement::grant_privilege_statement>,
+            node_region region) {
+        auto actions = get<std::vector<statement::privilege_action>>();
+        auto objects = get<std::vector<statement::privilege_object>>();
+        auto users = get<std::vector<statement::privilege_user>>();
+        return std::make_unique<statement::grant_privilege_statement>(
+                std::move(actions),
+                std::move(objects),
+                std::move(users),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::revoke_privilege_statement> read_body(
+            type_tag<statement::revoke_privilege_statement>,
+            node_region region) {
+        auto actions = get<std::vector<statement::privilege_action>>();
+        auto objects = get<std::vector<statement::privilege_object>>();
+        auto users = get<std::vector<statement::privilege_user>>();
+        return std::make_unique<statement::revoke_privilege_statement>(
+                std::move(actions),
+                std::move(objects),
+                std::move(users),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::column_definition> read_body(
+            type_tag<statement::column_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        auto type = get<std::unique_ptr<ast::type::type>>();
+        auto constraints = get<std::vector<statement::column_constraint_definition>>();
+        auto description = get<node_region>();
+        return std::make_unique<statement::column_definition>(
+                std::move(name),
+                std::move(type),
+                std::move(constraints),
+                description,
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::table_constraint_definition> read_body(
+            type_tag<statement::table_constraint_definition>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto body = get<std::unique_ptr<statement::constraint>>();
+        return std::make_unique<statement::table_constraint_definition>(std::move(name), std::move(body), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::simple_constraint> read_body(
+            type_tag<statement::simple_constraint>,
+            node_region region) {
+        auto constraint_kind = get<statement::simple_constraint::constraint_kind_type>();
+        return std::make_unique<statement::simple_constraint>(std::move(constraint_kind), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::expression_constraint> read_body(
+            type_tag<statement::expression_constraint>,
+            node_region region) {
+        auto constraint_kind = get<statement::expression_constraint::constraint_kind_type>();
+        auto expression = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<statement::expression_constraint>(
+                std::move(constraint_kind),
+                std::move(expression),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::key_constraint> read_body(
+            type_tag<statement::key_constraint>,
+            node_region region) {
+        auto constraint_kind = get<statement::key_constraint::constraint_kind_type>();
+        auto key = get<std::vector<common::sort_element>>();
+        auto values = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        auto parameters = get<std::vector<statement::storage_parameter>>();
+        return std::make_unique<statement::key_constraint>(
+                std::move(constraint_kind),
+                std::move(key),
+                std::move(values),
+                std::move(parameters),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::referential_constraint> read_body(
+            type_tag<statement::referential_constraint>,
+            node_region region) {
+        auto columns = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        auto target = get<std::unique_ptr<ast::name::name>>();
+        auto target_columns = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        auto on_update = get<std::optional<statement::referential_constraint::action_type>>();
+        auto on_delete = get<std::optional<statement::referential_constraint::action_type>>();
+        return std::make_unique<statement::referential_constraint>(
+                std::move(columns),
+                std::move(target),
+                std::move(target_columns),
+                std::move(on_update),
+                std::move(on_delete),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::identity_constraint> read_body(
+            type_tag<statement::identity_constraint>,
+            node_region region) {
+        auto generation = get<statement::identity_constraint::generation_type>();
+        auto initial_value = get<std::unique_ptr<scalar::expression>>();
+        auto increment_value = get<std::unique_ptr<scalar::expression>>();
+        auto min_value = get<std::unique_ptr<scalar::expression>>();
+        auto max_value = get<std::unique_ptr<scalar::expression>>();
+        auto cycle = get<std::optional<statement::identity_constraint::bool_type>>();
+        return std::make_unique<statement::identity_constraint>(
+                std::move(generation),
+                std::move(initial_value),
+                std::move(increment_value),
+                std::move(min_value),
+                std::move(max_value),
+                std::move(cycle),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::rename_table_action> read_body(
+            type_tag<statement::rename_table_action>,
+            node_region region) {
+        auto replacement = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<statement::rename_table_action>(std::move(replacement), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::rename_column_action> read_body(
+            type_tag<statement::rename_column_action>,
+            node_region region) {
+        auto if_exists = get<statement::rename_column_action::bool_type>();
+        auto column_name = get<std::unique_ptr<ast::name::simple>>();
+        auto replacement = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<statement::rename_column_action>(
+                std::move(if_exists),
+                std::move(column_name),
+                std::move(replacement),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<statement::rename_index_action> read_body(
+            type_tag<statement::rename_index_action>,
+            node_region region) {
+        auto replacement = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<statement::rename_index_action>(std::move(replacement), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::query> read_body(
+            type_tag<query::query>,
+            node_region region) {
+        auto quantifier = get<std::optional<query::query::quantifier_type>>();
+        auto elements = get<std::vector<std::unique_ptr<ast::query::select_element>>>();
+        auto from = get<std::vector<std::unique_ptr<table::expression>>>();
+        auto where = get<std::unique_ptr<scalar::expression>>();
+        auto group_by = get<std::optional<query::group_by_clause>>();
+        auto having = get<std::unique_ptr<scalar::expression>>();
+        auto order_by = get<std::vector<common::sort_element>>();
+        auto limit = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<query::query>(
+                std::move(quantifier),
+                std::move(elements),
+                std::move(from),
+                std::move(where),
+                std::move(group_by),
+                std::move(having),
+                std::move(order_by),
+                std::move(limit),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::table_reference> read_body(
+            type_tag<query::table_reference>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        return std::make_unique<query::table_reference>(std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::table_value_constructor> read_body(
+            type_tag<query::table_value_constructor>,
+            node_region region) {
+        auto elements = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<query::table_value_constructor>(std::move(elements), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::binary_expression> read_body(
+            type_tag<query::binary_expression>,
+            node_region region) {
+        auto left = get<std::unique_ptr<ast::query::expression>>();
+        auto operator_kind = get<query::binary_expression::operator_kind_type>();
+        auto quantifier = get<std::optional<query::binary_expression::quantifier_type>>();
+        auto corresponding = get<std::optional<query::binary_expression::corresponding_type>>();
+        auto right = get<std::unique_ptr<ast::query::expression>>();
+        return std::make_unique<query::binary_expression>(
+                std::move(left),
+                std::move(operator_kind),
+                std::move(quantifier),
+                std::move(corresponding),
+                std::move(right),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::with_expression> read_body(
+            type_tag<query::with_expression>,
+            node_region region) {
+        auto is_recursive = get<query::with_expression::bool_type>();
+        auto elements = get<std::vector<query::with_element>>();
+        auto expression = get<std::unique_ptr<ast::query::expression>>();
+        return std::make_unique<query::with_expression>(
+                std::move(is_recursive),
+                std::move(elements),
+                std::move(expression),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::select_column> read_body(
+            type_tag<query::select_column>,
+            node_region region) {
+        auto value = get<std::unique_ptr<scalar::expression>>();
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<query::select_column>(std::move(value), std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::select_asterisk> read_body(
+            type_tag<query::select_asterisk>,
+            node_region region) {
+        auto qualifier = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<query::select_asterisk>(std::move(qualifier), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::query::grouping_column> read_body(
+            type_tag<query::grouping_column>,
+            node_region region) {
+        auto column = get<std::unique_ptr<scalar::expression>>();
+        auto collation = get<std::unique_ptr<ast::name::name>>();
+        return std::make_unique<query::grouping_column>(std::move(column), std::move(collation), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::table_reference> read_body(
+            type_tag<table::table_reference>,
+            node_region region) {
+        auto is_only = get<table::table_reference::bool_type>();
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto correlation = get<std::optional<table::table_reference::correlation_type>>();
+        return std::make_unique<table::table_reference>(
+                std::move(is_only),
+                std::move(name),
+                std::move(correlation),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::unnest> read_body(
+            type_tag<table::unnest>,
+            node_region region) {
+        auto expression = get<std::unique_ptr<scalar::expression>>();
+        auto with_ordinality = get<table::unnest::bool_type>();
+        auto correlation = get<table::unnest::correlation_type>();
+        return std::make_unique<table::unnest>(
+                std::move(expression),
+                std::move(with_ordinality),
+                std::move(correlation),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::join> read_body(
+            type_tag<table::join>,
+            node_region region) {
+        auto left = get<std::unique_ptr<table::expression>>();
+        auto operator_kind = get<table::join::operator_kind_type>();
+        auto right = get<std::unique_ptr<table::expression>>();
+        auto specification = get<std::unique_ptr<table::join_specification>>();
+        return std::make_unique<table::join>(
+                std::move(left),
+                std::move(operator_kind),
+                std::move(right),
+                std::move(specification),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::subquery> read_body(
+            type_tag<table::subquery>,
+            node_region region) {
+        auto is_lateral = get<table::subquery::bool_type>();
+        auto expression = get<std::unique_ptr<ast::query::expression>>();
+        auto correlation = get<table::subquery::correlation_type>();
+        return std::make_unique<table::subquery>(
+                std::move(is_lateral),
+                std::move(expression),
+                std::move(correlation),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::apply> read_body(
+            type_tag<table::apply>,
+            node_region region) {
+        auto operand = get<std::unique_ptr<table::expression>>();
+        auto operator_kind = get<std::optional<table::apply::operator_kind_type>>();
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        auto correlation = get<table::apply::correlation_type>();
+        return std::make_unique<table::apply>(
+                std::move(operand),
+                std::move(operator_kind),
+                std::move(name),
+                std::move(arguments),
+                std::move(correlation),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::join_condition> read_body(
+            type_tag<table::join_condition>,
+            node_region region) {
+        auto expression = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<table::join_condition>(std::move(expression), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<table::join_columns> read_body(
+            type_tag<table::join_columns>,
+            node_region region) {
+        auto columns = get<std::vector<std::unique_ptr<ast::name::simple>>>();
+        return std::make_unique<table::join_columns>(std::move(columns), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::literal_expression> read_body(
+            type_tag<scalar::literal_expression>,
+            node_region region) {
+        auto value = get<std::unique_ptr<literal::literal>>();
+        return std::make_unique<scalar::literal_expression>(std::move(value), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::variable_reference> read_body(
+            type_tag<scalar::variable_reference>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        return std::make_unique<scalar::variable_reference>(std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::host_parameter_reference> read_body(
+            type_tag<scalar::host_parameter_reference>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<scalar::host_parameter_reference>(std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::field_reference> read_body(
+            type_tag<scalar::field_reference>,
+            node_region region) {
+        auto value = get<std::unique_ptr<scalar::expression>>();
+        auto operator_kind = get<scalar::field_reference::operator_kind_type>();
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<scalar::field_reference>(
+                std::move(value),
+                std::move(operator_kind),
+                std::move(name),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::case_expression> read_body(
+            type_tag<scalar::case_expression>,
+            node_region region) {
+        auto operand = get<std::unique_ptr<scalar::expression>>();
+        auto when_clauses = get<std::vector<scalar::case_when_clause>>();
+        auto default_result = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::case_expression>(
+                std::move(operand),
+                std::move(when_clauses),
+                std::move(default_result),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::cast_expression> read_body(
+            type_tag<scalar::cast_expression>,
+            node_region region) {
+        auto operator_kind = get<scalar::cast_expression::operator_kind_type>();
+        auto operand = get<std::unique_ptr<scalar::expression>>();
+        auto type = get<std::unique_ptr<ast::type::type>>();
+        return std::make_unique<scalar::cast_expression>(
+                std::move(operator_kind),
+                std::move(operand),
+                std::move(type),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::unary_expression> read_body(
+            type_tag<scalar::unary_expression>,
+            node_region region) {
+        auto operator_kind = get<scalar::unary_expression::operator_kind_type>();
+        auto operand = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::unary_expression>(std::move(operator_kind), std::move(operand), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::binary_expression> read_body(
+            type_tag<scalar::binary_expression>,
+            node_region region) {
+        auto left = get<std::unique_ptr<scalar::expression>>();
+        auto operator_kind = get<scalar::binary_expression::operator_kind_type>();
+        auto right = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::binary_expression>(
+                std::move(left),
+                std::move(operator_kind),
+                std::move(right),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::extract_expression> read_body(
+            type_tag<scalar::extract_expression>,
+            node_region region) {
+        auto field = get<scalar::extract_expression::field_type>();
+        auto subsecond_digits = get<std::optional<scalar::extract_expression::size_type>>();
+        auto operand = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::extract_expression>(
+                std::move(field),
+                std::move(subsecond_digits),
+                std::move(operand),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::trim_expression> read_body(
+            type_tag<scalar::trim_expression>,
+            node_region region) {
+        auto specification = get<std::optional<scalar::trim_expression::specification_type>>();
+        auto character = get<std::unique_ptr<scalar::expression>>();
+        auto source = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::trim_expression>(
+                std::move(specification),
+                std::move(character),
+                std::move(source),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::value_constructor> read_body(
+            type_tag<scalar::value_constructor>,
+            node_region region) {
+        auto operator_kind = get<scalar::value_constructor::operator_kind_type>();
+        auto elements = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::value_constructor>(std::move(operator_kind), std::move(elements), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::subquery> read_body(
+            type_tag<scalar::subquery>,
+            node_region region) {
+        auto query = get<std::unique_ptr<ast::query::expression>>();
+        auto context_kind = get<scalar::subquery::context_kind_type>();
+        return std::make_unique<scalar::subquery>(std::move(query), context_kind, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::comparison_predicate> read_body(
+            type_tag<scalar::comparison_predicate>,
+            node_region region) {
+        auto left = get<std::unique_ptr<scalar::expression>>();
+        auto operator_kind = get<scalar::comparison_predicate::operator_kind_type>();
+        auto right = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::comparison_predicate>(
+                std::move(left),
+                std::move(operator_kind),
+                std::move(right),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::quantified_comparison_predicate> read_body(
+            type_tag<scalar::quantified_comparison_predicate>,
+            node_region region) {
+        auto left = get<std::unique_ptr<scalar::expression>>();
+        auto operator_kind = get<scalar::quantified_comparison_predicate::operator_kind_type>();
+        auto quantifier = get<scalar::quantified_comparison_predicate::quantifier_type>();
+        auto right = get<std::unique_ptr<ast::query::expression>>();
+        return std::make_unique<scalar::quantified_comparison_predicate>(
+                std::move(left),
+                std::move(operator_kind),
+                std::move(quantifier),
+                std::move(right),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::between_predicate> read_body(
+            type_tag<scalar::between_predicate>,
+            node_region region) {
+        auto target = get<std::unique_ptr<scalar::expression>>();
+        auto is_not = get<scalar::between_predicate::bool_type>();
+        auto operator_kind = get<std::optional<scalar::between_predicate::operator_kind_type>>();
+        auto left = get<std::unique_ptr<scalar::expression>>();
+        auto right = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::between_predicate>(
+                std::move(target),
+                std::move(is_not),
+                std::move(operator_kind),
+                std::move(left),
+                std::move(right),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::in_predicate> read_body(
+            type_tag<scalar::in_predicate>,
+            node_region region) {
+        auto left = get<std::unique_ptr<scalar::expression>>();
+        auto is_not = get<scalar::in_predicate::bool_type>();
+        auto right = get<std::unique_ptr<ast::query::expression>>();
+        return std::make_unique<scalar::in_predicate>(std::move(left), std::move(is_not), std::move(right), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::pattern_match_predicate> read_body(
+            type_tag<scalar::pattern_match_predicate>,
+            node_region region) {
+        auto match_value = get<std::unique_ptr<scalar::expression>>();
+        auto is_not = get<scalar::pattern_match_predicate::bool_type>();
+        auto operator_kind = get<scalar::pattern_match_predicate::operator_kind_type>();
+        auto pattern = get<std::unique_ptr<scalar::expression>>();
+        auto escape = get<std::unique_ptr<scalar::expression>>();
+        return std::make_unique<scalar::pattern_match_predicate>(
+                std::move(match_value),
+                std::move(is_not),
+                std::move(operator_kind),
+                std::move(pattern),
+                std::move(escape),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::table_predicate> read_body(
+            type_tag<scalar::table_predicate>,
+            node_region region) {
+        auto operator_kind = get<scalar::table_predicate::operator_kind_type>();
+        auto operand = get<std::unique_ptr<ast::query::expression>>();
+        return std::make_unique<scalar::table_predicate>(std::move(operator_kind), std::move(operand), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::function_invocation> read_body(
+            type_tag<scalar::function_invocation>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::function_invocation>(std::move(name), std::move(arguments), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::builtin_function_invocation> read_body(
+            type_tag<scalar::builtin_function_invocation>,
+            node_region region) {
+        auto function = get<scalar::builtin_function_invocation::function_type>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::builtin_function_invocation>(
+                std::move(function),
+                std::move(arguments),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::builtin_set_function_invocation> read_body(
+            type_tag<scalar::builtin_set_function_invocation>,
+            node_region region) {
+        auto function = get<scalar::builtin_set_function_invocation::function_type>();
+        auto quantifier = get<std::optional<scalar::builtin_set_function_invocation::quantifier_type>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::builtin_set_function_invocation>(
+                std::move(function),
+                std::move(quantifier),
+                std::move(arguments),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::new_invocation> read_body(
+            type_tag<scalar::new_invocation>,
+            node_region region) {
+        auto type = get<std::unique_ptr<ast::type::type>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::new_invocation>(std::move(type), std::move(arguments), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::method_invocation> read_body(
+            type_tag<scalar::method_invocation>,
+            node_region region) {
+        auto value = get<std::unique_ptr<scalar::expression>>();
+        auto operator_kind = get<scalar::method_invocation::operator_kind_type>();
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::method_invocation>(
+                std::move(value),
+                std::move(operator_kind),
+                std::move(name),
+                std::move(arguments),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::static_method_invocation> read_body(
+            type_tag<scalar::static_method_invocation>,
+            node_region region) {
+        auto type = get<std::unique_ptr<ast::type::type>>();
+        auto name = get<std::unique_ptr<ast::name::simple>>();
+        auto arguments = get<std::vector<std::unique_ptr<scalar::expression>>>();
+        return std::make_unique<scalar::static_method_invocation>(
+                std::move(type),
+                std::move(name),
+                std::move(arguments),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::current_of_cursor> read_body(
+            type_tag<scalar::current_of_cursor>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        return std::make_unique<scalar::current_of_cursor>(std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<scalar::placeholder_reference> read_body(
+            type_tag<scalar::placeholder_reference>,
+            node_region region) {
+        auto index = get<scalar::placeholder_reference::index_type>();
+        return std::make_unique<scalar::placeholder_reference>(index, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::boolean> read_body(
+            type_tag<literal::boolean>,
+            node_region region) {
+        auto value = get<literal::boolean::value_type>();
+        return std::make_unique<literal::boolean>(value, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::numeric> read_body(
+            type_tag<literal::numeric>,
+            node_region region) {
+        auto value_kind = get<literal::numeric::value_kind_type>();
+        auto sign = get<std::optional<literal::numeric::sign_type>>();
+        auto unsigned_value = get<literal::numeric::value_type>();
+        return std::make_unique<literal::numeric>(value_kind, std::move(sign), std::move(unsigned_value), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::string> read_body(
+            type_tag<literal::string>,
+            node_region region) {
+        auto value_kind = get<literal::string::value_kind_type>();
+        auto value = get<literal::string::value_type>();
+        auto concatenations = get<literal::string::concatenations_type>();
+        return std::make_unique<literal::string>(
+                std::move(value_kind),
+                std::move(value),
+                std::move(concatenations),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::datetime> read_body(
+            type_tag<literal::datetime>,
+            node_region region) {
+        auto value_kind = get<literal::datetime::value_kind_type>();
+        auto value = get<literal::datetime::value_type>();
+        return std::make_unique<literal::datetime>(std::move(value_kind), std::move(value), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<literal::interval> read_body(
+            type_tag<literal::interval>,
+            node_region region) {
+        auto sign = get<std::optional<literal::interval::sign_type>>();
+        auto value = get<literal::interval::value_type>();
+        return std::make_unique<literal::interval>(std::move(sign), std::move(value), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::simple> read_body(
+            type_tag<type::simple>,
+            node_region region) {
+        auto type_kind = get<type::simple::type_kind_type>();
+        return std::make_unique<type::simple>(type_kind, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::character_string> read_body(
+            type_tag<type::character_string>,
+            node_region region) {
+        auto type_kind = get<type::character_string::type_kind_type>();
+        auto length = get<std::optional<type::character_string::length_type>>();
+        return std::make_unique<type::character_string>(std::move(type_kind), std::move(length), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::bit_string> read_body(
+            type_tag<type::bit_string>,
+            node_region region) {
+        auto type_kind = get<type::bit_string::type_kind_type>();
+        auto length = get<std::optional<type::bit_string::length_type>>();
+        return std::make_unique<type::bit_string>(std::move(type_kind), std::move(length), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::octet_string> read_body(
+            type_tag<type::octet_string>,
+            node_region region) {
+        auto type_kind = get<type::octet_string::type_kind_type>();
+        auto length = get<std::optional<type::octet_string::length_type>>();
+        return std::make_unique<type::octet_string>(std::move(type_kind), std::move(length), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::decimal> read_body(
+            type_tag<type::decimal>,
+            node_region region) {
+        auto type_kind = get<type::decimal::type_kind_type>();
+        auto precision = get<std::optional<type::decimal::precision_type>>();
+        auto scale = get<std::optional<type::decimal::scale_type>>();
+        return std::make_unique<type::decimal>(
+                std::move(type_kind),
+                std::move(precision),
+                std::move(scale),
+                region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::binary_numeric> read_body(
+            type_tag<type::binary_numeric>,
+            node_region region) {
+        auto type_kind = get<type::binary_numeric::type_kind_type>();
+        auto precision = get<std::optional<type::binary_numeric::precision_type>>();
+        return std::make_unique<type::binary_numeric>(std::move(type_kind), std::move(precision), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::datetime> read_body(
+            type_tag<type::datetime>,
+            node_region region) {
+        auto type_kind = get<type::datetime::type_kind_type>();
+        auto has_time_zone = get<std::optional<type::datetime::bool_type>>();
+        return std::make_unique<type::datetime>(std::move(type_kind), std::move(has_time_zone), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::row> read_body(
+            type_tag<type::row>,
+            node_region region) {
+        auto elements = get<std::vector<type::field_definition>>();
+        return std::make_unique<type::row>(std::move(elements), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::user_defined> read_body(
+            type_tag<type::user_defined>,
+            node_region region) {
+        auto name = get<std::unique_ptr<ast::name::name>>();
+        return std::make_unique<type::user_defined>(std::move(name), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::type::collection> read_body(
+            type_tag<type::collection>,
+            node_region region) {
+        auto element = get<std::unique_ptr<ast::type::type>>();
+        auto length = get<std::optional<type::collection::length_type>>();
+        return std::make_unique<type::collection>(std::move(element), std::move(length), region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::name::simple> read_body(
+            type_tag<name::simple>,
+            node_region region) {
+        auto identifier = get<name::simple::identifier_type>();
+        auto identifier_kind = get<name::simple::identifier_kind_type>();
+        return std::make_unique<name::simple>(std::move(identifier), identifier_kind, region);
+    }
+
+    [[nodiscard]] std::unique_ptr<ast::name::qualified> read_body(
+            type_tag<name::qualified>,
+            node_region region) {
+        auto qualifier = get<std::unique_ptr<ast::name::name>>();
+        auto last = get<std::unique_ptr<ast::name::simple>>();
+        return std::make_unique<name::qualified>(std::move(qualifier), std::move(last), region);
+    }
+
+private:
+    std::string_view data_;
+    std::size_t tree_depth_limit_;
+    std::size_t depth_ {};
+    std::size_t position_ { header_size };
+    std::vector<std::string_view> symbols_ {};
+    node_region::position_type last_position_ {};
+    bool failed_ { false };
+
+    void fail() noexcept {
+        failed_ = true;
+        position_ = data_.size();
+    }
+
+    [[nodiscard]] std::nullptr_t broken() noexcept {
+        fail();
+        return nullptr;
+    }
+
+    [[nodiscard]] std::uint64_t get_varint() noexcept {
+        std::uint64_t result = 0;
+        for (std::size_t shift = 0; shift < 64 && position_ < data_.size(); shift += 7) {
+            auto byte = static_cast<std::uint8_t>(data_[position_++]);
+            result |= static_cast<std::uint64_t>(byte & 0x7fU) << shift;
+            if ((byte & 0x80U) == 0) {
+                return result;
+            }
+        }
+        fail();
+        return 0;
+    }
+
+    [[nodiscard]] std::string_view get_symbol() {
+        auto index = get_varint();
+        if (failed_) {
+            return {};
+        }
+        if (index < symbols_.size()) {
+            return symbols_[index];
+        }
+        auto size = get_varint();
+        if (index != symbols_.size() || size > data_.size() - position_) {
+            fail();
+            return {};
+        }
+        auto result = data_.substr(position_, size);
+        position_ += size;
+        symbols_.emplace_back(result);
+        return result;
+    }
+};
+
+} // namespace
+
+std::string encode(compilation_unit const& value) {
+    encoder e {};
+    e.write(value);
+    return e.release();
+}
+
+std::unique_ptr<compilation_unit> decode(
+        std::string_view data,
+        ::takatori::util::maybe_shared_ptr<::takatori::document::document const> document,
+        std::size_t tree_depth_limit) {
+    if (data.size() < header_size
+            || data.substr(0, magic.size()) != magic
+            || static_cast<std::uint8_t>(data[magic.size()]) != version) {
+        return {};
+    }
+    decoder d { data, tree_depth_limit };
+    try {
+        return d.read(std::move(document));
+    } catch (std::invalid_argument const&) {
+        // node constructors reject inconsistent properties
+        return {};
+    }
+}
+
+} // namespace mizugaki::ast::binary_format
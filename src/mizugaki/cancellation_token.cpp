@@ -0,0 +1,49 @@
+#include <mizugaki/cancellation_token.h>
+
+namespace mizugaki {
+
+cancellation_token cancellation_token::create() {
+    cancellation_token result {};
+    result.cancelled_ = std::make_shared<std::atomic_bool>(false);
+    return result;
+}
+
+cancellation_token cancellation_token::with_deadline(time_point_type deadline) {
+    auto result = create();
+    result.deadline_ = deadline;
+    return result;
+}
+
+cancellation_token cancellation_token::with_timeout(duration_type timeout) {
+    return with_deadline(clock::now() + timeout);
+}
+
+void cancellation_token::cancel() const noexcept {
+    if (cancelled_) {
+        cancelled_->store(true, std::memory_order_release);
+    }
+}
+
+bool cancellation_token::cancellable() const noexcept {
+    return static_cast<bool>(cancelled_);
+}
+
+std::optional<cancellation_token::time_point_type> const& cancellation_token::deadline() const noexcept {
+    return deadline_;
+}
+
+cancellation_status cancellation_token::status() const noexcept {
+    if (cancelled_ && cancelled_->load(std::memory_order_acquire)) {
+        return cancellation_status::cancelled;
+    }
+    if (deadline_ && clock::now() >= *deadline_) {
+        return cancellation_status::deadline_exceeded;
+    }
+    return cancellation_status::none;
+}
+
+cancellation_token::operator bool() const noexcept {
+    return cancelled_ || deadline_;
+}
+
+} // namespace mizugaki
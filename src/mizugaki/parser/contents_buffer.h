@@ -0,0 +1,24 @@
+#pragma once
+
+#include <streambuf>
+#include <string_view>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief a read-only stream buffer over the existing memory.
+ * @details This lets the scanner read the document contents directly, without copying them.
+ */
+class contents_buffer : public std::streambuf {
+public:
+    /**
+     * @brief replaces the contents of this buffer.
+     * @param contents the new contents, which must be alive while reading this buffer
+     */
+    void reset(std::string_view contents) noexcept {
+        auto* begin = const_cast<char*>(contents.data()); // NOLINT(*-const-cast): never written via get area
+        setg(begin, begin, begin + contents.size()); // NOLINT(*-pointer-arithmetic)
+    }
+};
+
+} // namespace mizugaki::parser
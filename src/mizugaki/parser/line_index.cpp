@@ -0,0 +1,48 @@
+#include <mizugaki/parser/line_index.h>
+
+#include <algorithm>
+
+namespace mizugaki::parser {
+
+std::string_view line_index::line(std::string_view contents, size_type line_number) const {
+    auto&& lines = offsets(contents);
+    if (line_number == 0 || line_number > lines.size()) {
+        return {};
+    }
+    auto begin = lines[line_number - 1];
+    auto end = line_number < lines.size() ? lines[line_number] - 1 : contents.size();
+    if (end > begin && contents[end - 1] == '\r') {
+        --end;
+    }
+    return contents.substr(begin, end - begin);
+}
+
+::takatori::document::position line_index::position(std::string_view contents, size_type offset) const {
+    offset = std::min(offset, contents.size());
+    auto&& lines = offsets(contents);
+    auto next = std::upper_bound(lines.begin(), lines.end(), offset);
+    auto line_number = static_cast<size_type>(std::distance(lines.begin(), next));
+    return {
+            line_number,
+            offset - *(next - 1) + 1,
+    };
+}
+
+bool line_index::is_built() const noexcept {
+    return built_.load(std::memory_order_acquire);
+}
+
+std::vector<line_index::size_type> const& line_index::offsets(std::string_view contents) const {
+    std::call_once(once_, [&] {
+        // NOTE: std::string_view::find() delegates to memchr(), which is vectorized in the common C libraries
+        offsets_.emplace_back(0);
+        for (auto position = contents.find('\n'); position != std::string_view::npos;
+                position = contents.find('\n', position + 1)) {
+            offsets_.emplace_back(position + 1);
+        }
+        built_.store(true, std::memory_order_release);
+    });
+    return offsets_;
+}
+
+} // namespace mizugaki::parser
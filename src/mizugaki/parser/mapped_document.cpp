@@ -0,0 +1,83 @@
+#include <mizugaki/parser/mapped_document.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <takatori/util/finalizer.h>
+
+namespace mizugaki::parser {
+
+[[noreturn]] static void raise_system_error(std::string const& path, char const* operation) {
+    throw std::system_error(errno, std::generic_category(), path + ": " + operation);
+}
+
+mapped_document::mapped_document(std::string path) :
+    location_ { std::move(path) }
+{
+    int fd = ::open(location_.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(*-vararg)
+    if (fd < 0) {
+        raise_system_error(location_, "open");
+    }
+    ::takatori::util::finalizer closer {
+            [fd] {
+                ::close(fd);
+            },
+    };
+    struct ::stat status {};
+    if (::fstat(fd, &status) != 0) {
+        raise_system_error(location_, "fstat");
+    }
+    size_ = static_cast<size_type>(status.st_size);
+    if (size_ == 0) {
+        // mmap(2) rejects empty mappings
+        return;
+    }
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) { // NOLINT(*-cstyle-cast, performance-no-int-to-ptr)
+        raise_system_error(location_, "mmap");
+    }
+    // the scanner reads the contents from head to tail
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<char const*>(mapped);
+}
+
+mapped_document::~mapped_document() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_); // NOLINT(*-const-cast)
+    }
+}
+
+std::string_view mapped_document::location() const noexcept {
+    return location_;
+}
+
+std::string_view mapped_document::contents(size_type position, size_type size) const noexcept {
+    if (position >= size_) {
+        return {};
+    }
+    return { data_ + position, std::min(size, size_ - position) }; // NOLINT(*-pointer-arithmetic)
+}
+
+mapped_document::size_type mapped_document::size() const noexcept {
+    return size_;
+}
+
+std::string_view mapped_document::line(size_type line_number) const noexcept {
+    return lines_.line(all_contents(), line_number);
+}
+
+::takatori::document::position mapped_document::position(size_type offset) const noexcept {
+    return lines_.position(all_contents(), offset);
+}
+
+std::string_view mapped_document::all_contents() const noexcept {
+    return { data_, size_ };
+}
+
+} // namespace mizugaki::parser
@@ -24,6 +24,7 @@ namespace mizugaki::parser {
 
 using ::takatori::util::unsafe_downcast;
 using ::takatori::util::maybe_shared_ptr;
+using ::takatori::util::optional_ptr;
 
 using document_type = sql_driver::document_type;
 
@@ -41,6 +42,19 @@ sql_driver::sql_driver(maybe_shared_ptr<document_type const> document) noexcept
     document_ { std::move(document) }
 {}
 
+void sql_driver::reset(maybe_shared_ptr<document_type const> document) noexcept {
+    // NOTE: keep the capacity of the individual vectors for the next parse
+    document_ = std::move(document);
+    comments_.clear();
+    comment_separators_.clear();
+    saw_comments_ = false;
+    last_comment_separator_ = {};
+    placeholder_marks_.clear();
+    result_ = {};
+    metrics_.reset();
+    cancellation_counter_ = cancellation_check_interval - 1;
+}
+
 maybe_shared_ptr<document_type const> const& sql_driver::document() const noexcept {
     return document_;
 }
@@ -80,6 +94,17 @@ void sql_driver::error(
 }
 
 void sql_driver::add_comment(location_type location) {
+    switch (comment_mode_) {
+        case sql_parser_comment_mode::all:
+            break;
+        case sql_parser_comment_mode::description:
+            if (!is_description_comment(location)) {
+                return;
+            }
+            break;
+        case sql_parser_comment_mode::none:
+            return;
+    }
     if (!saw_comments_) {
         auto separator = last_comment_separator_ ? last_comment_separator_.begin : 0;
         if (comment_separators_.empty() || comment_separators_.back() < separator) {
@@ -91,6 +116,9 @@ void sql_driver::add_comment(location_type location) {
 }
 
 void sql_driver::add_comment_separator(location_type location) {
+    if (comment_mode_ == sql_parser_comment_mode::none) {
+        return;
+    }
     if (saw_comments_) {
         // NOTE: comment_separators_ are not empty if saw_comments_ is true
         auto separator = location.begin;
@@ -187,37 +215,18 @@ bool& sql_driver::enable_description_comments() noexcept {
 }
 
 sql_driver::location_type sql_driver::leading_description_comment(location_type token) const {
-    if (!enable_description_comments_) {
+    if (!enable_description_comments_ || comment_mode_ == sql_parser_comment_mode::none) {
         return {};
     }
     auto comments = leading_comments(token);
     if (comments.empty()) {
         return {};
     }
-    if (!document_) {
-        return {};
-    }
-    auto&& doc = *document_;
     auto iter = std::find_if(
             comments.rbegin(),
             comments.rend(),
-            [&doc](location_type comment) {
-                if (comment.size() < prefix_description_comment.size() + suffix_description_comment.size()) {
-                    return false;
-                }
-                auto prefix = doc.contents(
-                        comment.begin,
-                        prefix_description_comment.size());
-                if (prefix != prefix_description_comment) {
-                    return false;
-                }
-                auto suffix = doc.contents(
-                        comment.end - suffix_description_comment.size(),
-                        suffix_description_comment.size());
-                if (suffix != suffix_description_comment) {
-                    return false; // NOLINT
-                }
-                return true;
+            [this](location_type comment) {
+                return is_description_comment(comment);
             });
     if (iter == comments.rend()) {
         return {};
@@ -225,6 +234,34 @@ sql_driver::location_type sql_driver::leading_description_comment(location_type
     return *iter;
 }
 
+sql_parser_comment_mode& sql_driver::comment_mode() noexcept {
+    return comment_mode_;
+}
+
+std::optional<sql_parser_metrics>& sql_driver::metrics() noexcept {
+    return metrics_;
+}
+
+bool sql_driver::is_description_comment(location_type comment) const {
+    if (!document_) {
+        return false;
+    }
+    if (comment.size() < prefix_description_comment.size() + suffix_description_comment.size()) {
+        return false;
+    }
+    auto&& doc = *document_;
+    auto prefix = doc.contents(
+            comment.begin,
+            prefix_description_comment.size());
+    if (prefix != prefix_description_comment) {
+        return false;
+    }
+    auto suffix = doc.contents(
+            comment.end - suffix_description_comment.size(),
+            suffix_description_comment.size());
+    return suffix == suffix_description_comment;
+}
+
 std::vector<sql_driver::location_type> sql_driver::comments_in_range(
         location_type::position_type from,
         location_type::position_type to) const {
@@ -407,6 +444,31 @@ sql_driver::try_fold_literal(node_ptr<ast::scalar::expression> expression) {
     return std::move(unary.operand());
 }
 
+optional_ptr<cancellation_token const>& sql_driver::cancellation() noexcept {
+    return cancellation_;
+}
+
+bool sql_driver::check_cancellation_status(location_type location) {
+    using ::takatori::util::string_builder;
+    switch (cancellation_->status()) {
+        case cancellation_status::none:
+            return true;
+        case cancellation_status::cancelled:
+            error(sql_parser_code::cancelled, location,
+                    string_builder {}
+                        << "SQL parser was cancelled"
+                        << string_builder::to_string);
+            return false;
+        case cancellation_status::deadline_exceeded:
+            error(sql_parser_code::deadline_exceeded, location,
+                    string_builder {}
+                        << "SQL parser has exceeded its deadline"
+                        << string_builder::to_string);
+            return false;
+    }
+    std::abort();
+}
+
 bool sql_driver::validate_count(location_type location, std::size_t size, sql_driver::element_kind kind) {
     if (!element_limits_) {
         return true;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
 
 #include <mizugaki/ast/common/vector.h>
 #include <mizugaki/ast/name/name.h>
@@ -9,9 +10,13 @@
 #include <mizugaki/ast/scalar/expression.h>
 #include <mizugaki/ast/statement/statement.h>
 
+#include <mizugaki/cancellation_token.h>
+
 #include <mizugaki/parser/sql_parser_result.h>
 #include <mizugaki/parser/sql_parser_code.h>
+#include <mizugaki/parser/sql_parser_comment_mode.h>
 #include <mizugaki/parser/sql_parser_element_kind.h>
+#include <mizugaki/parser/sql_parser_metrics.h>
 
 namespace mizugaki::parser {
 
@@ -31,6 +36,8 @@ public:
 
     explicit sql_driver(::takatori::util::maybe_shared_ptr<document_type const> document) noexcept;
 
+    void reset(::takatori::util::maybe_shared_ptr<document_type const> document) noexcept;
+
     [[nodiscard]] ::takatori::util::maybe_shared_ptr<document_type const> const& document() const noexcept;
 
     [[nodiscard]] result_type& result() noexcept;
@@ -68,8 +75,33 @@ public:
 
     [[nodiscard]] location_type leading_description_comment(location_type token) const;
 
+    [[nodiscard]] sql_parser_comment_mode& comment_mode() noexcept;
+
+    [[nodiscard]] std::optional<sql_parser_metrics>& metrics() noexcept;
+
+    [[nodiscard]] ::takatori::util::optional_ptr<cancellation_token const>& cancellation() noexcept;
+
+    /**
+     * @brief checks whether the parse operation should be interrupted.
+     * @details This only checks the cancellation token for every cancellation_check_interval tokens,
+     *      including the first one.
+     * @param location the current token location
+     * @return true if the parse operation can continue
+     * @return false if it was interrupted, and then this reports a diagnostic
+     */
+    [[nodiscard]] bool check_cancellation(location_type location) {
+        if (!cancellation_ || ++cancellation_counter_ < cancellation_check_interval) {
+            return true;
+        }
+        cancellation_counter_ = 0;
+        return check_cancellation_status(location);
+    }
+
     template<class T, class... Args>
     [[nodiscard]] node_ptr<T> node(Args&&... args) {
+        if (metrics_) {
+            ++metrics_->node_allocation_count();
+        }
         return std::make_unique<T>(std::forward<Args>(args)...);
     }
 
@@ -131,6 +163,9 @@ public:
 
     [[nodiscard]] bool validate_count(location_type location, std::size_t size, element_kind kind);
 
+    /// @brief the number of tokens between individual cancellation checks.
+    static constexpr std::size_t cancellation_check_interval = 256;
+
 private:
     ::takatori::util::maybe_shared_ptr<document_type const> document_;
     std::vector<location_type> comments_ {};
@@ -143,6 +178,14 @@ private:
     std::size_t max_expected_candidates_ {};
     ::takatori::util::optional_ptr<sql_parser_element_map<std::size_t> const> element_limits_;
     bool enable_description_comments_ { true };
+    sql_parser_comment_mode comment_mode_ { sql_parser_comment_mode::all };
+    std::optional<sql_parser_metrics> metrics_ {};
+    ::takatori::util::optional_ptr<cancellation_token const> cancellation_ {};
+    std::size_t cancellation_counter_ { cancellation_check_interval - 1 };
+
+    [[nodiscard]] bool check_cancellation_status(location_type location);
+
+    [[nodiscard]] bool is_description_comment(location_type comment) const;
 
     [[nodiscard]] std::vector<location_type> comments_in_range(
             location_type::position_type from,
@@ -0,0 +1,86 @@
+#include <mizugaki/parser/sql_fingerprint.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace mizugaki::parser {
+
+namespace {
+
+// FNV-1a 64-bit
+class hasher {
+public:
+    void add(char c) noexcept {
+        value_ ^= static_cast<unsigned char>(c);
+        value_ *= prime;
+    }
+
+    void add(sql_token_kind kind) noexcept {
+        add(static_cast<char>(kind));
+    }
+
+    void add(std::string_view image, bool fold) noexcept {
+        for (auto c : image) {
+            if (fold && c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+            add(c);
+        }
+        // separates the individual tokens
+        add('\0');
+    }
+
+    [[nodiscard]] std::uint64_t value() const noexcept {
+        return value_;
+    }
+
+private:
+    static constexpr std::uint64_t offset_basis = 0xcbf29ce484222325ULL;
+    static constexpr std::uint64_t prime = 0x100000001b3ULL;
+
+    std::uint64_t value_ { offset_basis };
+};
+
+bool is_semicolon(sql_token_stream const& stream, sql_token token) noexcept {
+    return token.kind() == sql_token_kind::symbol && stream.image(token) == ";";
+}
+
+} // namespace
+
+std::uint64_t compute_sql_fingerprint(sql_token_stream& stream) {
+    hasher result {};
+    std::size_t pending_semicolons = 0;
+    while (true) {
+        auto token = stream.next();
+        auto kind = token.kind();
+        if (kind == sql_token_kind::end_of_file) {
+            break;
+        }
+        if (token.is_comment()) {
+            continue;
+        }
+        // semicolons are only hashed if they are not trailing ones
+        if (is_semicolon(stream, token)) {
+            ++pending_semicolons;
+            continue;
+        }
+        for (; pending_semicolons > 0; --pending_semicolons) {
+            result.add(sql_token_kind::symbol);
+            result.add(";", false);
+        }
+        if (token.is_literal()
+                || kind == sql_token_kind::placeholder
+                || kind == sql_token_kind::host_parameter_name) {
+            // all values are considered as the same shape
+            result.add(sql_token_kind::placeholder);
+            continue;
+        }
+        result.add(kind);
+        result.add(
+                stream.image(token),
+                kind == sql_token_kind::keyword || kind == sql_token_kind::regular_identifier);
+    }
+    return result.value();
+}
+
+} // namespace mizugaki::parser
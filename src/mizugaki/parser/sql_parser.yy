@@ -152,6 +152,7 @@
 }
 
 %code {
+    #include <chrono>
     #include <iomanip>
 
     #include <takatori/util/downcast.h>
@@ -166,8 +167,26 @@
 
     using element_kind = sql_driver::element_kind;
 
+    static sql_parser_generated::symbol_type scan(sql_scanner& scanner, sql_driver& driver) {
+        auto&& metrics = driver.metrics();
+        if (!metrics) {
+            return scanner.next_token(driver);
+        }
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+        auto token = scanner.next_token(driver);
+        metrics->scan_time() += clock::now() - start;
+        ++metrics->token_count();
+        return token;
+    }
+
     static sql_parser_generated::symbol_type yylex(sql_scanner& scanner, sql_driver& driver) {
-        return scanner.next_token(driver);
+        auto token = scan(scanner, driver);
+        if (!driver.check_cancellation(token.location)) {
+            // NOTE: the parser aborts without reporting syntax errors, because there are no error recovery rules
+            return sql_parser_generated::make_YYerror(token.location);
+        }
+        return token;
     }
 
     void sql_parser_generated::error(location_type const& location, std::string const& message) {
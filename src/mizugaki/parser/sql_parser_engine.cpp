@@ -0,0 +1,387 @@
+#include "sql_parser_engine.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if YYDEBUG
+#include <iostream>
+#endif // YYDEBUG
+
+#include <takatori/util/exception.h>
+
+#include <mizugaki/ast/statement/kind.h>
+
+#include <mizugaki/parser/sql_fingerprint.h>
+#include <mizugaki/parser/string_document.h>
+
+#include "sql_region_shifter.h"
+#include "sql_tree_validator.h"
+
+namespace mizugaki::parser {
+
+using ::takatori::util::throw_exception;
+
+namespace {
+
+/**
+ * @brief returns the number of leading statements which are not affected by the edit.
+ * @details Each statement is reused only if the edit begins after the head of its next statement,
+ *      that is, neither the statement nor its trailing `;` is changed by the edit.
+ */
+std::size_t count_reusable_statements(
+        sql_parser_options const& options,
+        ast::compilation_unit const& unit,
+        std::string_view contents,
+        std::size_t offset) {
+    // the number of statements is limited while parsing the whole statement list
+    if (options.element_limits()[sql_parser_element_kind::statement] != 0) {
+        return 0;
+    }
+    // placeholders are numbered from the head of the document
+    if (contents.substr(0, offset).find('?') != std::string_view::npos) {
+        return 0;
+    }
+    auto&& statements = unit.statements();
+    std::size_t count = 0;
+    while (count + 1 < statements.size()) {
+        auto current = statements[count]->region();
+        auto next = statements[count + 1]->region();
+        if (!current || !next || next.begin >= offset) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief returns the index of the first trailing statement which is not affected by the edit.
+ * @details Each statement is reused only if the edit ends before the tail of its previous statement,
+ *      that is, neither the statement nor the text between the previous statement is changed by the edit.
+ * @return the index of the first reusable trailing statement
+ * @return the number of statements if there are no such statements
+ */
+std::size_t find_reusable_statements(
+        sql_parser_options const& options,
+        ast::compilation_unit const& unit,
+        std::string_view contents,
+        sql_text_edit const& edit,
+        std::size_t first) {
+    auto&& statements = unit.statements();
+    if (options.element_limits()[sql_parser_element_kind::statement] != 0) {
+        return statements.size();
+    }
+    auto edit_end = edit.offset() + edit.removed();
+    for (std::size_t index = first + 1; index < statements.size(); ++index) {
+        auto previous = statements[index - 1]->region();
+        auto current = statements[index]->region();
+        if (!previous || !current) {
+            break;
+        }
+        if (previous.end >= edit_end) {
+            // placeholders are numbered from the head of the document
+            if (contents.substr(current.begin).find('?') != std::string_view::npos) {
+                break;
+            }
+            return index;
+        }
+    }
+    return statements.size();
+}
+
+std::size_t shift(std::size_t position, std::ptrdiff_t delta) noexcept {
+    return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(position) + delta);
+}
+
+} // namespace
+
+sql_parser_engine::sql_parser_engine() :
+    input_ { std::addressof(buffer_) },
+    scanner_ { input_ },
+    driver_ { {} },
+    parser_ { scanner_, driver_ }
+{}
+
+sql_parser_engine::result_type sql_parser_engine::operator()(
+        sql_parser_options const& options,
+        ::takatori::util::maybe_shared_ptr<document_type const> document) {
+    ast::node_region range { 0, document->size() };
+    if (!options.statistics()) {
+        auto result = parse(options, std::move(document), range);
+        validate(options, result);
+        return result;
+    }
+    auto started = std::chrono::steady_clock::now();
+    auto result = parse(options, document, range);
+    validate(options, result);
+    record(options, std::move(document), result, started);
+    return result;
+}
+
+sql_parser_engine::result_type sql_parser_engine::reparse(
+        sql_parser_options const& options,
+        std::unique_ptr<ast::compilation_unit>& previous,
+        sql_text_edit const& edit) {
+    if (!previous || !previous->document()) {
+        throw_exception(std::invalid_argument("previous compilation unit must have its source document"));
+    }
+    auto&& source = previous->document();
+    if (!edit.applicable(source->contents(0, source->size()))) {
+        throw_exception(std::invalid_argument("text edit is out of the previous source document"));
+    }
+    auto result = reparse(options, *previous, edit);
+    if (result) {
+        // the previous unit may have lost its statements
+        previous.reset();
+    }
+    return result;
+}
+
+sql_parser_engine::result_type sql_parser_engine::reparse(
+        sql_parser_options const& options,
+        ast::compilation_unit& previous,
+        sql_text_edit const& edit) {
+    // NOTE: this must not move out any statements from the previous unit unless the result is valid
+    auto started = std::chrono::steady_clock::now();
+    auto&& source = previous.document();
+    auto contents = source->contents(0, source->size());
+    auto document = std::make_shared<string_document>(std::string { source->location() }, edit.apply(contents));
+
+    auto&& statements = previous.statements();
+    auto first = count_reusable_statements(options, previous, contents, edit.offset());
+    auto last = find_reusable_statements(options, previous, contents, edit, first);
+    if (first == 0 && last == statements.size()) {
+        return operator()(options, std::move(document));
+    }
+
+    // re-parses from the tail of the last reused leading statement, and then the result starts with an empty
+    // statement which is terminated by the `;` of the last reused statement
+    auto delta = static_cast<std::ptrdiff_t>(edit.inserted().size()) - static_cast<std::ptrdiff_t>(edit.removed());
+    auto start = first == 0 ? 0 : statements[first - 1]->region().end;
+    auto tail = last == statements.size() ? contents.size() : statements[last]->region().begin;
+    auto stop = shift(tail, delta);
+    auto result = parse(options, document, { start, stop });
+    if (!result) {
+        if (last == statements.size()) {
+            return result;
+        }
+        // the error may be caused by the truncated text
+        return operator()(options, std::move(document));
+    }
+    auto&& window = result.value()->statements();
+    std::size_t window_first = 0;
+    if (first > 0) {
+        if (window.empty() || window.front()->node_kind() != ast::statement::kind::empty_statement) {
+            // may not occur
+            return operator()(options, std::move(document));
+        }
+        window_first = 1;
+    }
+    if (last < statements.size()) {
+        // the re-parsed statements must be terminated by just one `;`, and the following statement must start
+        // at the same token boundary
+        auto separator_start = window.size() > window_first ? window.back()->region().end : start;
+        if (!is_statement_separator(document, { separator_start, stop })) {
+            return operator()(options, std::move(document));
+        }
+    }
+
+    std::vector<std::unique_ptr<ast::statement::statement>> merged_statements {};
+    merged_statements.reserve(first + (window.size() - window_first) + (statements.size() - last));
+    for (std::size_t i = 0; i < first; ++i) {
+        merged_statements.emplace_back(std::move(statements[i]));
+    }
+    for (std::size_t i = window_first; i < window.size(); ++i) {
+        merged_statements.emplace_back(std::move(window[i]));
+    }
+    sql_region_shifter shifter { delta };
+    for (std::size_t i = last; i < statements.size(); ++i) {
+        shifter(*statements[i]);
+        merged_statements.emplace_back(std::move(statements[i]));
+    }
+
+    auto&& comments = result.value()->comments();
+    std::vector<ast::node_region> merged_comments {};
+    for (auto&& comment : previous.comments()) {
+        if (comment.end > start) {
+            break;
+        }
+        merged_comments.emplace_back(comment);
+    }
+    merged_comments.insert(merged_comments.end(), comments.begin(), comments.end());
+    if (last < statements.size()) {
+        for (auto comment : previous.comments()) {
+            if (comment.begin >= tail) {
+                shifter(comment);
+                merged_comments.emplace_back(comment);
+            }
+        }
+    }
+
+    result.value()->statements() = std::move(merged_statements);
+    result.value()->comments() = std::move(merged_comments);
+    if (auto rejected = validate(options, result)) {
+        // hands the reused statements back to the previous unit
+        auto&& rejected_statements = rejected->statements();
+        for (std::size_t i = 0; i < first; ++i) {
+            statements[i] = std::move(rejected_statements[i]);
+        }
+        sql_region_shifter restorer { -delta };
+        auto offset = rejected_statements.size() - statements.size();
+        for (std::size_t i = last; i < statements.size(); ++i) {
+            restorer(*rejected_statements[offset + i]);
+            statements[i] = std::move(rejected_statements[offset + i]);
+        }
+    }
+    if (options.statistics()) {
+        record(options, std::move(document), result, started);
+    }
+    return result;
+}
+
+sql_parser_engine::result_type sql_parser_engine::parse(
+        sql_parser_options const& options,
+        ::takatori::util::maybe_shared_ptr<document_type const> document,
+        ast::node_region range) {
+    buffer_.reset(document->contents(range.first(), range.size()));
+    input_.clear();
+    if (used_ || range.first() != 0) {
+        scanner_.reset(input_, range.first());
+    }
+    used_ = true;
+
+    driver_.reset(std::move(document));
+    driver_.max_expected_candidates() = options.max_expected_candidates();
+    driver_.element_limits() = options.element_limits();
+    driver_.enable_description_comments() = options.enable_description_comments();
+    driver_.comment_mode() = options.comment_mode();
+    if (options.cancellation()) {
+        driver_.cancellation() = options.cancellation();
+    } else {
+        driver_.cancellation() = {};
+    }
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point started {};
+    if (options.enable_metrics()) {
+        driver_.metrics().emplace();
+        started = clock::now();
+    }
+
+#if YYDEBUG
+    parser_.set_debug_level(static_cast<sql_parser_generated::debug_level_type>(options.debug()));
+    parser_.set_debug_stream(std::cout);
+#endif // YYDEBUG
+
+    parser_.parse();
+    if (auto&& metrics = driver_.metrics()) {
+        metrics->parse_time() = clock::now() - started - metrics->scan_time();
+    }
+
+    driver_.result().metrics() = std::move(driver_.metrics());
+    auto result = std::move(driver_.result());
+
+    // release the document, but keep the buffers
+    buffer_.reset({});
+    driver_.reset({});
+    return result;
+}
+
+std::unique_ptr<ast::compilation_unit> sql_parser_engine::validate(
+        sql_parser_options const& options,
+        result_type& result) {
+    if (!result.has_value()) {
+        return {};
+    }
+    using clock = std::chrono::steady_clock;
+    clock::time_point started {};
+    if (result.metrics()) {
+        started = clock::now();
+    }
+    sql_tree_validator checker {
+            options.tree_node_limit(),
+            options.tree_depth_limit(),
+    };
+    auto diagnostic = checker(*result.value());
+    if (auto&& metrics = result.metrics()) {
+        metrics->validation_time() = clock::now() - started;
+    }
+    if (diagnostic) {
+        auto rejected = std::move(result.value());
+        auto metrics = std::move(result.metrics());
+        result = std::move(*diagnostic);
+        result.metrics() = std::move(metrics);
+        return rejected;
+    }
+    result.max_tree_depth() = checker.last_max_depth();
+    result.tree_node_count() = checker.last_node_count();
+    return {};
+}
+
+void sql_parser_engine::record(
+        sql_parser_options const& options,
+        ::takatori::util::maybe_shared_ptr<document_type const> document,
+        result_type const& result,
+        std::chrono::steady_clock::time_point started) {
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    auto&& stream = token_stream();
+    auto text = document->contents(0, document->size());
+    stream.reset(std::move(document));
+    auto fingerprint = compute_sql_fingerprint(stream);
+    options.statistics()->record_parse(
+            fingerprint,
+            text,
+            std::chrono::duration_cast<statement_statistics::duration_type>(elapsed),
+            result.tree_node_count(),
+            result.max_tree_depth(),
+            result.has_value() ? 0 : 1);
+
+    // release the document, but keep the buffers
+    stream.reset({});
+}
+
+sql_token_stream& sql_parser_engine::token_stream() {
+    if (!token_stream_) {
+        token_stream_ = std::make_unique<sql_token_stream>();
+    }
+    return *token_stream_;
+}
+
+bool sql_parser_engine::is_statement_separator(
+        ::takatori::util::maybe_shared_ptr<document_type const> const& document,
+        ast::node_region range) {
+    // reads beyond the range to ensure that no tokens cross over the end of range
+    auto&& stream = token_stream();
+    stream.reset(document, { range.first(), document->size() });
+    std::size_t separators = 0;
+    bool result = false;
+    while (true) {
+        auto token = stream.next();
+        auto region = token.region();
+        if (region.first() >= range.last()) {
+            result = region.first() == range.last() && separators == 1;
+            break;
+        }
+        if (region.last() > range.last()) {
+            break;
+        }
+        if (token.kind() == sql_token_kind::comment) {
+            continue;
+        }
+        if (token.kind() == sql_token_kind::symbol && stream.image(token) == ";") {
+            ++separators;
+            continue;
+        }
+        break;
+    }
+
+    // release the document, but keep the buffers
+    stream.reset({});
+    return result;
+}
+
+} // namespace mizugaki::parser
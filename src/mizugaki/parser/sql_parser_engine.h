@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <istream>
+#include <memory>
+
+#include <takatori/document/document.h>
+
+#include <takatori/util/maybe_shared_ptr.h>
+
+#include <mizugaki/ast/compilation_unit.h>
+
+#include <mizugaki/parser/sql_parser_options.h>
+#include <mizugaki/parser/sql_parser_result.h>
+#include <mizugaki/parser/sql_text_edit.h>
+#include <mizugaki/parser/sql_token_stream.h>
+#include <mizugaki/parser/sql_parser_generated.hpp>
+#include <mizugaki/parser/sql_driver.h>
+#include <mizugaki/parser/sql_scanner.h>
+
+#include "contents_buffer.h"
+
+namespace mizugaki::parser {
+
+/**
+ * @brief holds the scanner, driver, and parser objects, and reuses them over multiple parse operations.
+ * @details The individual objects keep their buffers between parse operations, like the scanner input buffer,
+ *      comment lists in the driver, and the parser stack.
+ *      This object is not thread-safe.
+ */
+class sql_parser_engine {
+public:
+    /// @brief the source document type.
+    using document_type = ::takatori::document::document;
+
+    /// @brief the result type.
+    using result_type = sql_parser_result;
+
+    /**
+     * @brief creates a new instance.
+     */
+    sql_parser_engine();
+
+    ~sql_parser_engine() = default;
+
+    sql_parser_engine(sql_parser_engine const& other) = delete;
+    sql_parser_engine& operator=(sql_parser_engine const& other) = delete;
+    sql_parser_engine(sql_parser_engine&& other) noexcept = delete;
+    sql_parser_engine& operator=(sql_parser_engine&& other) noexcept = delete;
+
+    /**
+     * @brief parses the contents in the given document.
+     * @param options the parser options
+     * @param document the source document
+     * @return the parsed result
+     */
+    [[nodiscard]] result_type operator()(
+            sql_parser_options const& options,
+            ::takatori::util::maybe_shared_ptr<document_type const> document);
+
+    /**
+     * @brief parses the edited contents of the previous compilation unit.
+     * @param options the parser options
+     * @param previous the previous compilation unit, which must hold its source document,
+     *      and will be released only if the operation was succeeded
+     * @param edit the text edit to the previous source document
+     * @return the parsed result
+     * @throws std::invalid_argument if the previous unit does not have its document, or the edit is out of range
+     * @see sql_parser::reparse()
+     */
+    [[nodiscard]] result_type reparse(
+            sql_parser_options const& options,
+            std::unique_ptr<ast::compilation_unit>& previous,
+            sql_text_edit const& edit);
+
+private:
+    contents_buffer buffer_ {};
+    std::istream input_;
+    sql_scanner scanner_;
+    sql_driver driver_;
+    sql_parser_generated parser_;
+    bool used_ { false };
+    std::unique_ptr<sql_token_stream> token_stream_ {};
+
+    [[nodiscard]] result_type reparse(
+            sql_parser_options const& options,
+            ast::compilation_unit& previous,
+            sql_text_edit const& edit);
+
+    [[nodiscard]] result_type parse(
+            sql_parser_options const& options,
+            ::takatori::util::maybe_shared_ptr<document_type const> document,
+            ast::node_region range);
+
+    [[nodiscard]] sql_token_stream& token_stream();
+
+    [[nodiscard]] bool is_statement_separator(
+            ::takatori::util::maybe_shared_ptr<document_type const> const& document,
+            ast::node_region range);
+
+    // returns the rejected compilation unit if the result is turned into an error
+    static std::unique_ptr<ast::compilation_unit> validate(sql_parser_options const& options, result_type& result);
+
+    void record(
+            sql_parser_options const& options,
+            ::takatori::util::maybe_shared_ptr<document_type const> document,
+            result_type const& result,
+            std::chrono::steady_clock::time_point started);
+};
+
+} // namespace mizugaki::parser
@@ -0,0 +1,54 @@
+#include <mizugaki/parser/sql_parser_metrics.h>
+
+namespace mizugaki::parser {
+
+sql_parser_metrics::duration_type& sql_parser_metrics::scan_time() noexcept {
+    return scan_time_;
+}
+
+sql_parser_metrics::duration_type sql_parser_metrics::scan_time() const noexcept {
+    return scan_time_;
+}
+
+sql_parser_metrics::duration_type& sql_parser_metrics::parse_time() noexcept {
+    return parse_time_;
+}
+
+sql_parser_metrics::duration_type sql_parser_metrics::parse_time() const noexcept {
+    return parse_time_;
+}
+
+sql_parser_metrics::duration_type& sql_parser_metrics::validation_time() noexcept {
+    return validation_time_;
+}
+
+sql_parser_metrics::duration_type sql_parser_metrics::validation_time() const noexcept {
+    return validation_time_;
+}
+
+sql_parser_metrics::size_type& sql_parser_metrics::token_count() noexcept {
+    return token_count_;
+}
+
+sql_parser_metrics::size_type sql_parser_metrics::token_count() const noexcept {
+    return token_count_;
+}
+
+sql_parser_metrics::size_type& sql_parser_metrics::node_allocation_count() noexcept {
+    return node_allocation_count_;
+}
+
+sql_parser_metrics::size_type sql_parser_metrics::node_allocation_count() const noexcept {
+    return node_allocation_count_;
+}
+
+std::ostream& operator<<(std::ostream& out, sql_parser_metrics const& value) {
+    return out << "sql_parser_metrics("
+               << "scan_time=" << value.scan_time_.count() << "ns, "
+               << "parse_time=" << value.parse_time_.count() << "ns, "
+               << "validation_time=" << value.validation_time_.count() << "ns, "
+               << "token_count=" << value.token_count_ << ", "
+               << "node_allocation_count=" << value.node_allocation_count_ << ")";
+}
+
+} // namespace mizugaki::parser
@@ -8,6 +8,31 @@ sql_parser_options::sql_parser_options() :
 
 }
 
+sql_parser_options::sql_parser_options(sql_parser_options const& other) :
+    debug_ { other.debug_ },
+    max_expected_candidates_ { other.max_expected_candidates_ },
+    element_limits_ {
+            other.element_limits_
+                    ? std::make_unique<sql_parser_element_map<size_type>>(*other.element_limits_)
+                    : std::make_unique<sql_parser_element_map<size_type>>(),
+    },
+    tree_node_limit_ { other.tree_node_limit_ },
+    tree_depth_limit_ { other.tree_depth_limit_ },
+    enable_description_comments_ { other.enable_description_comments_ },
+    comment_mode_ { other.comment_mode_ },
+    enable_metrics_ { other.enable_metrics_ },
+    statistics_ { other.statistics_ },
+    cancellation_ { other.cancellation_ }
+{}
+
+sql_parser_options& sql_parser_options::operator=(sql_parser_options const& other) {
+    if (this != &other) {
+        sql_parser_options copy { other };
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
 sql_parser_options::size_type& sql_parser_options::max_expected_candidates() noexcept {
     return max_expected_candidates_;
 }
@@ -48,6 +73,38 @@ bool const& sql_parser_options::enable_description_comments() const noexcept {
     return enable_description_comments_;
 }
 
+sql_parser_comment_mode& sql_parser_options::comment_mode() noexcept {
+    return comment_mode_;
+}
+
+sql_parser_comment_mode const& sql_parser_options::comment_mode() const noexcept {
+    return comment_mode_;
+}
+
+bool& sql_parser_options::enable_metrics() noexcept {
+    return enable_metrics_;
+}
+
+bool const& sql_parser_options::enable_metrics() const noexcept {
+    return enable_metrics_;
+}
+
+cancellation_token& sql_parser_options::cancellation() noexcept {
+    return cancellation_;
+}
+
+cancellation_token const& sql_parser_options::cancellation() const noexcept {
+    return cancellation_;
+}
+
+std::shared_ptr<statement_statistics>& sql_parser_options::statistics() noexcept {
+    return statistics_;
+}
+
+std::shared_ptr<statement_statistics> const& sql_parser_options::statistics() const noexcept {
+    return statistics_;
+}
+
 int& sql_parser_options::debug() noexcept {
     return debug_;
 }
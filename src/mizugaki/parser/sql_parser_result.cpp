@@ -62,5 +62,13 @@ std::size_t sql_parser_result::max_tree_depth() const noexcept {
     return max_tree_depth_;
 }
 
+std::optional<sql_parser_metrics>& sql_parser_result::metrics() noexcept {
+    return metrics_;
+}
+
+std::optional<sql_parser_metrics> const& sql_parser_result::metrics() const noexcept {
+    return metrics_;
+}
+
 } // namespace mizugaki::parser
 
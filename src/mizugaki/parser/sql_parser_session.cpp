@@ -0,0 +1,44 @@
+#include <mizugaki/parser/sql_parser_session.h>
+
+#include <mizugaki/parser/string_document.h>
+
+#include "sql_parser_engine.h"
+
+namespace mizugaki::parser {
+
+sql_parser_session::sql_parser_session(sql_parser_options options) :
+    options_ { std::move(options) },
+    engine_ { std::make_unique<sql_parser_engine>() }
+{}
+
+sql_parser_session::~sql_parser_session() = default;
+
+sql_parser_session::sql_parser_session(sql_parser_session&& other) noexcept = default;
+
+sql_parser_session& sql_parser_session::operator=(sql_parser_session&& other) noexcept = default;
+
+sql_parser_options& sql_parser_session::options() noexcept {
+    return options_;
+}
+
+sql_parser_options const& sql_parser_session::options() const noexcept {
+    return options_;
+}
+
+sql_parser_session::result_type sql_parser_session::operator()(std::string location, std::string contents) {
+    auto document = std::make_shared<string_document>(std::move(location), std::move(contents));
+    return operator()(std::move(document));
+}
+
+sql_parser_session::result_type sql_parser_session::operator()(
+        ::takatori::util::maybe_shared_ptr<document_type const> document) {
+    return (*engine_)(options_, std::move(document));
+}
+
+sql_parser_session::result_type sql_parser_session::reparse(
+        std::unique_ptr<ast::compilation_unit>& previous,
+        sql_text_edit const& edit) {
+    return engine_->reparse(options_, previous, edit);
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,739 @@
+#include "sql_region_shifter.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <mizugaki/ast/common/regioned.h>
+
+#include <mizugaki/ast/statement/dispatch.h>
+#include <mizugaki/ast/query/dispatch.h>
+#include <mizugaki/ast/table/dispatch.h>
+#include <mizugaki/ast/scalar/dispatch.h>
+#include <mizugaki/ast/literal/dispatch.h>
+#include <mizugaki/ast/type/dispatch.h>
+#include <mizugaki/ast/name/dispatch.h>
+
+namespace mizugaki::parser {
+
+namespace {
+
+class engine {
+public:
+    explicit engine(sql_region_shifter const& shifter) noexcept :
+        shifter_ { shifter }
+    {}
+
+    void accept(ast::node_region& region) noexcept {
+        shifter_(region);
+    }
+
+    template<class T>
+    void accept(ast::common::regioned<T>& element) noexcept {
+        accept(element.region());
+    }
+
+    template<class T>
+    void accept(std::optional<T>& element) {
+        if (element) {
+            accept(*element);
+        }
+    }
+
+    template<class T>
+    void accept(std::unique_ptr<T>& element) {
+        if (element) {
+            accept(*element);
+        }
+    }
+
+    template<class T>
+    void accept(std::vector<T>& elements) {
+        for (auto&& element : elements) {
+            accept(element);
+        }
+    }
+
+    void accept(ast::statement::statement& element) {
+        accept(element.region());
+        ast::statement::dispatch(*this, element);
+    }
+
+    void accept(ast::statement::table_element& element) {
+        accept(element.region());
+        ast::statement::dispatch(*this, element);
+    }
+
+    void accept(ast::statement::constraint& element) {
+        accept(element.region());
+        ast::statement::dispatch(*this, element);
+    }
+
+    void accept(ast::statement::alter_table_action& element) {
+        accept(element.region());
+        ast::statement::dispatch(*this, element);
+    }
+
+    void accept(ast::statement::alter_index_action& element) {
+        accept(element.region());
+        ast::statement::dispatch(*this, element);
+    }
+
+    void accept(ast::query::expression& element) {
+        accept(element.region());
+        ast::query::dispatch(*this, element);
+    }
+
+    void accept(ast::query::select_element& element) {
+        accept(element.region());
+        ast::query::dispatch(*this, element);
+    }
+
+    void accept(ast::query::grouping_element& element) {
+        accept(element.region());
+        ast::query::dispatch(*this, element);
+    }
+
+    void accept(ast::table::expression& element) {
+        accept(element.region());
+        ast::table::dispatch(*this, element);
+    }
+
+    void accept(ast::table::join_specification& element) {
+        accept(element.region());
+        ast::table::dispatch(*this, element);
+    }
+
+    void accept(ast::scalar::expression& element) {
+        accept(element.region());
+        ast::scalar::dispatch(*this, element);
+    }
+
+    void accept(ast::literal::literal& element) {
+        accept(element.region());
+        ast::literal::dispatch(*this, element);
+    }
+
+    void accept(ast::type::type& element) {
+        accept(element.region());
+        ast::type::dispatch(*this, element);
+    }
+
+    void accept(ast::name::name& element) {
+        accept(element.region());
+        ast::name::dispatch(*this, element);
+    }
+
+    void accept(ast::name::simple& element) {
+        accept(element.region());
+        operator()(element);
+    }
+
+    void accept(ast::common::sort_element& element) {
+        accept(element.region());
+        accept(element.key());
+        accept(element.collation());
+        accept(element.direction());
+        accept(element.null_location());
+    }
+
+    void accept(ast::common::target_element& element) {
+        accept(element.region());
+        accept(element.target());
+        accept(element.indicator());
+    }
+
+    void accept(ast::query::corresponding_clause& element) {
+        accept(element.region());
+        accept(element.column_names());
+    }
+
+    void accept(ast::query::group_by_clause& element) {
+        accept(element.region());
+        accept(element.elements());
+    }
+
+    void accept(ast::query::with_element& element) {
+        accept(element.region());
+        accept(element.name());
+        accept(element.column_names());
+        accept(element.expression());
+    }
+
+    void accept(ast::scalar::case_when_clause& element) {
+        accept(element.region());
+        accept(element.when());
+        accept(element.result());
+    }
+
+    void accept(ast::statement::column_constraint_definition& element) {
+        accept(element.region());
+        accept(element.name());
+        accept(element.body());
+    }
+
+    void accept(ast::statement::privilege_action& element) {
+        accept(element.region());
+        accept(element.action_kind());
+    }
+
+    void accept(ast::statement::privilege_object& element) {
+        accept(element.region());
+        accept(element.object_kind());
+        accept(element.object_name());
+    }
+
+    void accept(ast::statement::privilege_user& element) {
+        accept(element.region());
+        accept(element.authorization_identifier());
+    }
+
+    void accept(ast::statement::set_element& element) {
+        accept(element.region());
+        accept(element.target());
+        accept(element.value());
+    }
+
+    void accept(ast::statement::storage_parameter& element) {
+        accept(element.region());
+        accept(element.name());
+        accept(element.value());
+    }
+
+    void accept(ast::table::correlation_clause& element) {
+        accept(element.region());
+        accept(element.correlation_name());
+        accept(element.column_names());
+    }
+
+    void accept(ast::type::field_definition& element) {
+        accept(element.region());
+        accept(element.name());
+        accept(element.type());
+        accept(element.collation());
+    }
+
+    void operator()(ast::statement::empty_statement& element) {
+        (void) element;
+    }
+
+    void operator()(ast::statement::select_statement& element) {
+        accept(element.expression());
+        accept(element.targets());
+    }
+
+    void operator()(ast::statement::insert_statement& element) {
+        accept(element.table_name());
+        accept(element.columns());
+        accept(element.expression());
+        accept(element.options());
+    }
+
+    void operator()(ast::statement::update_statement& element) {
+        accept(element.table_name());
+        accept(element.alias_name());
+        accept(element.elements());
+        accept(element.where());
+    }
+
+    void operator()(ast::statement::delete_statement& element) {
+        accept(element.table_name());
+        accept(element.alias_name());
+        accept(element.where());
+    }
+
+    void operator()(ast::statement::table_definition& element) {
+        accept(element.name());
+        accept(element.elements());
+        accept(element.options());
+        accept(element.parameters());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::index_definition& element) {
+        accept(element.name());
+        accept(element.table_name());
+        accept(element.keys());
+        accept(element.values());
+        accept(element.predicate());
+        accept(element.options());
+        accept(element.parameters());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::view_definition& element) {
+        accept(element.name());
+        accept(element.columns());
+        accept(element.query());
+        accept(element.options());
+        accept(element.parameters());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::sequence_definition& element) {
+        accept(element.name());
+        accept(element.type());
+        accept(element.initial_value());
+        accept(element.increment_value());
+        accept(element.min_value());
+        accept(element.max_value());
+        accept(element.owner());
+        accept(element.options());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::schema_definition& element) {
+        accept(element.name());
+        accept(element.user_name());
+        accept(element.elements());
+        accept(element.options());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::alter_table_statement& element) {
+        accept(element.if_exists());
+        accept(element.name());
+        accept(element.action());
+    }
+
+    void operator()(ast::statement::alter_index_statement& element) {
+        accept(element.if_exists());
+        accept(element.name());
+        accept(element.action());
+    }
+
+    void operator()(ast::statement::drop_statement& element) {
+        accept(element.statement_kind());
+        accept(element.name());
+        accept(element.options());
+    }
+
+    void operator()(ast::statement::truncate_table_statement& element) {
+        accept(element.name());
+        accept(element.identity_column_option());
+    }
+
+    void operator()(ast::statement::grant_privilege_statement& element) {
+        accept(element.actions());
+        accept(element.objects());
+        accept(element.users());
+    }
+
+    void operator()(ast::statement::revoke_privilege_statement& element) {
+        accept(element.actions());
+        accept(element.objects());
+        accept(element.users());
+    }
+
+    void operator()(ast::statement::column_definition& element) {
+        accept(element.name());
+        accept(element.type());
+        accept(element.constraints());
+        accept(element.description());
+    }
+
+    void operator()(ast::statement::table_constraint_definition& element) {
+        accept(element.name());
+        accept(element.body());
+    }
+
+    void operator()(ast::statement::simple_constraint& element) {
+        accept(element.constraint_kind());
+    }
+
+    void operator()(ast::statement::expression_constraint& element) {
+        accept(element.constraint_kind());
+        accept(element.expression());
+    }
+
+    void operator()(ast::statement::key_constraint& element) {
+        accept(element.constraint_kind());
+        accept(element.key());
+        accept(element.values());
+        accept(element.parameters());
+    }
+
+    void operator()(ast::statement::referential_constraint& element) {
+        accept(element.columns());
+        accept(element.target());
+        accept(element.target_columns());
+        accept(element.on_update());
+        accept(element.on_delete());
+    }
+
+    void operator()(ast::statement::identity_constraint& element) {
+        accept(element.generation());
+        accept(element.initial_value());
+        accept(element.increment_value());
+        accept(element.min_value());
+        accept(element.max_value());
+        accept(element.cycle());
+    }
+
+    void operator()(ast::statement::rename_table_action& element) {
+        accept(element.replacement());
+    }
+
+    void operator()(ast::statement::rename_column_action& element) {
+        accept(element.if_exists());
+        accept(element.column_name());
+        accept(element.replacement());
+    }
+
+    void operator()(ast::statement::rename_index_action& element) {
+        accept(element.replacement());
+    }
+
+    void operator()(ast::query::query& element) {
+        accept(element.quantifier());
+        accept(element.elements());
+        accept(element.from());
+        accept(element.where());
+        accept(element.group_by());
+        accept(element.having());
+        accept(element.order_by());
+        accept(element.limit());
+    }
+
+    void operator()(ast::query::table_reference& element) {
+        accept(element.name());
+    }
+
+    void operator()(ast::query::table_value_constructor& element) {
+        accept(element.elements());
+    }
+
+    void operator()(ast::query::binary_expression& element) {
+        accept(element.left());
+        accept(element.operator_kind());
+        accept(element.quantifier());
+        accept(element.corresponding());
+        accept(element.right());
+    }
+
+    void operator()(ast::query::with_expression& element) {
+        accept(element.is_recursive());
+        accept(element.elements());
+        accept(element.expression());
+    }
+
+    void operator()(ast::query::select_column& element) {
+        accept(element.value());
+        accept(element.name());
+    }
+
+    void operator()(ast::query::select_asterisk& element) {
+        accept(element.qualifier());
+    }
+
+    void operator()(ast::query::grouping_column& element) {
+        accept(element.column());
+        accept(element.collation());
+    }
+
+    void operator()(ast::table::table_reference& element) {
+        accept(element.is_only());
+        accept(element.name());
+        accept(element.correlation());
+    }
+
+    void operator()(ast::table::unnest& element) {
+        accept(element.expression());
+        accept(element.with_ordinality());
+        accept(element.correlation());
+    }
+
+    void operator()(ast::table::join& element) {
+        accept(element.left());
+        accept(element.operator_kind());
+        accept(element.right());
+        accept(element.specification());
+    }
+
+    void operator()(ast::table::subquery& element) {
+        accept(element.is_lateral());
+        accept(element.expression());
+        accept(element.correlation());
+    }
+
+    void operator()(ast::table::apply& element) {
+        accept(element.operand());
+        accept(element.operator_kind());
+        accept(element.name());
+        accept(element.arguments());
+        accept(element.correlation());
+    }
+
+    void operator()(ast::table::join_condition& element) {
+        accept(element.expression());
+    }
+
+    void operator()(ast::table::join_columns& element) {
+        accept(element.columns());
+    }
+
+    void operator()(ast::scalar::literal_expression& element) {
+        accept(element.value());
+    }
+
+    void operator()(ast::scalar::variable_reference& element) {
+        accept(element.name());
+    }
+
+    void operator()(ast::scalar::host_parameter_reference& element) {
+        accept(element.name());
+    }
+
+    void operator()(ast::scalar::field_reference& element) {
+        accept(element.value());
+        accept(element.operator_kind());
+        accept(element.name());
+    }
+
+    void operator()(ast::scalar::case_expression& element) {
+        accept(element.operand());
+        accept(element.when_clauses());
+        accept(element.default_result());
+    }
+
+    void operator()(ast::scalar::cast_expression& element) {
+        accept(element.operator_kind());
+        accept(element.operand());
+        accept(element.type());
+    }
+
+    void operator()(ast::scalar::unary_expression& element) {
+        accept(element.operator_kind());
+        accept(element.operand());
+    }
+
+    void operator()(ast::scalar::binary_expression& element) {
+        accept(element.left());
+        accept(element.operator_kind());
+        accept(element.right());
+    }
+
+    void operator()(ast::scalar::extract_expression& element) {
+        accept(element.field());
+        accept(element.subsecond_digits());
+        accept(element.operand());
+    }
+
+    void operator()(ast::scalar::trim_expression& element) {
+        accept(element.specification());
+        accept(element.character());
+        accept(element.source());
+    }
+
+    void operator()(ast::scalar::value_constructor& element) {
+        accept(element.operator_kind());
+        accept(element.elements());
+    }
+
+    void operator()(ast::scalar::subquery& element) {
+        accept(element.query());
+    }
+
+    void operator()(ast::scalar::comparison_predicate& element) {
+        accept(element.left());
+        accept(element.operator_kind());
+        accept(element.right());
+    }
+
+    void operator()(ast::scalar::quantified_comparison_predicate& element) {
+        accept(element.left());
+        accept(element.operator_kind());
+        accept(element.quantifier());
+        accept(element.right());
+    }
+
+    void operator()(ast::scalar::between_predicate& element) {
+        accept(element.target());
+        accept(element.is_not());
+        accept(element.operator_kind());
+        accept(element.left());
+        accept(element.right());
+    }
+
+    void operator()(ast::scalar::in_predicate& element) {
+        accept(element.left());
+        accept(element.is_not());
+        accept(element.right());
+    }
+
+    void operator()(ast::scalar::pattern_match_predicate& element) {
+        accept(element.match_value());
+        accept(element.is_not());
+        accept(element.operator_kind());
+        accept(element.pattern());
+        accept(element.escape());
+    }
+
+    void operator()(ast::scalar::table_predicate& element) {
+        accept(element.operator_kind());
+        accept(element.operand());
+    }
+
+    void operator()(ast::scalar::function_invocation& element) {
+        accept(element.name());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::builtin_function_invocation& element) {
+        accept(element.function());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::builtin_set_function_invocation& element) {
+        accept(element.function());
+        accept(element.quantifier());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::new_invocation& element) {
+        accept(element.type());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::method_invocation& element) {
+        accept(element.value());
+        accept(element.operator_kind());
+        accept(element.name());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::static_method_invocation& element) {
+        accept(element.type());
+        accept(element.name());
+        accept(element.arguments());
+    }
+
+    void operator()(ast::scalar::current_of_cursor& element) {
+        accept(element.name());
+    }
+
+    void operator()(ast::scalar::placeholder_reference& element) {
+        (void) element;
+    }
+
+    void operator()(ast::literal::boolean& element) {
+        (void) element;
+    }
+
+    void operator()(ast::literal::numeric& element) {
+        accept(element.sign());
+        accept(element.unsigned_value());
+    }
+
+    void operator()(ast::literal::string& element) {
+        accept(element.value_kind());
+        accept(element.value());
+        accept(element.concatenations());
+    }
+
+    void operator()(ast::literal::datetime& element) {
+        accept(element.value_kind());
+        accept(element.value());
+    }
+
+    void operator()(ast::literal::interval& element) {
+        accept(element.sign());
+        accept(element.value());
+    }
+
+    void operator()(ast::literal::null& element) {
+        (void) element;
+    }
+
+    void operator()(ast::literal::empty& element) {
+        (void) element;
+    }
+
+    void operator()(ast::literal::default_& element) {
+        (void) element;
+    }
+
+    void operator()(ast::type::simple& element) {
+        (void) element;
+    }
+
+    void operator()(ast::type::character_string& element) {
+        accept(element.type_kind());
+        accept(element.length());
+    }
+
+    void operator()(ast::type::bit_string& element) {
+        accept(element.type_kind());
+        accept(element.length());
+    }
+
+    void operator()(ast::type::octet_string& element) {
+        accept(element.type_kind());
+        accept(element.length());
+    }
+
+    void operator()(ast::type::decimal& element) {
+        accept(element.type_kind());
+        accept(element.precision());
+        accept(element.scale());
+    }
+
+    void operator()(ast::type::binary_numeric& element) {
+        accept(element.type_kind());
+        accept(element.precision());
+    }
+
+    void operator()(ast::type::datetime& element) {
+        accept(element.type_kind());
+        accept(element.has_time_zone());
+    }
+
+    void operator()(ast::type::interval& element) {
+        (void) element;
+    }
+
+    void operator()(ast::type::row& element) {
+        accept(element.elements());
+    }
+
+    void operator()(ast::type::user_defined& element) {
+        accept(element.name());
+    }
+
+    void operator()(ast::type::collection& element) {
+        accept(element.element());
+        accept(element.length());
+    }
+
+    void operator()(ast::name::simple& element) {
+        (void) element;
+    }
+
+    void operator()(ast::name::qualified& element) {
+        accept(element.qualifier());
+        accept(element.last());
+    }
+
+private:
+    sql_region_shifter const& shifter_;
+};
+
+} // namespace
+
+void sql_region_shifter::operator()(ast::node_region& region) const noexcept {
+    if (!region || delta_ == 0) {
+        return;
+    }
+    region.begin = static_cast<position_type>(static_cast<difference_type>(region.begin) + delta_);
+    region.end = static_cast<position_type>(static_cast<difference_type>(region.end) + delta_);
+}
+
+void sql_region_shifter::operator()(ast::statement::statement& element) const {
+    if (delta_ == 0) {
+        return;
+    }
+    engine e { *this };
+    e.accept(element);
+}
+
+} // namespace mizugaki::parser
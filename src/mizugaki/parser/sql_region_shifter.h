@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+#include <mizugaki/ast/node_region.h>
+#include <mizugaki/ast/statement/statement.h>
+
+namespace mizugaki::parser {
+
+/**
+ * @brief moves every region in SQL AST by a fixed distance.
+ * @details This is used to reuse statements which follow an edited range of the source document:
+ *      the regions of their nodes, regioned properties, and descriptions are rebased onto the edited document.
+ */
+class sql_region_shifter {
+public:
+    /// @brief the position type.
+    using position_type = ast::node_region::position_type;
+
+    /// @brief the distance type.
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * @brief creates a new instance.
+     * @param delta the distance to move regions, may be negative
+     */
+    explicit constexpr sql_region_shifter(difference_type delta) noexcept :
+        delta_ { delta }
+    {}
+
+    /**
+     * @brief returns the distance to move regions.
+     * @return the distance
+     */
+    [[nodiscard]] constexpr difference_type delta() const noexcept {
+        return delta_;
+    }
+
+    /**
+     * @brief moves the given region.
+     * @details invalid regions are left as is.
+     * @param region the target region
+     */
+    void operator()(ast::node_region& region) const noexcept;
+
+    /**
+     * @brief moves all regions in the given statement, including the statement itself.
+     * @param element the target statement
+     */
+    void operator()(ast::statement::statement& element) const;
+
+private:
+    difference_type delta_;
+};
+
+} // namespace mizugaki::parser
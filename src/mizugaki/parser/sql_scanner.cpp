@@ -29,7 +29,15 @@ sql_scanner::location_type sql_scanner::location(bool eof) noexcept {
     return { cursor_ - (eof ? 0 : yyleng), cursor_ };
 }
 
+bool& sql_scanner::enable_image() noexcept {
+    return enable_image_;
+}
+
 ast::common::chars sql_scanner::get_image(sql_driver const&) {
+    if (!enable_image_) {
+        // the token consumer only requires the token regions
+        return {};
+    }
     std::string image {
             yytext,
             static_cast<std::size_t>(yyleng),
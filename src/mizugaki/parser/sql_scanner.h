@@ -32,8 +32,12 @@ public:
 
     explicit sql_scanner(std::istream& input);
 
+    void reset(std::istream& input, std::size_t offset = 0);
+
     [[nodiscard]] value_type next_token(::mizugaki::parser::sql_driver& driver);
 
+    [[nodiscard]] bool& enable_image() noexcept;
+
 protected:
     void LexerError(char const* msg) override;
 
@@ -42,6 +46,7 @@ private:
 
     std::size_t cursor_ {};
     std::size_t comment_begin_ { npos };
+    bool enable_image_ { true };
 
     void on_token(::mizugaki::parser::sql_driver& driver, bool eof = false);
 
@@ -514,3 +514,11 @@ UTF8_CHAR {ASCII}|{UTF8_2}{U}|{UTF8_3}{U}{U}|{UTF8_4}{U}{U}{U}
 }
 
 %%
+
+void ::mizugaki::parser::sql_scanner::reset(std::istream& input, std::size_t offset) {
+    // NOTE: yyrestart() keeps the current input buffer, and only discards its contents
+    yyrestart(std::addressof(input));
+    BEGIN(INITIAL);
+    cursor_ = offset;
+    comment_begin_ = npos;
+}
@@ -0,0 +1,36 @@
+#include <mizugaki/parser/sql_text_edit.h>
+
+namespace mizugaki::parser {
+
+sql_text_edit::sql_text_edit(size_type offset, size_type removed, std::string inserted) noexcept :
+    offset_ { offset },
+    removed_ { removed },
+    inserted_ { std::move(inserted) }
+{}
+
+sql_text_edit::size_type sql_text_edit::offset() const noexcept {
+    return offset_;
+}
+
+sql_text_edit::size_type sql_text_edit::removed() const noexcept {
+    return removed_;
+}
+
+std::string const& sql_text_edit::inserted() const noexcept {
+    return inserted_;
+}
+
+bool sql_text_edit::applicable(std::string_view contents) const noexcept {
+    return offset_ <= contents.size() && removed_ <= contents.size() - offset_;
+}
+
+std::string sql_text_edit::apply(std::string_view contents) const {
+    std::string result {};
+    result.reserve(contents.size() - removed_ + inserted_.size());
+    result.append(contents.substr(0, offset_));
+    result.append(inserted_);
+    result.append(contents.substr(offset_ + removed_));
+    return result;
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,198 @@
+#include <mizugaki/parser/sql_token_stream.h>
+
+#include <algorithm>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include <mizugaki/parser/sql_parser_generated.hpp>
+#include <mizugaki/parser/sql_driver.h>
+#include <mizugaki/parser/sql_scanner.h>
+
+#include "contents_buffer.h"
+
+namespace mizugaki::parser {
+
+using ::takatori::util::maybe_shared_ptr;
+
+namespace {
+
+using symbol_kind_type = sql_scanner::symbol_kind_type;
+
+sql_token_kind classify(symbol_kind_type kind) noexcept {
+    using k = symbol_kind_type;
+    switch (kind) {
+        case k::S_REGULAR_IDENTIFIER:
+        case k::S_REGULAR_IDENTIFIER_RESTRICTED:
+            return sql_token_kind::regular_identifier;
+        case k::S_DELIMITED_IDENTIFIER:
+        case k::S_DELIMITED_IDENTIFIER_RESTRICTED:
+            return sql_token_kind::delimited_identifier;
+        case k::S_HOST_PARAMETER_NAME: return sql_token_kind::host_parameter_name;
+        case k::S_QUESTION_MARK: return sql_token_kind::placeholder;
+        case k::S_UNSIGNED_INTEGER: return sql_token_kind::unsigned_integer;
+        case k::S_EXACT_NUMERIC_LITERAL: return sql_token_kind::exact_numeric_literal;
+        case k::S_APPROXIMATE_NUMERIC_LITERAL: return sql_token_kind::approximate_numeric_literal;
+        case k::S_CHARACTER_STRING_LITERAL: return sql_token_kind::character_string_literal;
+        case k::S_HEX_STRING_LITERAL: return sql_token_kind::hex_string_literal;
+
+        case k::S_PERCENT:
+        case k::S_AMPERSAND:
+        case k::S_QUOTE:
+        case k::S_LEFT_PAREN:
+        case k::S_RIGHT_PAREN:
+        case k::S_ASTERISK:
+        case k::S_PLUS_SIGN:
+        case k::S_COMMA:
+        case k::S_MINUS_SIGN:
+        case k::S_PERIOD:
+        case k::S_SOLIDUS:
+        case k::S_COLON:
+        case k::S_SEMICOLON:
+        case k::S_LESS_THAN_OPERATOR:
+        case k::S_EQUALS_OPERATOR:
+        case k::S_GREATER_THAN_OPERATOR:
+        case k::S_LEFT_BRACKET:
+        case k::S_RIGHT_BRACKET:
+        case k::S_CIRCUMFLEX:
+        case k::S_UNDERSCORE:
+        case k::S_VERTICAL_BAR:
+        case k::S_LEFT_BRACE:
+        case k::S_RIGHT_BRACE:
+        case k::S_NOT_EQUALS_OPERATOR:
+        case k::S_NOT_EQUALS_ALTERNATIVE_OPERATOR:
+        case k::S_GREATER_THAN_OR_EQUALS_OPERATOR:
+        case k::S_LESS_THAN_OR_EQUALS_OPERATOR:
+        case k::S_CONCATENATION_OPERATOR:
+        case k::S_RIGHT_ARROW:
+        case k::S_DOUBLE_COLON:
+        case k::S_CONTAINS_OPERATOR:
+        case k::S_IS_CONTAINED_BY_OPERATOR:
+        case k::S_OVERLAPS_OPERATOR:
+        case k::S_DOT_ASTERISK:
+            return sql_token_kind::symbol;
+
+        case k::S_UNCLOSED_BLOCK_COMMENT: return sql_token_kind::unclosed_comment;
+        case k::S_ERROR: return sql_token_kind::error;
+        case k::S_YYEOF: return sql_token_kind::end_of_file;
+
+        default:
+            // the rest terminal symbols are keywords, including "UNION JOIN" and "OUTER APPLY"
+            return sql_token_kind::keyword;
+    }
+}
+
+} // namespace
+
+class sql_token_stream::impl {
+public:
+    impl() :
+        input_ { std::addressof(buffer_) },
+        scanner_ { input_ },
+        driver_ { {} }
+    {
+        scanner_.enable_image() = false;
+        driver_.enable_description_comments() = false;
+    }
+
+    void reset(maybe_shared_ptr<document_type const> document, ast::node_region range) {
+        buffer_.reset(document ? document->contents(range.first(), range.size()) : std::string_view {});
+        input_.clear();
+        if (used_ || range.first() != 0) {
+            scanner_.reset(input_, range.first());
+        }
+        used_ = true;
+        end_ = document ? std::min(range.last(), document->size()) : 0;
+        finished_ = !document;
+        next_comment_ = 0;
+        pending_.reset();
+        driver_.reset(std::move(document));
+    }
+
+    [[nodiscard]] maybe_shared_ptr<document_type const> const& document() const noexcept {
+        return driver_.document();
+    }
+
+    [[nodiscard]] sql_token next() {
+        auto&& comments = driver_.comments();
+        if (next_comment_ < comments.size()) {
+            return { sql_token_kind::comment, comments[next_comment_++] };
+        }
+        if (pending_) {
+            auto token = *pending_;
+            pending_.reset();
+            return token;
+        }
+        if (finished_) {
+            return { sql_token_kind::end_of_file, { end_, end_ } };
+        }
+        auto symbol = scanner_.next_token(driver_);
+        sql_token token { classify(symbol.kind()), symbol.location };
+        if (token.kind() == sql_token_kind::end_of_file || token.kind() == sql_token_kind::unclosed_comment) {
+            finished_ = true;
+        }
+
+        // comments are always completed before the current token
+        if (next_comment_ < comments.size()) {
+            pending_ = token;
+            return { sql_token_kind::comment, comments[next_comment_++] };
+        }
+        return token;
+    }
+
+private:
+    contents_buffer buffer_ {};
+    std::istream input_;
+    sql_scanner scanner_;
+    sql_driver driver_;
+    bool used_ { false };
+    bool finished_ { true };
+    std::size_t end_ {};
+    std::size_t next_comment_ {};
+    std::optional<sql_token> pending_ {};
+};
+
+sql_token_stream::sql_token_stream() :
+    impl_ { std::make_unique<impl>() }
+{}
+
+sql_token_stream::sql_token_stream(maybe_shared_ptr<document_type const> document) :
+    sql_token_stream {}
+{
+    reset(std::move(document));
+}
+
+sql_token_stream::~sql_token_stream() = default;
+
+sql_token_stream::sql_token_stream(sql_token_stream&& other) noexcept = default;
+
+sql_token_stream& sql_token_stream::operator=(sql_token_stream&& other) noexcept = default;
+
+void sql_token_stream::reset(maybe_shared_ptr<document_type const> document) {
+    auto size = document ? document->size() : 0;
+    impl_->reset(std::move(document), { 0, size });
+}
+
+void sql_token_stream::reset(maybe_shared_ptr<document_type const> document, ast::node_region range) {
+    impl_->reset(std::move(document), range);
+}
+
+maybe_shared_ptr<sql_token_stream::document_type const> const& sql_token_stream::document() const noexcept {
+    return impl_->document();
+}
+
+sql_token sql_token_stream::next() {
+    return impl_->next();
+}
+
+std::string_view sql_token_stream::image(sql_token token) const noexcept {
+    auto&& source = impl_->document();
+    if (!source) {
+        return {};
+    }
+    auto region = token.region();
+    return source->contents(region.first(), region.size());
+}
+
+} // namespace mizugaki::parser
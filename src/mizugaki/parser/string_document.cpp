@@ -0,0 +1,37 @@
+#include <mizugaki/parser/string_document.h>
+
+namespace mizugaki::parser {
+
+string_document::string_document(std::string location, std::string contents) noexcept :
+    location_ { std::move(location) },
+    contents_ { std::move(contents) }
+{}
+
+std::string_view string_document::location() const noexcept {
+    return location_;
+}
+
+std::string_view string_document::contents(size_type position, size_type size) const noexcept {
+    if (position >= contents_.size()) {
+        return {};
+    }
+    return std::string_view { contents_ }.substr(position, size);
+}
+
+string_document::size_type string_document::size() const noexcept {
+    return contents_.size();
+}
+
+std::string_view string_document::line(size_type line_number) const noexcept {
+    return lines_.line(contents_, line_number);
+}
+
+::takatori::document::position string_document::position(size_type offset) const noexcept {
+    return lines_.position(contents_, offset);
+}
+
+line_index const& string_document::lines() const noexcept {
+    return lines_;
+}
+
+} // namespace mizugaki::parser
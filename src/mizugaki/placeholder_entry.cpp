@@ -38,6 +38,14 @@ placeholder_entry::placeholder_entry(type::data&& type, value::data&& value)
         clone_shared(std::move(type)))
 {}
 
+std::shared_ptr<value::data const> const& placeholder_entry::value() const noexcept {
+    return value_;
+}
+
+std::shared_ptr<type::data const> const& placeholder_entry::type() const noexcept {
+    return type_;
+}
+
 std::unique_ptr<scalar::expression> placeholder_entry::resolve() const {
     return std::make_unique<scalar::immediate>(value_, type_);
 }
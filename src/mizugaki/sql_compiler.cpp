@@ -0,0 +1,115 @@
+#include <mizugaki/sql_compiler.h>
+
+#include <chrono>
+
+#include <takatori/util/optional_ptr.h>
+#include <takatori/util/string_builder.h>
+
+#include <mizugaki/parser/string_document.h>
+
+namespace mizugaki {
+
+using ::takatori::util::optional_ptr;
+using ::takatori::util::string_builder;
+
+using clock = std::chrono::steady_clock;
+
+using result_kind = analyzer::sql_analyzer_result_kind;
+
+namespace {
+
+sql_compiler_metrics::duration_type elapsed(clock::time_point begin, clock::time_point end) {
+    return std::chrono::duration_cast<sql_compiler_metrics::duration_type>(end - begin);
+}
+
+} // namespace
+
+sql_compiler::sql_compiler(options_type options) :
+    options_ { std::move(options) },
+    parser_ { options_.parser_options() }
+{}
+
+sql_compiler::~sql_compiler() = default;
+
+sql_compiler::sql_compiler(sql_compiler&& other) noexcept = default;
+
+sql_compiler& sql_compiler::operator=(sql_compiler&& other) noexcept = default;
+
+sql_compiler::options_type const& sql_compiler::options() const noexcept {
+    return options_;
+}
+
+sql_compiler::result_type sql_compiler::compile(std::string text, placeholder_map const& placeholders) {
+    auto document = std::make_shared<parser::string_document>(std::string { default_location }, std::move(text));
+    return compile(std::move(document), placeholders);
+}
+
+sql_compiler::result_type sql_compiler::compile(
+        ::takatori::util::maybe_shared_ptr<document_type const> document,
+        placeholder_map const& placeholders) {
+    result_type result {};
+    auto&& metrics = result.metrics();
+    auto started = clock::now();
+
+    result.stage() = sql_compiler_stage::parse;
+    auto parsed = parser_(std::move(document));
+    auto parsed_at = clock::now();
+    metrics.parse_time() = elapsed(started, parsed_at);
+    if (!parsed) {
+        result.parser_diagnostic() = std::move(parsed.diagnostic());
+        metrics.total_time() = metrics.parse_time();
+        return result;
+    }
+    result.compilation_unit() = std::move(parsed.value());
+    auto&& unit = *result.compilation_unit();
+    if (auto&& statements = unit.statements(); statements.size() != 1) {
+        result.parser_diagnostic() = parser::sql_parser_diagnostic {
+                statements.empty()
+                        ? parser::sql_parser_code::unexpected_eof
+                        : parser::sql_parser_code::exceed_number_of_elements,
+                string_builder {}
+                        << "source must consist of exactly one statement: "
+                        << statements.size() << " statement(s) found"
+                        << string_builder::to_string,
+                unit.document(),
+                statements.empty() ? ast::node_region {} : statements[1]->region(),
+        };
+        metrics.total_time() = metrics.parse_time();
+        return result;
+    }
+
+    result.stage() = sql_compiler_stage::analyze;
+    auto analyzed = analyzer_(
+            options_.analyzer_options(),
+            *unit.statements().front(),
+            unit,
+            placeholders,
+            optional_ptr { options_.host_parameters().get() });
+    auto analyzed_at = clock::now();
+    metrics.analysis_time() = elapsed(parsed_at, analyzed_at);
+    if (!analyzed) {
+        result.analyzer_diagnostics() = analyzed.release<result_kind::diagnostics>();
+        metrics.total_time() = elapsed(started, analyzed_at);
+        return result;
+    }
+
+    result.stage() = sql_compiler_stage::compile;
+    compile_statement(result, analyzed);
+    auto compiled_at = clock::now();
+    metrics.compile_time() = elapsed(analyzed_at, compiled_at);
+    metrics.total_time() = elapsed(started, compiled_at);
+    return result;
+}
+
+void sql_compiler::compile_statement(result_type& result, analyzer::sql_analyzer_result& analyzed) {
+    auto&& options = options_.compiler_options();
+    if (analyzed.kind() == result_kind::statement) {
+        result.compiled() = compiler_(options, analyzed.release<result_kind::statement>());
+        return;
+    }
+    auto graph = analyzed.release<result_kind::execution_plan>();
+    result.compiled() = compiler_(options, std::move(*graph));
+    graph->clear();
+}
+
+} // namespace mizugaki
@@ -0,0 +1,48 @@
+#include <mizugaki/sql_compiler_options.h>
+
+namespace mizugaki {
+
+sql_compiler_options::sql_compiler_options(
+        analyzer::sql_analyzer_options analyzer_options,
+        ::yugawara::compiler_options compiler_options,
+        parser::sql_parser_options parser_options,
+        std::shared_ptr<::yugawara::variable::provider const> host_parameters) :
+    parser_options_ { std::move(parser_options) },
+    analyzer_options_ { std::move(analyzer_options) },
+    compiler_options_ { std::move(compiler_options) },
+    host_parameters_ { std::move(host_parameters) }
+{}
+
+parser::sql_parser_options& sql_compiler_options::parser_options() noexcept {
+    return parser_options_;
+}
+
+parser::sql_parser_options const& sql_compiler_options::parser_options() const noexcept {
+    return parser_options_;
+}
+
+analyzer::sql_analyzer_options& sql_compiler_options::analyzer_options() noexcept {
+    return analyzer_options_;
+}
+
+analyzer::sql_analyzer_options const& sql_compiler_options::analyzer_options() const noexcept {
+    return analyzer_options_;
+}
+
+::yugawara::compiler_options& sql_compiler_options::compiler_options() noexcept {
+    return compiler_options_;
+}
+
+::yugawara::compiler_options const& sql_compiler_options::compiler_options() const noexcept {
+    return compiler_options_;
+}
+
+std::shared_ptr<::yugawara::variable::provider const>& sql_compiler_options::host_parameters() noexcept {
+    return host_parameters_;
+}
+
+std::shared_ptr<::yugawara::variable::provider const> const& sql_compiler_options::host_parameters() const noexcept {
+    return host_parameters_;
+}
+
+} // namespace mizugaki
@@ -0,0 +1,62 @@
+#include <mizugaki/sql_compiler_result.h>
+
+namespace mizugaki {
+
+bool sql_compiler_result::is_valid() const noexcept {
+    return stage_ == stage_type::compile && static_cast<bool>(compiled_);
+}
+
+sql_compiler_result::operator bool() const noexcept {
+    return is_valid();
+}
+
+sql_compiler_result::stage_type& sql_compiler_result::stage() noexcept {
+    return stage_;
+}
+
+sql_compiler_result::stage_type sql_compiler_result::stage() const noexcept {
+    return stage_;
+}
+
+sql_compiler_result::compilation_unit_type& sql_compiler_result::compilation_unit() noexcept {
+    return compilation_unit_;
+}
+
+sql_compiler_result::compilation_unit_type const& sql_compiler_result::compilation_unit() const noexcept {
+    return compilation_unit_;
+}
+
+sql_compiler_result::parser_diagnostic_type& sql_compiler_result::parser_diagnostic() noexcept {
+    return parser_diagnostic_;
+}
+
+sql_compiler_result::parser_diagnostic_type const& sql_compiler_result::parser_diagnostic() const noexcept {
+    return parser_diagnostic_;
+}
+
+std::vector<sql_compiler_result::analyzer_diagnostic_type>& sql_compiler_result::analyzer_diagnostics() noexcept {
+    return analyzer_diagnostics_;
+}
+
+std::vector<sql_compiler_result::analyzer_diagnostic_type> const&
+sql_compiler_result::analyzer_diagnostics() const noexcept {
+    return analyzer_diagnostics_;
+}
+
+sql_compiler_result::compiler_result_type& sql_compiler_result::compiled() noexcept {
+    return compiled_;
+}
+
+sql_compiler_result::compiler_result_type const& sql_compiler_result::compiled() const noexcept {
+    return compiled_;
+}
+
+sql_compiler_result::metrics_type& sql_compiler_result::metrics() noexcept {
+    return metrics_;
+}
+
+sql_compiler_result::metrics_type const& sql_compiler_result::metrics() const noexcept {
+    return metrics_;
+}
+
+} // namespace mizugaki
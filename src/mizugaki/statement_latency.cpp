@@ -0,0 +1,121 @@
+#include <mizugaki/statement_latency.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mizugaki {
+
+using duration_type = statement_latency::duration_type;
+
+namespace {
+
+// each power of two is split into 4 sub-buckets
+constexpr std::size_t sub_bucket_bits = 2;
+constexpr std::size_t sub_bucket_count = std::size_t { 1 } << sub_bucket_bits;
+
+std::size_t bucket_index(std::uint64_t value) noexcept {
+    if (value < sub_bucket_count) {
+        return static_cast<std::size_t>(value);
+    }
+    auto msb = static_cast<std::size_t>(63 - __builtin_clzll(value));
+    auto sub = static_cast<std::size_t>(value >> (msb - sub_bucket_bits)) & (sub_bucket_count - 1);
+    auto index = (msb - sub_bucket_bits + 1) * sub_bucket_count + sub;
+    return std::min(index, statement_latency::bucket_count - 1);
+}
+
+std::uint64_t bucket_upper_bound(std::size_t index) noexcept {
+    if (index < sub_bucket_count) {
+        return index;
+    }
+    auto msb = index / sub_bucket_count + sub_bucket_bits - 1;
+    auto sub = index % sub_bucket_count;
+    if (msb >= 63) {
+        return ~std::uint64_t {};
+    }
+    // inclusive upper bound of [(4 + sub) << (msb - 2), (5 + sub) << (msb - 2))
+    return ((sub_bucket_count + sub + 1) << (msb - sub_bucket_bits)) - 1;
+}
+
+} // namespace
+
+void statement_latency::add(duration_type elapsed) noexcept {
+    auto value = static_cast<std::uint64_t>(std::max(elapsed.count(), duration_type::rep {}));
+    if (count_ == 0 || value < min_) {
+        min_ = value;
+    }
+    max_ = std::max(max_, value);
+    ++count_;
+    total_ += value;
+    ++buckets_[bucket_index(value)]; // NOLINT(*-pro-bounds-constant-array-index)
+}
+
+void statement_latency::merge(statement_latency const& other) noexcept {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0 || other.min_ < min_) {
+        min_ = other.min_;
+    }
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+    total_ += other.total_;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        buckets_[i] += other.buckets_[i]; // NOLINT(*-pro-bounds-constant-array-index)
+    }
+}
+
+std::size_t statement_latency::count() const noexcept {
+    return count_;
+}
+
+duration_type statement_latency::total() const noexcept {
+    return duration_type { static_cast<duration_type::rep>(total_) };
+}
+
+duration_type statement_latency::min() const noexcept {
+    return duration_type { static_cast<duration_type::rep>(min_) };
+}
+
+duration_type statement_latency::max() const noexcept {
+    return duration_type { static_cast<duration_type::rep>(max_) };
+}
+
+duration_type statement_latency::mean() const noexcept {
+    if (count_ == 0) {
+        return {};
+    }
+    return duration_type { static_cast<duration_type::rep>(total_ / count_) };
+}
+
+duration_type statement_latency::percentile(double percent) const noexcept {
+    if (count_ == 0) {
+        return {};
+    }
+    auto clamped = std::clamp(percent, 0.0, 100.0);
+    auto rank = static_cast<std::uint64_t>(std::ceil(static_cast<double>(count_) * clamped / 100.0));
+    rank = std::max(rank, std::uint64_t { 1 });
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        seen += buckets_[i]; // NOLINT(*-pro-bounds-constant-array-index)
+        if (seen >= rank) {
+            auto bound = std::clamp(bucket_upper_bound(i), min_, max_);
+            return duration_type { static_cast<duration_type::rep>(bound) };
+        }
+    }
+    return max();
+}
+
+duration_type statement_latency::p99() const noexcept {
+    return percentile(99.0);
+}
+
+std::ostream& operator<<(std::ostream& out, statement_latency const& value) {
+    return out << "statement_latency("
+               << "count=" << value.count() << ", "
+               << "total=" << value.total().count() << "ns, "
+               << "min=" << value.min().count() << "ns, "
+               << "max=" << value.max().count() << "ns, "
+               << "p99=" << value.p99().count() << "ns)";
+}
+
+} // namespace mizugaki
@@ -0,0 +1,210 @@
+#include <mizugaki/statement_statistics.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mizugaki {
+
+using fingerprint_type = statement_statistics::fingerprint_type;
+using size_type = statement_statistics::size_type;
+
+namespace {
+
+using entry_map = std::unordered_map<fingerprint_type, statement_statistics_entry>;
+
+} // namespace
+
+class statement_statistics::state {
+public:
+    state(size_type max_entries, size_type flush_threshold) noexcept :
+        max_entries_ { max_entries },
+        flush_threshold_ { std::max(flush_threshold, size_type { 1 }) }
+    {}
+
+    [[nodiscard]] size_type flush_threshold() const noexcept {
+        return flush_threshold_;
+    }
+
+    void merge(entry_map& source) {
+        if (source.empty()) {
+            return;
+        }
+        std::lock_guard lock { mutex_ };
+        for (auto&& [fingerprint, entry] : source) {
+            if (auto it = entries_.find(fingerprint); it != entries_.end()) {
+                it->second.merge(entry);
+                continue;
+            }
+            if (entries_.size() < max_entries_) {
+                entries_.emplace(fingerprint, std::move(entry));
+                continue;
+            }
+            dropped_.fetch_add(entry.calls(), std::memory_order_relaxed);
+        }
+        source.clear();
+    }
+
+    [[nodiscard]] std::vector<statement_statistics_entry> snapshot() {
+        std::lock_guard lock { mutex_ };
+        std::vector<statement_statistics_entry> results {};
+        results.reserve(entries_.size());
+        for (auto&& [fingerprint, entry] : entries_) {
+            results.emplace_back(entry);
+        }
+        return results;
+    }
+
+    [[nodiscard]] size_type dropped_count() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    void clear() {
+        std::lock_guard lock { mutex_ };
+        entries_.clear();
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    size_type max_entries_;
+    size_type flush_threshold_;
+    std::mutex mutex_ {};
+    entry_map entries_ {};
+    std::atomic<size_type> dropped_ {};
+};
+
+/**
+ * @brief the pending records of the individual registries in the current thread.
+ */
+class statement_statistics::thread_buffers {
+public:
+    struct buffer {
+        std::weak_ptr<state> owner;
+        state const* key;
+        entry_map entries {};
+        size_type records {};
+
+        [[nodiscard]] statement_statistics_entry& entry(fingerprint_type fingerprint, std::string_view text) {
+            if (auto it = entries.find(fingerprint); it != entries.end()) {
+                return it->second;
+            }
+            auto [it, success] = entries.emplace(fingerprint, statement_statistics_entry { fingerprint, text });
+            (void) success;
+            return it->second;
+        }
+
+        void recorded(state& target) {
+            if (++records >= target.flush_threshold()) {
+                flush(target);
+            }
+        }
+
+        void flush(state& target) {
+            target.merge(entries);
+            records = 0;
+        }
+    };
+
+    thread_buffers() = default;
+    thread_buffers(thread_buffers const&) = delete;
+    thread_buffers(thread_buffers&&) = delete;
+    thread_buffers& operator=(thread_buffers const&) = delete;
+    thread_buffers& operator=(thread_buffers&&) = delete;
+
+    ~thread_buffers() {
+        for (auto&& b : buffers_) {
+            if (auto owner = b.owner.lock()) {
+                owner->merge(b.entries);
+            }
+        }
+    }
+
+    [[nodiscard]] buffer& get(std::shared_ptr<state> const& owner) {
+        // NOTE: the same address may be reused by another registry after the previous one was disposed
+        if (last_ < buffers_.size()) {
+            auto&& b = buffers_[last_];
+            if (b.key == owner.get() && !b.owner.expired()) {
+                return b;
+            }
+        }
+        buffers_.erase(
+                std::remove_if(
+                        buffers_.begin(),
+                        buffers_.end(),
+                        [](buffer const& b) { return b.owner.expired(); }),
+                buffers_.end());
+        for (std::size_t i = 0; i < buffers_.size(); ++i) {
+            if (buffers_[i].key == owner.get()) {
+                last_ = i;
+                return buffers_[i];
+            }
+        }
+        last_ = buffers_.size();
+        return buffers_.emplace_back(buffer { owner, owner.get() });
+    }
+
+private:
+    std::vector<buffer> buffers_ {};
+    std::size_t last_ {};
+};
+
+statement_statistics::statement_statistics(size_type max_entries, size_type flush_threshold) :
+    state_ { std::make_shared<state>(max_entries, flush_threshold) }
+{}
+
+void statement_statistics::record_parse(
+        fingerprint_type fingerprint,
+        std::string_view text,
+        duration_type elapsed,
+        size_type tree_node_count,
+        size_type tree_depth,
+        size_type diagnostic_count) {
+    auto&& b = buffers().get(state_);
+    auto&& entry = b.entry(fingerprint, text);
+    entry.parse_time().add(elapsed);
+    entry.total_tree_node_count() += tree_node_count;
+    entry.max_tree_node_count() = std::max(entry.max_tree_node_count(), tree_node_count);
+    entry.max_tree_depth() = std::max(entry.max_tree_depth(), tree_depth);
+    entry.parse_diagnostic_count() += diagnostic_count;
+    b.recorded(*state_);
+}
+
+void statement_statistics::record_analysis(
+        fingerprint_type fingerprint,
+        std::string_view text,
+        duration_type elapsed,
+        size_type diagnostic_count) {
+    auto&& b = buffers().get(state_);
+    auto&& entry = b.entry(fingerprint, text);
+    entry.analysis_time().add(elapsed);
+    entry.analysis_diagnostic_count() += diagnostic_count;
+    b.recorded(*state_);
+}
+
+void statement_statistics::flush() {
+    buffers().get(state_).flush(*state_);
+}
+
+std::vector<statement_statistics_entry> statement_statistics::snapshot() {
+    flush();
+    return state_->snapshot();
+}
+
+size_type statement_statistics::dropped_count() const noexcept {
+    return state_->dropped_count();
+}
+
+void statement_statistics::clear() {
+    state_->clear();
+}
+
+statement_statistics::thread_buffers& statement_statistics::buffers() {
+    thread_local thread_buffers instance {};
+    return instance;
+}
+
+} // namespace mizugaki
@@ -0,0 +1,113 @@
+#include <mizugaki/statement_statistics_entry.h>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace mizugaki {
+
+using size_type = statement_statistics_entry::size_type;
+
+statement_statistics_entry::statement_statistics_entry(fingerprint_type fingerprint, std::string_view text_sample) :
+    fingerprint_ { fingerprint },
+    text_sample_ { text_sample.substr(0, max_text_sample_length) }
+{}
+
+statement_statistics_entry::fingerprint_type statement_statistics_entry::fingerprint() const noexcept {
+    return fingerprint_;
+}
+
+std::string const& statement_statistics_entry::text_sample() const noexcept {
+    return text_sample_;
+}
+
+size_type statement_statistics_entry::calls() const noexcept {
+    return std::max(parse_time_.count(), analysis_time_.count());
+}
+
+statement_latency& statement_statistics_entry::parse_time() noexcept {
+    return parse_time_;
+}
+
+statement_latency const& statement_statistics_entry::parse_time() const noexcept {
+    return parse_time_;
+}
+
+statement_latency& statement_statistics_entry::analysis_time() noexcept {
+    return analysis_time_;
+}
+
+statement_latency const& statement_statistics_entry::analysis_time() const noexcept {
+    return analysis_time_;
+}
+
+size_type& statement_statistics_entry::total_tree_node_count() noexcept {
+    return total_tree_node_count_;
+}
+
+size_type const& statement_statistics_entry::total_tree_node_count() const noexcept {
+    return total_tree_node_count_;
+}
+
+size_type& statement_statistics_entry::max_tree_node_count() noexcept {
+    return max_tree_node_count_;
+}
+
+size_type const& statement_statistics_entry::max_tree_node_count() const noexcept {
+    return max_tree_node_count_;
+}
+
+size_type& statement_statistics_entry::max_tree_depth() noexcept {
+    return max_tree_depth_;
+}
+
+size_type const& statement_statistics_entry::max_tree_depth() const noexcept {
+    return max_tree_depth_;
+}
+
+size_type& statement_statistics_entry::parse_diagnostic_count() noexcept {
+    return parse_diagnostic_count_;
+}
+
+size_type const& statement_statistics_entry::parse_diagnostic_count() const noexcept {
+    return parse_diagnostic_count_;
+}
+
+size_type& statement_statistics_entry::analysis_diagnostic_count() noexcept {
+    return analysis_diagnostic_count_;
+}
+
+size_type const& statement_statistics_entry::analysis_diagnostic_count() const noexcept {
+    return analysis_diagnostic_count_;
+}
+
+void statement_statistics_entry::merge(statement_statistics_entry const& other) {
+    if (text_sample_.empty()) {
+        text_sample_ = other.text_sample_;
+    }
+    parse_time_.merge(other.parse_time_);
+    analysis_time_.merge(other.analysis_time_);
+    total_tree_node_count_ += other.total_tree_node_count_;
+    max_tree_node_count_ = std::max(max_tree_node_count_, other.max_tree_node_count_);
+    max_tree_depth_ = std::max(max_tree_depth_, other.max_tree_depth_);
+    parse_diagnostic_count_ += other.parse_diagnostic_count_;
+    analysis_diagnostic_count_ += other.analysis_diagnostic_count_;
+}
+
+std::ostream& operator<<(std::ostream& out, statement_statistics_entry const& value) {
+    auto flags = out.flags();
+    auto fill = out.fill();
+    out << "statement_statistics_entry("
+        << "fingerprint=" << std::hex << std::setw(16) << std::setfill('0') << value.fingerprint() << ", ";
+    out.flags(flags);
+    out.fill(fill);
+    return out << "calls=" << value.calls() << ", "
+               << "parse_time=" << value.parse_time() << ", "
+               << "analysis_time=" << value.analysis_time() << ", "
+               << "total_tree_node_count=" << value.total_tree_node_count() << ", "
+               << "max_tree_node_count=" << value.max_tree_node_count() << ", "
+               << "max_tree_depth=" << value.max_tree_depth() << ", "
+               << "parse_diagnostic_count=" << value.parse_diagnostic_count() << ", "
+               << "analysis_diagnostic_count=" << value.analysis_diagnostic_count() << ")";
+}
+
+} // namespace mizugaki
@@ -739,6 +739,97 @@ TEST_F(analyze_literal_test, binary_string_odd_digits) {
             });
 }
 
+TEST_F(analyze_literal_test, character_string_large) {
+    options_.large_literal_threshold() = 16;
+    std::string source { "'" };
+    std::string expected {};
+    for (std::size_t i = 0; i < 100; ++i) {
+        source.append("abc''");
+        expected.append("abc'");
+    }
+    source.append("'");
+
+    auto r1 = analyze_literal(
+            context(),
+            ast::literal::string {
+                    ast::literal::kind::character_string,
+                    source,
+            });
+    ASSERT_TRUE(r1);
+    EXPECT_EQ(*r1, (tscalar::immediate {
+            tvalue::character { expected },
+            ttype::character { ttype::varying },
+    }));
+    auto r2 = analyze_literal(
+            context(),
+            ast::literal::string {
+                    ast::literal::kind::character_string,
+                    source,
+            });
+    ASSERT_TRUE(r2);
+    expect_no_error();
+
+    // large values are never shared
+    auto&& i1 = dynamic_cast<tscalar::immediate const&>(*r1);
+    auto&& i2 = dynamic_cast<tscalar::immediate const&>(*r2);
+    EXPECT_NE(std::addressof(i1.value()), std::addressof(i2.value()));
+}
+
+TEST_F(analyze_literal_test, character_string_small_shared) {
+    options_.large_literal_threshold() = 16;
+    auto r1 = analyze_literal(
+            context(),
+            ast::literal::string {
+                    ast::literal::kind::character_string,
+                    "'Hello'",
+            });
+    ASSERT_TRUE(r1);
+    auto r2 = analyze_literal(
+            context(),
+            ast::literal::string {
+                    ast::literal::kind::character_string,
+                    "'Hello'",
+            });
+    ASSERT_TRUE(r2);
+    expect_no_error();
+
+    auto&& i1 = dynamic_cast<tscalar::immediate const&>(*r1);
+    auto&& i2 = dynamic_cast<tscalar::immediate const&>(*r2);
+    EXPECT_EQ(std::addressof(i1.value()), std::addressof(i2.value()));
+}
+
+TEST_F(analyze_literal_test, character_string_unescaped_quote) {
+    invalid(sql_analyzer_code::malformed_quoted_string,
+            ast::literal::string {
+                    ast::literal::kind::character_string,
+                    "'a'b'",
+            });
+}
+
+TEST_F(analyze_literal_test, binary_string_large) {
+    options_.large_literal_threshold() = 16;
+    std::string source { "'" };
+    std::string expected {};
+    for (std::size_t i = 0; i < 100; ++i) {
+        source.append("0a Fb");
+        expected.append("\x0a\xfb");
+    }
+    source.append("'");
+
+    auto r = analyze_literal(
+            context(),
+            ast::literal::string {
+                    ast::literal::kind::hex_string,
+                    source,
+            });
+    ASSERT_TRUE(r);
+    EXPECT_EQ(*r, (tscalar::immediate {
+            tvalue::octet { expected },
+            ttype::octet { ttype::varying, 200 },
+    }));
+    expect_no_error();
+}
+
 TEST_F(analyze_literal_test, date) {
     auto r = analyze_literal(
             context(),
@@ -991,6 +991,29 @@ TEST_F(analyze_name_primary_test, table_decl) {
     validate(r, s, t0);
 }
 
+TEST_F(analyze_name_primary_test, table_decl_snapshot) {
+    auto storage = std::make_shared<::yugawara::storage::configurable_provider>();
+    ::yugawara::schema::declaration s {
+            "s",
+            {},
+            storage,
+    };
+    auto t0 = storage->add_table({ "t0", {} });
+    search_path_->elements().emplace_back(&s);
+
+    auto r0 = analyze_table_name(
+            context(),
+            id("t0"));
+    validate(r0, s, t0);
+
+    // keeps the first result during the analysis
+    storage->remove_relation("t0");
+    auto r1 = analyze_table_name(
+            context(),
+            id("t0"));
+    validate(r1, s, t0);
+}
+
 TEST_F(analyze_name_primary_test, table_decl_missing_mandatory) {
     auto r = analyze_table_name(
             context(),
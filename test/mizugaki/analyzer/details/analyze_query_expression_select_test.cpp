@@ -617,6 +617,53 @@ TEST_F(analyze_query_expression_select_test, where) {
     EXPECT_EQ(relation_columns[0].variable(), project_columns[0].variable());
 }
 
+TEST_F(analyze_query_expression_select_test, where_batch_relation_resolution) {
+    options_.batch_relation_resolution() = true;
+    auto table = install_table("testing");
+    trelation::graph_type graph {};
+
+    auto r = analyze_query_expression(
+            context(),
+            graph,
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    {
+                            ast::scalar::comparison_predicate {
+                                    vref(id("k")),
+                                    ast::scalar::comparison_operator::equals,
+                                    literal(number("1")),
+                            }
+                    },
+            },
+            {},
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(context().pending_resolution_size(), 0);
+
+    EXPECT_EQ(graph.size(), 3);
+
+    // scan - filter - project -
+    auto&& project = downcast<trelation::project>(r.output().owner());
+    auto&& filter = *find_prev<trelation::filter>(project);
+    auto&& scan = *find_prev<trelation::scan>(filter);
+
+    auto&& scan_columns = scan.columns();
+    ASSERT_EQ(scan_columns.size(), 4);
+
+    EXPECT_EQ(filter.condition(), (tscalar::compare(
+            tscalar::comparison_operator::equal,
+            vref(scan_columns[0].destination()),
+            immediate(1))));
+}
+
 TEST_F(analyze_query_expression_select_test, distinct) {
     auto table = install_table("testing");
     trelation::graph_type graph {};
@@ -981,6 +1028,94 @@ TEST_F(analyze_query_expression_select_test, order_by_expression) {
     }
 }
 
+TEST_F(analyze_query_expression_select_test, order_by_common_expression) {
+    options_.eliminate_common_subexpressions() = true;
+    auto table = install_table("testing");
+    trelation::graph_type graph {};
+
+    auto r = analyze_query_expression(
+            context(),
+            graph,
+            ast::query::query {
+                    {
+                            ast::query::select_column {
+                                    ast::scalar::binary_expression {
+                                            vref(id("w")),
+                                            ast::scalar::binary_operator::concatenation,
+                                            vref(id("x")),
+                                    },
+                            },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    {},
+                    {},
+                    {},
+                    {
+                            {
+                                    ast::scalar::binary_expression {
+                                            vref(id("w")),
+                                            ast::scalar::binary_operator::concatenation,
+                                            vref(id("x")),
+                                    },
+                            },
+                            {
+                                    ast::scalar::binary_expression {
+                                            vref(id("v")),
+                                            ast::scalar::binary_operator::concatenation,
+                                            vref(id("x")),
+                                    },
+                            },
+                            {
+                                    ast::scalar::binary_expression {
+                                            vref(id("v")),
+                                            ast::scalar::binary_operator::concatenation,
+                                            vref(id("x")),
+                                    },
+                                    {},
+                                    ast::common::ordering_specification::desc,
+                            },
+                    },
+            },
+            {},
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+
+    EXPECT_EQ(graph.size(), 4);
+
+    // scan - project - project - limit -
+    auto&& limit = downcast<trelation::intermediate::limit>(r.output().owner());
+    auto&& prepare = *find_prev<trelation::project>(limit);
+    auto&& project = *find_prev<trelation::project>(prepare);
+    auto&& scan = *find_prev<trelation::scan>(project);
+
+    auto&& scan_columns = scan.columns();
+    ASSERT_EQ(scan_columns.size(), 4);
+
+    auto&& project_columns = project.columns();
+    ASSERT_EQ(project_columns.size(), 1);
+
+    // only "v || x" is computed for the sort keys
+    auto&& prepare_columns = prepare.columns();
+    ASSERT_EQ(prepare_columns.size(), 1);
+    EXPECT_EQ(prepare_columns[0].value(), (tscalar::binary { // v || x
+            tscalar::binary_operator::concat,
+            vref(scan_columns[1].destination()),
+            vref(scan_columns[3].destination()),
+    }));
+
+    auto&& limit_columns = limit.sort_keys();
+    ASSERT_EQ(limit_columns.size(), 3);
+    EXPECT_EQ(limit_columns[0].variable(), project_columns[0].variable());
+    EXPECT_EQ(limit_columns[1].variable(), prepare_columns[0].variable());
+    EXPECT_EQ(limit_columns[2].variable(), prepare_columns[0].variable());
+    EXPECT_EQ(limit_columns[2].direction(), trelation::sort_direction::descendant);
+}
+
 TEST_F(analyze_query_expression_select_test, order_by_literal) {
     auto table = install_table("testing");
     invalid(sql_analyzer_code::unsupported_feature, ast::query::query {
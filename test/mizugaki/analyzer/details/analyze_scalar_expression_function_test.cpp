@@ -355,6 +355,78 @@ TEST_F(analyze_scalar_expression_function_test, function_overload) {
     }));
 }
 
+TEST_F(analyze_scalar_expression_function_test, function_overload_repeated) {
+    auto f_char = functions_->add(::yugawara::function::declaration {
+            ::yugawara::function::declaration::minimum_user_function_id + 1,
+            "substr",
+            ttype::character { ttype::varying, {} },
+            {
+                    ttype::character { ttype::varying, {} },
+                    ttype::int8 {},
+            },
+    });
+    auto f_octet = functions_->add(::yugawara::function::declaration {
+            ::yugawara::function::declaration::minimum_user_function_id + 2,
+            "substr",
+            ttype::octet { ttype::varying, {} },
+            {
+                    ttype::octet { ttype::varying, {} },
+                    ttype::int8 {},
+            },
+    });
+
+    // the second invocation reuses the overload resolution of the first one
+    auto hits = context().overloads().hits();
+    for (std::size_t i = 0; i < 2; ++i) {
+        auto r = analyze_scalar_expression(
+                context(),
+                ast::scalar::function_invocation {
+                        id("SUBSTR"),
+                        {
+                                literal(string("'Hello, world!'")),
+                                literal(number("8")),
+                        },
+                },
+                scope,
+                {});
+        ASSERT_TRUE(r) << diagnostics();
+        expect_no_error();
+
+        EXPECT_EQ(*r, (tscalar::function_call {
+                descriptor(f_char),
+                {
+                        immediate("Hello, world!"),
+                        immediate(8),
+                },
+        }));
+        EXPECT_EQ(context().overloads().hits(), hits + i);
+    }
+
+    // never reuse the resolution for the other argument types
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::function_invocation {
+                    id("SUBSTR"),
+                    {
+                            literal(binary("'CAFEBABE'")),
+                            literal(number("3")),
+                    },
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+
+    EXPECT_EQ(*r, (tscalar::function_call {
+            descriptor(f_octet),
+            {
+                    immediate_octet("\xca\xfe\xba\xbe"),
+                    immediate(3),
+            },
+    }));
+    EXPECT_EQ(context().overloads().hits(), hits + 1);
+}
+
 TEST_F(analyze_scalar_expression_function_test, function_mismatch_argument) {
     auto f_char = functions_->add(::yugawara::function::declaration {
             ::yugawara::function::declaration::minimum_user_function_id + 1,
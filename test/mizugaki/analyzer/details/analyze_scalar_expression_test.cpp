@@ -2,13 +2,19 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include <takatori/value/primitive.h>
+#include <takatori/value/date.h>
 #include <takatori/type/primitive.h>
+#include <takatori/type/date.h>
 
 #include <takatori/scalar/binary.h>
 #include <takatori/scalar/cast.h>
 #include <takatori/scalar/unary.h>
 
+#include <takatori/util/downcast.h>
+
 #include <mizugaki/ast/type/simple.h>
 #include <mizugaki/ast/type/character_string.h>
 
@@ -584,4 +590,189 @@ TEST_F(analyze_scalar_expression_test, placeholder_reference_value_without_colon
     EXPECT_EQ(*r, immediate(1));
 }
 
+TEST_F(analyze_scalar_expression_test, fold_constant_arithmetic) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::binary_expression {
+                    literal(number("1")),
+                    ast::scalar::binary_operator::plus,
+                    ast::scalar::binary_expression {
+                            literal(number("2")),
+                            ast::scalar::binary_operator::asterisk,
+                            literal(number("3")),
+                    },
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, immediate(7));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_overflow) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::binary_expression {
+                    literal(number("9223372036854775807")),
+                    ast::scalar::binary_operator::plus,
+                    literal(number("1")),
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, (tscalar::binary {
+            tscalar::binary_operator::add,
+            immediate(9'223'372'036'854'775'807LL),
+            immediate(1),
+    }));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_division_by_zero) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::binary_expression {
+                    literal(number("1")),
+                    ast::scalar::binary_operator::solidus,
+                    literal(number("0")),
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, (tscalar::binary {
+            tscalar::binary_operator::divide,
+            immediate(1),
+            immediate(0),
+    }));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_concat) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::binary_expression {
+                    literal(string("'a'")),
+                    ast::scalar::binary_operator::concatenation,
+                    literal(string("'b'")),
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, immediate("ab"));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_not) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::unary_expression {
+                    ast::scalar::unary_operator::not_,
+                    literal(ast::literal::boolean { true }),
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, immediate_bool(false));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_cast) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::cast_expression {
+                    ast::scalar::cast_operator::cast,
+                    literal(number("1")),
+                    ast::type::simple { ast::type::kind::tiny_integer },
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, (tscalar::immediate {
+            tvalue::int4 { 1 },
+            ttype::int1 {},
+    }));
+}
+
+TEST_F(analyze_scalar_expression_test, fold_constant_cast_date) {
+    options_.fold_constant_expressions() = true;
+    auto r = analyze_scalar_expression(
+            context(),
+            ast::scalar::cast_expression {
+                    ast::scalar::cast_operator::cast,
+                    literal(string("'2024-01-02'")),
+                    ast::type::simple { ast::type::kind::date },
+            },
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+    EXPECT_EQ(*r, (tscalar::immediate {
+            tvalue::date { 2024, 1, 2 },
+            ttype::date {},
+    }));
+}
+
+TEST_F(analyze_scalar_expression_test, deep_operator_chain) {
+    // ((((1 + 1) + 1) ...) with unary minus in every other level
+    constexpr std::size_t depth = 10'000;
+    std::unique_ptr<ast::scalar::expression> expr { literal(number("1")).clone() };
+    for (std::size_t i = 0; i < depth; ++i) {
+        if (i % 2 == 0) {
+            expr = std::make_unique<ast::scalar::unary_expression>(
+                    ast::scalar::unary_operator::minus,
+                    std::move(expr));
+        }
+        expr = std::make_unique<ast::scalar::binary_expression>(
+                std::move(expr),
+                ast::scalar::binary_operator::plus,
+                std::unique_ptr<ast::scalar::expression> { literal(number("1")).clone() });
+    }
+    auto r = analyze_scalar_expression(
+            context(),
+            *expr,
+            scope,
+            {});
+    ASSERT_TRUE(r) << diagnostics();
+    expect_no_error();
+
+    std::size_t binaries = 0;
+    std::size_t unaries = 0;
+    for (tscalar::expression const* current = &*r; current != nullptr;) {
+        if (auto const* binary = ::takatori::util::downcast<tscalar::binary>(current)) {
+            EXPECT_EQ(binary->operator_kind(), tscalar::binary_operator::add);
+            EXPECT_EQ(binary->right(), immediate(1));
+            ++binaries;
+            current = &binary->left();
+        } else if (auto const* unary = ::takatori::util::downcast<tscalar::unary>(current)) {
+            EXPECT_EQ(unary->operator_kind(), tscalar::unary_operator::sign_inversion);
+            ++unaries;
+            current = &unary->operand();
+        } else {
+            EXPECT_EQ(*current, immediate(1));
+            current = nullptr;
+        }
+    }
+    EXPECT_EQ(binaries, depth);
+    EXPECT_EQ(unaries, depth / 2);
+}
+
+TEST_F(analyze_scalar_expression_test, deep_operator_chain_invalid_operand) {
+    constexpr std::size_t depth = 1'000;
+    std::unique_ptr<ast::scalar::expression> expr { erroneous_expression().clone() };
+    for (std::size_t i = 0; i < depth; ++i) {
+        expr = std::make_unique<ast::scalar::binary_expression>(
+                std::move(expr),
+                ast::scalar::binary_operator::plus,
+                std::unique_ptr<ast::scalar::expression> { literal(number("1")).clone() });
+    }
+    invalid(*expr);
+}
+
 } // namespace mizugaki::analyzer::details
@@ -2,17 +2,33 @@
 
 #include <gtest/gtest.h>
 
+#include <takatori/type/primitive.h>
+
+#include <takatori/value/primitive.h>
+
+#include <takatori/scalar/compare.h>
+#include <takatori/scalar/immediate.h>
+
 #include <takatori/relation/emit.h>
+#include <takatori/relation/endpoint_kind.h>
 #include <takatori/relation/filter.h>
 #include <takatori/relation/scan.h>
 
 #include <yugawara/binding/extract.h>
 
+#include <yugawara/storage/configurable_provider.h>
 #include <yugawara/storage/index.h>
 #include <yugawara/storage/column.h>
 
+#include <mizugaki/ast/query/query.h>
+#include <mizugaki/ast/query/select_column.h>
 #include <mizugaki/ast/query/table_reference.h>
 
+#include <mizugaki/ast/scalar/binary_expression.h>
+#include <mizugaki/ast/scalar/comparison_predicate.h>
+
+#include <mizugaki/ast/table/table_reference.h>
+
 #include <mizugaki/ast/statement/select_statement.h>
 
 #include "test_parent.h"
@@ -90,6 +106,295 @@ TEST_F(analyze_statement_select_test, simple) {
     }
 }
 
+TEST_F(analyze_statement_select_test, prune_scan_columns) {
+    options_.prune_scan_columns() = true;
+    auto table = install_table("testing");
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    ast::scalar::comparison_predicate {
+                            vref(id("k")),
+                            ast::scalar::comparison_operator::equals,
+                            literal(number("1")),
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+
+    // "w" and "x" are never referenced
+    auto&& scan_columns = first->columns();
+    ASSERT_EQ(scan_columns.size(), 2);
+    EXPECT_EQ(&extract<::yugawara::storage::column>(scan_columns[0].source()), &table->columns()[0]);
+    EXPECT_EQ(&extract<::yugawara::storage::column>(scan_columns[1].source()), &table->columns()[1]);
+}
+
+TEST_F(analyze_statement_select_test, primary_key_lookup) {
+    options_.primary_key_lookup() = true;
+    auto table = install_table("testing");
+    // SELECT v FROM testing WHERE k = 1
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    ast::scalar::comparison_predicate {
+                            vref(id("k")),
+                            ast::scalar::comparison_operator::equals,
+                            literal(number("1")),
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    ASSERT_EQ(graph.size(), 2);
+
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+
+    auto&& lower = first->lower();
+    EXPECT_EQ(lower.kind(), trelation::endpoint_kind::inclusive);
+    ASSERT_EQ(lower.keys().size(), 1);
+    EXPECT_EQ(&extract<::yugawara::storage::column>(lower.keys()[0].variable()), &table->columns()[0]);
+    EXPECT_EQ(lower.keys()[0].value(), immediate(1));
+
+    auto&& upper = first->upper();
+    EXPECT_EQ(upper.kind(), trelation::endpoint_kind::inclusive);
+    ASSERT_EQ(upper.keys().size(), 1);
+    EXPECT_EQ(&extract<::yugawara::storage::column>(upper.keys()[0].variable()), &table->columns()[0]);
+    EXPECT_EQ(upper.keys()[0].value(), immediate(1));
+
+    // the filter was removed
+    auto last = find_last<trelation::emit>(graph);
+    ASSERT_TRUE(last);
+    EXPECT_EQ(find_next(*first).get(), last.get());
+}
+
+TEST_F(analyze_statement_select_test, primary_key_lookup_narrow_integer) {
+    options_.primary_key_lookup() = true;
+    auto table = storages_->add_table(::yugawara::storage::table {
+            "narrow",
+            {
+                    { "k", ttype::int4 {} },
+                    { "v", ttype::int4 {}, ::yugawara::variable::nullable },
+            },
+    });
+    storages_->add_index(::yugawara::storage::index {
+            table,
+            "narrow",
+            {
+                    {
+                            table->columns()[0],
+                            ::yugawara::storage::index::key::direction_type::ascendant,
+                    },
+            },
+            {},
+            {
+                    ::yugawara::storage::index_feature::find,
+                    ::yugawara::storage::index_feature::scan,
+                    ::yugawara::storage::index_feature::primary,
+                    ::yugawara::storage::index_feature::unique,
+            },
+    });
+
+    // SELECT v FROM narrow WHERE k = 1
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("narrow"),
+                            }
+                    },
+                    ast::scalar::comparison_predicate {
+                            vref(id("k")),
+                            ast::scalar::comparison_operator::equals,
+                            literal(number("1")),
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    ASSERT_EQ(graph.size(), 2);
+
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+
+    // the int8 literal is rebuilt as an int4 immediate
+    tscalar::immediate expected {
+            tvalue::int4 { 1 },
+            ttype::int4 {},
+    };
+    ASSERT_EQ(first->lower().keys().size(), 1);
+    EXPECT_EQ(first->lower().keys()[0].value(), expected);
+    ASSERT_EQ(first->upper().keys().size(), 1);
+    EXPECT_EQ(first->upper().keys()[0].value(), expected);
+}
+
+TEST_F(analyze_statement_select_test, primary_key_lookup_narrow_integer_overflow) {
+    options_.primary_key_lookup() = true;
+    auto table = storages_->add_table(::yugawara::storage::table {
+            "narrow",
+            {
+                    { "k", ttype::int4 {} },
+            },
+    });
+    storages_->add_index(::yugawara::storage::index {
+            table,
+            "narrow",
+            {
+                    {
+                            table->columns()[0],
+                            ::yugawara::storage::index::key::direction_type::ascendant,
+                    },
+            },
+            {},
+            {
+                    ::yugawara::storage::index_feature::find,
+                    ::yugawara::storage::index_feature::scan,
+                    ::yugawara::storage::index_feature::primary,
+                    ::yugawara::storage::index_feature::unique,
+            },
+    });
+
+    // SELECT k FROM narrow WHERE k = 4294967296
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("k")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("narrow"),
+                            }
+                    },
+                    ast::scalar::comparison_predicate {
+                            vref(id("k")),
+                            ast::scalar::comparison_operator::equals,
+                            literal(number("4294967296")),
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->lower(), trelation::scan::endpoint());
+    EXPECT_EQ(first->upper(), trelation::scan::endpoint());
+    EXPECT_TRUE(find_next<trelation::filter>(*first));
+}
+
+TEST_F(analyze_statement_select_test, primary_key_lookup_rest) {
+    options_.primary_key_lookup() = true;
+    auto table = install_table("testing");
+    // SELECT v FROM testing WHERE v = 'a' AND 1 = k
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    ast::scalar::binary_expression {
+                            ast::scalar::comparison_predicate {
+                                    vref(id("v")),
+                                    ast::scalar::comparison_operator::equals,
+                                    literal(string("'a'")),
+                            },
+                            ast::scalar::binary_operator::and_,
+                            ast::scalar::comparison_predicate {
+                                    literal(number("1")),
+                                    ast::scalar::comparison_operator::equals,
+                                    vref(id("k")),
+                            },
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    ASSERT_EQ(graph.size(), 3);
+
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first->lower().keys().size(), 1);
+    EXPECT_EQ(first->lower().keys()[0].value(), immediate(1));
+    ASSERT_EQ(first->upper().keys().size(), 1);
+
+    // only the condition on the non-key column is left
+    auto filter = find_next<trelation::filter>(*first);
+    ASSERT_TRUE(filter);
+    ASSERT_EQ(filter->condition().kind(), tscalar::compare::tag);
+    auto&& compare = downcast<tscalar::compare>(filter->condition());
+    EXPECT_EQ(compare->left(), vref(first->columns()[1].destination()));
+}
+
+TEST_F(analyze_statement_select_test, primary_key_lookup_not_key) {
+    options_.primary_key_lookup() = true;
+    install_table("testing");
+    // SELECT v FROM testing WHERE k > 1
+    auto r = analyze_statement(context(), ast::statement::select_statement {
+            ast::query::query {
+                    {
+                            ast::query::select_column { vref(id("v")) },
+                    },
+                    {
+                            ast::table::table_reference {
+                                    id("testing"),
+                            }
+                    },
+                    ast::scalar::comparison_predicate {
+                            vref(id("k")),
+                            ast::scalar::comparison_operator::greater_than,
+                            literal(number("1")),
+                    },
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->lower(), trelation::scan::endpoint());
+    EXPECT_EQ(first->upper(), trelation::scan::endpoint());
+    EXPECT_TRUE(find_next<trelation::filter>(*first));
+}
+
 TEST_F(analyze_statement_select_test, invalid_query) {
     invalid(ast::statement::select_statement {
             ast::query::table_reference {
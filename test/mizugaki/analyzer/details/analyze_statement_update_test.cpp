@@ -5,6 +5,7 @@
 #include <takatori/scalar/compare.h>
 
 #include <takatori/relation/emit.h>
+#include <takatori/relation/endpoint_kind.h>
 #include <takatori/relation/filter.h>
 #include <takatori/relation/project.h>
 #include <takatori/relation/scan.h>
@@ -528,6 +529,58 @@ TEST_F(analyze_statement_update_test, where) {
     EXPECT_EQ(find_next(*project).get(), last.get());
 }
 
+TEST_F(analyze_statement_update_test, primary_key_lookup) {
+    options_.primary_key_lookup() = true;
+    auto table = install_table("testing");
+
+    // UPDATE testing SET v = 'lookup' WHERE k = 1
+    auto r = analyze_statement(context(), ast::statement::update_statement {
+            id("testing"),
+            {
+                    {
+                            id("v"),
+                            literal(string("'lookup'"))
+                    },
+            },
+            ast::scalar::comparison_predicate {
+                    vref(id("k")),
+                    ast::scalar::comparison_operator::equals,
+                    literal(number("1")),
+            },
+    });
+    auto alternative = std::get_if<execution_plan_result_type >(&r);
+    ASSERT_TRUE(alternative) << diagnostics();
+    expect_no_error();
+
+    auto&& graph = **alternative;
+    ASSERT_EQ(graph.size(), 3);
+
+    auto first = find_first<trelation::scan>(graph);
+    ASSERT_TRUE(first);
+
+    auto&& scan_columns = first->columns();
+    ASSERT_EQ(scan_columns.size(), 4);
+
+    EXPECT_EQ(first->lower(), (trelation::scan::endpoint {
+            {
+                    trelation::scan::key {
+                            scan_columns[0].source(), // k
+                            immediate(1),
+                    },
+            },
+            trelation::endpoint_kind::inclusive,
+    }));
+    EXPECT_EQ(first->upper(), first->lower());
+
+    // the filter was removed
+    auto project = find_next<trelation::project>(*first);
+    ASSERT_TRUE(project);
+
+    auto last = find_last<trelation::write>(graph);
+    ASSERT_TRUE(last);
+    EXPECT_EQ(find_next(*project).get(), last.get());
+}
+
 TEST_F(analyze_statement_update_test, invalid_relation) {
     invalid(ast::statement::update_statement{
             id("MISSING"),
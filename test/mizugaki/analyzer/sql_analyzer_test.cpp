@@ -4,15 +4,20 @@
 
 #include <takatori/type/primitive.h>
 #include <takatori/type/table.h>
+#include <takatori/value/primitive.h>
 
 #include <takatori/relation/emit.h>
 
+#include <takatori/util/clonable.h>
+
+#include <mizugaki/ast/scalar/host_parameter_reference.h>
 #include <mizugaki/ast/scalar/value_constructor.h>
 
 #include <mizugaki/ast/table/apply.h>
 #include <mizugaki/ast/table/subquery.h>
 #include <mizugaki/ast/table/table_reference.h>
 
+#include <mizugaki/ast/query/binary_expression.h>
 #include <mizugaki/ast/query/query.h>
 #include <mizugaki/ast/query/table_value_constructor.h>
 #include <mizugaki/ast/query/select_asterisk.h>
@@ -26,6 +31,8 @@ namespace mizugaki::analyzer {
 
 using namespace testing;
 
+using ::takatori::util::clone_unique;
+
 class sql_analyzer_test : public details::test_parent {
 };
 
@@ -238,4 +245,336 @@ TEST_F(sql_analyzer_test, apply_walkthrough) {
     ASSERT_EQ(emit.columns().size(), 6); // t.k, t.v, t.w, t.x, x.c0, x.c1
 }
 
+TEST_F(sql_analyzer_test, metrics) {
+    install_table("t");
+    options_.enable_metrics() = true;
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_TRUE(result) << diagnostics();
+
+    auto&& metrics = result.metrics();
+    ASSERT_TRUE(metrics);
+    EXPECT_GT(metrics->relation_count(), 0);
+    EXPECT_EQ(metrics->diagnostic_count(), 0);
+    EXPECT_GE(metrics->total_time(), metrics->query_expression_time());
+    EXPECT_GT(metrics->memory_usage(), 0);
+}
+
+TEST_F(sql_analyzer_test, metrics_disabled) {
+    install_table("t");
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_TRUE(result) << diagnostics();
+    EXPECT_FALSE(result.metrics());
+}
+
+TEST_F(sql_analyzer_test, cancellation) {
+    install_table("t");
+    auto token = cancellation_token::create();
+    options_.cancellation() = token;
+    token.cancel();
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_FALSE(result);
+    auto&& errors = result.element<sql_analyzer_result_kind::diagnostics>();
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].code(), sql_analyzer_code::cancelled);
+}
+
+TEST_F(sql_analyzer_test, cancellation_deadline) {
+    install_table("t");
+    options_.cancellation() = cancellation_token::with_deadline(cancellation_token::clock::now());
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_FALSE(result);
+    auto&& errors = result.element<sql_analyzer_result_kind::diagnostics>();
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].code(), sql_analyzer_code::deadline_exceeded);
+}
+
+TEST_F(sql_analyzer_test, cancellation_not_requested) {
+    install_table("t");
+    options_.cancellation() = cancellation_token::with_timeout(std::chrono::hours { 1 });
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_TRUE(result) << diagnostics();
+}
+
+TEST_F(sql_analyzer_test, memory_budget) {
+    install_table("t");
+    options_.memory_budget() = 64 * 1024;
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // INSERT INTO t (k) VALUES ('...')
+            ast::statement::insert_statement {
+                    id("t"),
+                    {
+                            id("k"),
+                    },
+                    ast::query::table_value_constructor {
+                            ast::scalar::value_constructor {
+                                    literal(string("'" + std::string(128 * 1024, 'x') + "'")),
+                            },
+                    },
+            }
+    );
+    ASSERT_FALSE(result);
+    auto&& errors = result.element<sql_analyzer_result_kind::diagnostics>();
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].code(), sql_analyzer_code::memory_budget_exceeded);
+}
+
+TEST_F(sql_analyzer_test, memory_budget_wide_values) {
+    options_.memory_budget() = 256 * 1024;
+
+    std::vector<std::unique_ptr<ast::scalar::expression>> rows {};
+    for (std::size_t i = 0; i < 4096; ++i) {
+        rows.emplace_back(clone_unique(ast::scalar::value_constructor {
+                literal(number("1")),
+                literal(number("2")),
+                literal(number("3")),
+                literal(number("4")),
+        }));
+    }
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // VALUES (1, 2, 3, 4), (1, 2, 3, 4), ...
+            ast::statement::select_statement {
+                    std::make_unique<ast::query::table_value_constructor>(std::move(rows)),
+            }
+    );
+    ASSERT_FALSE(result);
+    auto&& errors = result.element<sql_analyzer_result_kind::diagnostics>();
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].code(), sql_analyzer_code::memory_budget_exceeded);
+}
+
+TEST_F(sql_analyzer_test, memory_budget_union_chain) {
+    install_table("t");
+    options_.memory_budget() = 256 * 1024;
+
+    auto branch = [] {
+        // SELECT * FROM t
+        return clone_unique(ast::query::query {
+                {
+                        ast::query::select_asterisk {},
+                },
+                {
+                        ast::table::table_reference { id("t") },
+                },
+        });
+    };
+    std::unique_ptr<ast::query::expression> chain = branch();
+    for (std::size_t i = 1; i < 512; ++i) {
+        chain = std::make_unique<ast::query::binary_expression>(
+                std::move(chain),
+                ast::query::binary_operator::union_,
+                ast::query::set_quantifier::all,
+                std::nullopt,
+                branch());
+    }
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t UNION ALL SELECT * FROM t UNION ALL ...
+            ast::statement::select_statement {
+                    std::move(chain),
+            }
+    );
+    ASSERT_FALSE(result);
+    auto&& errors = result.element<sql_analyzer_result_kind::diagnostics>();
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].code(), sql_analyzer_code::memory_budget_exceeded);
+}
+
+TEST_F(sql_analyzer_test, memory_budget_sufficient) {
+    install_table("t");
+    options_.memory_budget() = 1024 * 1024;
+    options_.enable_metrics() = true;
+
+    sql_analyzer analyzer;
+    auto result = analyzer(
+            options_,
+            // SELECT * FROM t;
+            ast::statement::select_statement {
+                    ast::query::query {
+                            {
+                                    ast::query::select_asterisk {},
+                            },
+                            {
+                                    ast::table::table_reference { id("t") },
+                            },
+                    }
+            }
+    );
+    ASSERT_TRUE(result) << diagnostics();
+
+    auto&& metrics = result.metrics();
+    ASSERT_TRUE(metrics);
+    EXPECT_GT(metrics->memory_usage(), 0);
+    EXPECT_LE(metrics->memory_usage(), options_.memory_budget());
+}
+
+TEST_F(sql_analyzer_test, prepare) {
+    install_table("t");
+    auto x = host_parameters_.add({ "x", ttype::int8 {} });
+    auto y = host_parameters_.add({ "y", ttype::character { ttype::varying } });
+    host_parameters_.add({ "z", ttype::int8 {} });
+
+    sql_analyzer analyzer;
+    auto prepared = analyzer.prepare(
+            options_,
+            // INSERT INTO t (k, v, w) VALUES (:x, :y, :x)
+            ast::statement::insert_statement {
+                    id("t"),
+                    {
+                            id("k"),
+                            id("v"),
+                            id("w"),
+                    },
+                    ast::query::table_value_constructor {
+                            ast::scalar::value_constructor {
+                                    ast::scalar::host_parameter_reference { id(":x") },
+                                    ast::scalar::host_parameter_reference { id(":y") },
+                                    ast::scalar::host_parameter_reference { id(":x") },
+                            },
+                    },
+            },
+            {},
+            {},
+            host_parameters_);
+    ASSERT_TRUE(prepared);
+
+    auto parameters = prepared.parameters();
+    ASSERT_EQ(parameters.size(), 2);
+    EXPECT_EQ(parameters[0], x);
+    EXPECT_EQ(parameters[1], y);
+    EXPECT_EQ(prepared.find_parameter("y"), 1);
+    EXPECT_FALSE(prepared.find_parameter("z"));
+
+    placeholder_map values {};
+    values.add("x", { tvalue::int8 { 1 }, ttype::int8 {} });
+    values.add("y", { tvalue::character { "Y" }, ttype::character { ttype::varying } });
+
+    auto binding = prepared.bind(values);
+    ASSERT_TRUE(binding);
+    ASSERT_EQ(binding.values().size(), 2);
+    EXPECT_EQ(*binding.values()[0], tvalue::int8 { 1 });
+    EXPECT_EQ(*binding.values()[1], tvalue::character { "Y" });
+}
+
+TEST_F(sql_analyzer_test, prepare_bind_invalid) {
+    install_table("t");
+    host_parameters_.add({ "x", ttype::int8 {} });
+
+    sql_analyzer analyzer;
+    auto prepared = analyzer.prepare(
+            options_,
+            // INSERT INTO t (k) VALUES (:x)
+            ast::statement::insert_statement {
+                    id("t"),
+                    {
+                            id("k"),
+                    },
+                    ast::query::table_value_constructor {
+                            ast::scalar::value_constructor {
+                                    ast::scalar::host_parameter_reference { id(":x") },
+                            },
+                    },
+            },
+            {},
+            {},
+            host_parameters_);
+    ASSERT_TRUE(prepared);
+    {
+        auto binding = prepared.bind({});
+        ASSERT_FALSE(binding);
+        ASSERT_EQ(binding.diagnostics().size(), 1);
+        EXPECT_EQ(binding.diagnostics()[0].code(), sql_analyzer_code::variable_not_found);
+    }
+    {
+        placeholder_map values {};
+        values.add("x", { tvalue::int4 { 1 }, ttype::int4 {} });
+        auto binding = prepared.bind(values);
+        ASSERT_FALSE(binding);
+        ASSERT_EQ(binding.diagnostics().size(), 1);
+        EXPECT_EQ(binding.diagnostics()[0].code(), sql_analyzer_code::inconsistent_type);
+    }
+}
+
 } // namespace mizugaki::analyzer
@@ -0,0 +1,222 @@
+#include <mizugaki/ast/binary_format.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <takatori/serializer/json_printer.h>
+
+#include <mizugaki/parser/sql_parser.h>
+#include <mizugaki/parser/string_document.h>
+
+namespace mizugaki::ast::binary_format {
+
+class binary_format_test : public ::testing::Test {
+public:
+    static std::unique_ptr<compilation_unit> parse(std::string_view source) {
+        parser::sql_parser parser {};
+        auto result = parser("-", std::string { source });
+        if (!result) {
+            throw std::runtime_error(result.diagnostic().message());
+        }
+        return std::move(result.value());
+    }
+
+    static std::string to_json(compilation_unit const& unit) {
+        std::ostringstream out {};
+        ::takatori::serializer::json_printer printer { out };
+        printer << unit;
+        return out.str();
+    }
+
+    static std::vector<std::size_t> diff(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("different size");
+        }
+        std::vector<std::size_t> results {};
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i]) {
+                results.emplace_back(i);
+            }
+        }
+        return results;
+    }
+
+    static void round_trip(compilation_unit const& unit) {
+        auto data = encode(unit);
+        auto decoded = decode(data, unit.document());
+        ASSERT_TRUE(decoded);
+
+        EXPECT_EQ(*decoded, unit);
+        EXPECT_EQ(decoded->comments(), unit.comments());
+        EXPECT_EQ(decoded->document().get(), unit.document().get());
+
+        // regions are not a part of the node equivalence, so compare the encoded data again
+        EXPECT_EQ(encode(*decoded), data);
+        EXPECT_EQ(to_json(*decoded), to_json(unit));
+    }
+};
+
+TEST_F(binary_format_test, simple) {
+    auto unit = parse("SELECT * FROM T0");
+    round_trip(*unit);
+}
+
+TEST_F(binary_format_test, comments) {
+    auto unit = parse(R"(
+-- first
+SELECT a, b FROM T0 WHERE a = 1;
+/* second */
+INSERT INTO T0 (a, b) VALUES (1, 'x');
+)");
+    ASSERT_EQ(unit->comments().size(), 2);
+    round_trip(*unit);
+}
+
+TEST_F(binary_format_test, query) {
+    auto unit = parse(R"(
+WITH q (x, y) AS (SELECT a, b FROM T0)
+SELECT DISTINCT q.x AS k, COUNT(*), CASE WHEN y > 0 THEN 'p' ELSE 'n' END
+FROM q INNER JOIN T1 t ON q.x = t.a LEFT OUTER JOIN T2 USING (a)
+WHERE x BETWEEN 1 AND 2 AND y NOT LIKE 'a#%' ESCAPE '#' AND t.c IN (1, 2, 3)
+GROUP BY q.x
+HAVING COUNT(*) > 1
+ORDER BY k DESC NULLS LAST
+LIMIT 10;
+TABLE T0 UNION ALL TABLE T1;
+)");
+    round_trip(*unit);
+}
+
+TEST_F(binary_format_test, scalar) {
+    auto unit = parse(R"(
+SELECT
+    CAST(a AS VARCHAR(10)),
+    -b,
+    TRUE,
+    NULL,
+    1.5e3,
+    X'0F',
+    DATE '2020-01-02',
+    TIMESTAMP WITH TIME ZONE '2020-01-02 03:04:05+09:00',
+    INTERVAL '1',
+    :p,
+    ?
+FROM T0;
+)");
+    round_trip(*unit);
+}
+
+TEST_F(binary_format_test, statements) {
+    auto unit = parse(R"(
+CREATE TABLE t (
+    a BIGINT PRIMARY KEY,
+    b DECIMAL(18, 2) NOT NULL DEFAULT 0,
+    c CHAR(8),
+    d BIGINT GENERATED BY DEFAULT AS IDENTITY,
+    FOREIGN KEY (c) REFERENCES s (k) ON DELETE SET NULL
+);
+CREATE UNIQUE INDEX i ON t (b DESC, c);
+UPDATE t SET b = b + 1 WHERE a = 0;
+DELETE FROM t AS x WHERE x.a = 0;
+ALTER TABLE IF EXISTS t RENAME COLUMN c TO e;
+DROP TABLE t;
+)");
+    ASSERT_EQ(unit->statements().size(), 6);
+    round_trip(*unit);
+}
+
+TEST_F(binary_format_test, without_document) {
+    auto unit = parse("SELECT a FROM T0 WHERE a = 1");
+    auto data = encode(*unit);
+    auto decoded = decode(data);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(*decoded, *unit);
+    EXPECT_FALSE(decoded->document());
+}
+
+TEST_F(binary_format_test, document_mismatch) {
+    auto unit = parse("SELECT * FROM T0");
+    auto data = encode(*unit);
+    auto other = std::make_shared<parser::string_document>("other", "SELECT * FROM T0");
+    EXPECT_FALSE(decode(data, other));
+}
+
+TEST_F(binary_format_test, compact) {
+    auto unit = parse(R"(
+SELECT a, b, c FROM T0 WHERE a = 1 AND b = 2 AND c = 3;
+SELECT a, b, c FROM T1 WHERE a = 1 AND b = 2 AND c = 3;
+)");
+    auto data = encode(*unit);
+    EXPECT_LT(data.size(), to_json(*unit).size() / 2);
+}
+
+TEST_F(binary_format_test, broken) {
+    auto unit = parse("SELECT * FROM T0");
+    auto data = encode(*unit);
+
+    EXPECT_FALSE(decode(data.substr(0, data.size() - 1)));
+    EXPECT_FALSE(decode(data + '\0'));
+    EXPECT_FALSE(decode(std::string_view { data }.substr(0, magic.size())));
+}
+
+TEST_F(binary_format_test, broken_enum) {
+    auto data = encode(*parse("SELECT * FROM T0 WHERE a < 1"));
+    auto other = encode(*parse("SELECT * FROM T0 WHERE a > 1"));
+    auto positions = diff(data, other);
+    ASSERT_EQ(positions.size(), 1);
+
+    data[positions[0]] = '\x7f';
+    EXPECT_FALSE(decode(data));
+}
+
+TEST_F(binary_format_test, broken_drop_statement_kind) {
+    auto data = encode(*parse("DROP TABLE t"));
+    auto other = encode(*parse("DROP INDEX t"));
+    auto positions = diff(data, other);
+    // the node kind, and drop_statement::statement_kind
+    ASSERT_EQ(positions.size(), 2);
+
+    auto inconsistent = data;
+    inconsistent[positions[1]] = other[positions[1]];
+    EXPECT_FALSE(decode(inconsistent));
+
+    auto invalid = data;
+    invalid[positions[1]] = static_cast<char>(statement::kind::select_statement);
+    EXPECT_FALSE(decode(invalid));
+}
+
+TEST_F(binary_format_test, broken_node_kind) {
+    auto data = encode(*parse("SELECT a FROM T0"));
+    auto other = encode(*parse("SELECT 1 FROM T0"));
+    auto positions = diff(data, other);
+    ASSERT_FALSE(positions.empty());
+
+    data[positions[0]] = '\x7f';
+    EXPECT_FALSE(decode(data));
+}
+
+TEST_F(binary_format_test, tree_depth_limit) {
+    std::string source { "SELECT " };
+    for (std::size_t i = 0; i < 50; ++i) {
+        source += "NOT ";
+    }
+    source += "a FROM T0";
+    auto data = encode(*parse(source));
+
+    EXPECT_TRUE(decode(data));
+    EXPECT_TRUE(decode(data, {}, 0));
+    EXPECT_FALSE(decode(data, {}, 10));
+}
+
+TEST_F(binary_format_test, unsupported_version) {
+    auto unit = parse("SELECT * FROM T0");
+    auto data = encode(*unit);
+    data[magic.size()] = static_cast<char>(version + 1);
+    EXPECT_FALSE(decode(data));
+}
+
+} // namespace mizugaki::ast::binary_format
@@ -0,0 +1,101 @@
+#include <mizugaki/parser/mapped_document.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+#include <mizugaki/parser/sql_parser.h>
+
+#include "utils.h"
+
+namespace mizugaki::parser {
+
+class mapped_document_test : public ::testing::Test {
+public:
+    void SetUp() override {
+        path_ = std::filesystem::temp_directory_path()
+                / ("mizugaki-mapped_document_test-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+    }
+
+    void TearDown() override {
+        std::error_code ignored {};
+        std::filesystem::remove(path_, ignored);
+    }
+
+    std::string write(std::string_view contents) {
+        std::ofstream out { path_, std::ios::binary };
+        out << contents;
+        return path_.string();
+    }
+
+private:
+    std::filesystem::path path_ {};
+};
+
+TEST_F(mapped_document_test, simple) {
+    auto path = write("SELECT * FROM T0;");
+    mapped_document document { path };
+
+    EXPECT_EQ(document.location(), path);
+    EXPECT_EQ(document.size(), 17);
+    EXPECT_EQ(document.contents(0, 6), "SELECT");
+    EXPECT_EQ(document.contents(14, 100), "T0;");
+    EXPECT_EQ(document.contents(17, 1), "");
+}
+
+TEST_F(mapped_document_test, empty) {
+    auto path = write("");
+    mapped_document document { path };
+
+    EXPECT_EQ(document.size(), 0);
+    EXPECT_EQ(document.contents(0, 1), "");
+    EXPECT_EQ(document.line(1), "");
+}
+
+TEST_F(mapped_document_test, lines) {
+    auto path = write("SELECT *\r\nFROM T0\n\nWHERE x = 1");
+    mapped_document document { path };
+
+    EXPECT_EQ(document.line(0), "");
+    EXPECT_EQ(document.line(1), "SELECT *");
+    EXPECT_EQ(document.line(2), "FROM T0");
+    EXPECT_EQ(document.line(3), "");
+    EXPECT_EQ(document.line(4), "WHERE x = 1");
+    EXPECT_EQ(document.line(5), "");
+
+    auto p0 = document.position(0);
+    EXPECT_EQ(p0.line_number(), 1);
+    EXPECT_EQ(p0.column_number(), 1);
+
+    auto p1 = document.position(15);
+    EXPECT_EQ(p1.line_number(), 2);
+    EXPECT_EQ(p1.column_number(), 6);
+
+    auto p2 = document.position(19);
+    EXPECT_EQ(p2.line_number(), 4);
+    EXPECT_EQ(p2.column_number(), 1);
+}
+
+TEST_F(mapped_document_test, missing) {
+    auto path = (std::filesystem::temp_directory_path() / "mizugaki-mapped_document_test-missing").string();
+    EXPECT_THROW(mapped_document { path }, std::system_error);
+}
+
+TEST_F(mapped_document_test, parse) {
+    auto path = write("-- comment\nSELECT * FROM T0;\nSELECT * FROM T1;\n");
+    auto document = std::make_shared<mapped_document>(path);
+
+    sql_parser parser {};
+    auto result = parser(document);
+    ASSERT_TRUE(result) << testing::diagnostics(result);
+
+    auto&& unit = **result;
+    EXPECT_EQ(unit.statements().size(), 2);
+    ASSERT_EQ(unit.comments().size(), 1);
+    EXPECT_EQ(unit.document().get(), document.get());
+}
+
+} // namespace mizugaki::parser
@@ -281,4 +281,39 @@ TEST_F(sql_driver_test, leading_description_comment_disabled) {
     EXPECT_FALSE(result);
 }
 
+TEST_F(sql_driver_test, comment_mode_description) {
+    std::string src = "/*X*//**C*/A";
+    // ----------------0123456789012
+    auto driver = create(std::move(src));
+    driver.comment_mode() = sql_parser_comment_mode::description;
+
+    add_comment(driver, 0, 5);
+    auto description = add_comment(driver, 5, 6);
+    auto definition = add_separator(driver, 11, 1);
+    add_eof(driver);
+
+    auto comments = contents(driver, driver.comments());
+    ASSERT_EQ(comments.size(), 1);
+    EXPECT_EQ(comments[0], "/**C*/");
+
+    auto result = driver.leading_description_comment(definition);
+    EXPECT_EQ(result, description);
+}
+
+TEST_F(sql_driver_test, comment_mode_none) {
+    std::string src = "/**C*/A";
+    // ----------------01234567
+    auto driver = create(std::move(src));
+    driver.comment_mode() = sql_parser_comment_mode::none;
+
+    add_comment(driver, 0, 6);
+    auto definition = add_separator(driver, 6, 1);
+    add_eof(driver);
+
+    EXPECT_EQ(driver.comments().size(), 0);
+
+    auto result = driver.leading_description_comment(definition);
+    EXPECT_FALSE(result);
+}
+
 } // namespace mizugaki::parser
@@ -0,0 +1,90 @@
+#include <mizugaki/parser/sql_fingerprint.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <mizugaki/parser/sql_parser.h>
+#include <mizugaki/parser/string_document.h>
+
+namespace mizugaki::parser {
+
+class sql_fingerprint_test : public ::testing::Test {
+public:
+    static std::uint64_t fingerprint(std::string contents) {
+        sql_token_stream stream { std::make_shared<string_document>("-", std::move(contents)) };
+        return compute_sql_fingerprint(stream);
+    }
+};
+
+TEST_F(sql_fingerprint_test, simple) {
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("SELECT * FROM T0"));
+    EXPECT_NE(fingerprint("SELECT * FROM T0"), fingerprint("SELECT * FROM T1"));
+    EXPECT_NE(fingerprint("SELECT * FROM T0"), fingerprint("SELECT a FROM T0"));
+}
+
+TEST_F(sql_fingerprint_test, white_spaces) {
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("  SELECT\n*\tFROM   T0  "));
+}
+
+TEST_F(sql_fingerprint_test, comments) {
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("/* a */ SELECT * -- b\nFROM T0 -- c"));
+}
+
+TEST_F(sql_fingerprint_test, literals) {
+    auto expect = fingerprint("SELECT * FROM T0 WHERE a = 1 AND b = 'x'");
+    EXPECT_EQ(fingerprint("SELECT * FROM T0 WHERE a = 100 AND b = 'yyy'"), expect);
+    EXPECT_EQ(fingerprint("SELECT * FROM T0 WHERE a = 1.5E3 AND b = X'0f'"), expect);
+    EXPECT_EQ(fingerprint("SELECT * FROM T0 WHERE a = ? AND b = :b"), expect);
+    EXPECT_NE(fingerprint("SELECT * FROM T0 WHERE a = 1 OR b = 'x'"), expect);
+}
+
+TEST_F(sql_fingerprint_test, case_insensitive) {
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("select * from t0"));
+    EXPECT_NE(fingerprint(R"(SELECT * FROM "T0")"), fingerprint(R"(SELECT * FROM "t0")"));
+    EXPECT_NE(fingerprint(R"(SELECT * FROM "T0")"), fingerprint("SELECT * FROM T0"));
+}
+
+TEST_F(sql_fingerprint_test, trailing_semicolon) {
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("SELECT * FROM T0;"));
+    EXPECT_EQ(fingerprint("SELECT * FROM T0"), fingerprint("SELECT * FROM T0; ; -- a"));
+    EXPECT_NE(fingerprint("SELECT * FROM T0"), fingerprint("SELECT * FROM T0; SELECT * FROM T0"));
+}
+
+TEST_F(sql_fingerprint_test, range) {
+    auto document = std::make_shared<string_document>("-", "SELECT * FROM T0; SELECT * FROM T1");
+    sql_token_stream stream {};
+    stream.reset(document, { 18, 34 });
+    EXPECT_EQ(compute_sql_fingerprint(stream), fingerprint("SELECT * FROM T1"));
+}
+
+TEST_F(sql_fingerprint_test, parser_statistics) {
+    auto statistics = std::make_shared<statement_statistics>();
+    sql_parser parser {};
+    parser.options().statistics() = statistics;
+
+    ASSERT_TRUE(parser("-", "SELECT * FROM T0 WHERE a = 1"));
+    ASSERT_TRUE(parser("-", "select * from t0 where a = 2;"));
+    ASSERT_FALSE(parser("-", "SELECT * FROM"));
+
+    auto entries = statistics->snapshot();
+    ASSERT_EQ(entries.size(), 2);
+    for (auto&& entry : entries) {
+        if (entry.fingerprint() == fingerprint("SELECT * FROM T0 WHERE a = ?")) {
+            EXPECT_EQ(entry.calls(), 2);
+            EXPECT_EQ(entry.text_sample(), "SELECT * FROM T0 WHERE a = 1");
+            EXPECT_EQ(entry.parse_time().count(), 2);
+            EXPECT_GT(entry.max_tree_node_count(), 0);
+            EXPECT_GT(entry.max_tree_depth(), 0);
+            EXPECT_EQ(entry.total_tree_node_count(), entry.max_tree_node_count() * 2);
+            EXPECT_EQ(entry.parse_diagnostic_count(), 0);
+        } else {
+            EXPECT_EQ(entry.fingerprint(), fingerprint("SELECT * FROM"));
+            EXPECT_EQ(entry.calls(), 1);
+            EXPECT_EQ(entry.parse_diagnostic_count(), 1);
+        }
+    }
+}
+
+} // namespace mizugaki::parser
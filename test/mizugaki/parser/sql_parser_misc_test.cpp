@@ -141,6 +141,93 @@ TEST_F(sql_parser_misc_test, block_comment_unclosed) {
     EXPECT_FALSE(result);
 }
 
+TEST_F(sql_parser_misc_test, comment_mode_description) {
+    sql_parser parser;
+    parser.options().comment_mode() = sql_parser_comment_mode::description;
+    auto result = parser("-",
+R"(
+-- simple
+/* block */
+/** description */
+;
+)"
+    );
+    ASSERT_TRUE(result) << diagnostics(result);
+
+    auto&& unit = **result;
+    ASSERT_EQ(unit.comments().size(), 1);
+    EXPECT_EQ(comment(unit, 0), "/** description */");
+}
+
+TEST_F(sql_parser_misc_test, comment_mode_none) {
+    sql_parser parser;
+    parser.options().comment_mode() = sql_parser_comment_mode::none;
+    auto result = parser("-",
+R"(
+-- simple
+/* block */
+/** description */
+;
+)"
+    );
+    ASSERT_TRUE(result) << diagnostics(result);
+
+    auto&& unit = **result;
+    EXPECT_EQ(unit.comments().size(), 0);
+}
+
+TEST_F(sql_parser_misc_test, metrics) {
+    sql_parser parser;
+    parser.options().enable_metrics() = true;
+    auto result = parser("-", "SELECT 1;");
+    ASSERT_TRUE(result) << diagnostics(result);
+
+    auto&& metrics = result.metrics();
+    ASSERT_TRUE(metrics);
+    // SELECT, 1, ;, EOF
+    EXPECT_EQ(metrics->token_count(), 4);
+    EXPECT_GT(metrics->node_allocation_count(), 0);
+}
+
+TEST_F(sql_parser_misc_test, metrics_disabled) {
+    sql_parser parser;
+    auto result = parser("-", "SELECT 1;");
+    ASSERT_TRUE(result) << diagnostics(result);
+    EXPECT_FALSE(result.metrics());
+}
+
+TEST_F(sql_parser_misc_test, metrics_error) {
+    sql_parser parser;
+    parser.options().enable_metrics() = true;
+    auto result = parser("-", "SELECT ;");
+    ASSERT_FALSE(result);
+    EXPECT_TRUE(result.metrics());
+}
+
+TEST_F(sql_parser_misc_test, cancellation) {
+    auto token = cancellation_token::create();
+    sql_parser parser;
+    parser.options().cancellation() = token;
+    {
+        auto result = parser("-", "SELECT 1;");
+        ASSERT_TRUE(result) << diagnostics(result);
+    }
+    token.cancel();
+    {
+        auto result = parser("-", "SELECT 1;");
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.diagnostic().code(), sql_parser_code::cancelled);
+    }
+}
+
+TEST_F(sql_parser_misc_test, cancellation_deadline) {
+    sql_parser parser;
+    parser.options().cancellation() = cancellation_token::with_deadline(cancellation_token::clock::now());
+    auto result = parser("-", "SELECT 1;");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.diagnostic().code(), sql_parser_code::deadline_exceeded);
+}
+
 TEST_F(sql_parser_misc_test, delimited_identifier) {
     sql_parser parser;
     auto result = parser("-", R"(TABLE "TABLE";)");
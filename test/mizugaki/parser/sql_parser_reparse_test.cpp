@@ -0,0 +1,319 @@
+#include <mizugaki/parser/sql_parser.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include <mizugaki/ast/statement/select_statement.h>
+#include <mizugaki/ast/query/query.h>
+
+#include "utils.h"
+
+namespace mizugaki::parser {
+
+using namespace testing;
+
+class sql_parser_reparse_test : public ::testing::Test {
+public:
+    sql_parser parser_ {};
+
+    std::unique_ptr<ast::compilation_unit> parse(std::string contents) {
+        auto result = parser_("-", std::move(contents));
+        if (!result) {
+            throw std::runtime_error(diagnostics(result));
+        }
+        return std::move(result.value());
+    }
+
+    static std::string contents(ast::compilation_unit const& unit) {
+        return std::string { unit.document()->contents(0, unit.document()->size()) };
+    }
+
+    void check(sql_parser_result const& result) {
+        ASSERT_TRUE(result) << diagnostics(result);
+        auto&& unit = **result;
+        auto expect = parser_("-", contents(unit));
+        ASSERT_TRUE(expect) << diagnostics(expect);
+        EXPECT_EQ(unit, **expect);
+        ASSERT_EQ(unit.statements().size(), (*expect)->statements().size());
+        for (std::size_t i = 0; i < unit.statements().size(); ++i) {
+            EXPECT_EQ(unit.statements()[i]->region(), (*expect)->statements()[i]->region()) << i;
+        }
+        EXPECT_EQ(unit.comments(), (*expect)->comments());
+        EXPECT_EQ(result.tree_node_count(), expect.tree_node_count());
+        EXPECT_EQ(result.max_tree_depth(), expect.max_tree_depth());
+    }
+};
+
+TEST_F(sql_parser_reparse_test, simple) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1; SELECT * FROM T2");
+    auto const* s0 = previous->statements()[0].get();
+    auto const* s1 = previous->statements()[1].get();
+    auto const* s2 = previous->statements()[2].get();
+
+    // "T2" -> "T22"
+    auto result = parser_.reparse(previous, { 52, 0, "2" });
+    check(result);
+    EXPECT_EQ(contents(**result), "SELECT * FROM T0; SELECT * FROM T1; SELECT * FROM T22");
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 3);
+    EXPECT_EQ(statements[0].get(), s0);
+    EXPECT_EQ(statements[1].get(), s1);
+    EXPECT_NE(statements[2].get(), s2);
+}
+
+TEST_F(sql_parser_reparse_test, middle) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1; SELECT * FROM T2");
+    auto const* s0 = previous->statements()[0].get();
+    auto const* s1 = previous->statements()[1].get();
+    auto const* s2 = previous->statements()[2].get();
+
+    // "T1" -> "T10", and the following statement is shifted
+    auto result = parser_.reparse(previous, { 34, 0, "0" });
+    check(result);
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 3);
+    EXPECT_EQ(statements[0].get(), s0);
+    EXPECT_NE(statements[1].get(), s1);
+    EXPECT_EQ(statements[2].get(), s2);
+}
+
+TEST_F(sql_parser_reparse_test, edit_first_statement) {
+    auto previous = parse(
+            "SELECT * FROM T0 WHERE C0 = 1; "
+            "SELECT * FROM T1 WHERE C1 = 2; "
+            "SELECT * FROM T2; "
+            "SELECT * FROM T3");
+    auto const* s0 = previous->statements()[0].get();
+    auto const* s1 = previous->statements()[1].get();
+    auto const* s2 = previous->statements()[2].get();
+    auto const* s3 = previous->statements()[3].get();
+
+    // "T0" -> "T00", and the following statements are shifted
+    auto result = parser_.reparse(previous, { 16, 0, "0" });
+    check(result);
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 4);
+    EXPECT_NE(statements[0].get(), s0);
+    EXPECT_EQ(statements[1].get(), s1);
+    EXPECT_EQ(statements[2].get(), s2);
+    EXPECT_EQ(statements[3].get(), s3);
+
+    auto expect = parser_("-", contents(**result));
+    ASSERT_TRUE(expect) << diagnostics(expect);
+    auto&& shifted = downcast<query::query>(*downcast<statement::select_statement>(*statements[1]).expression());
+    auto&& parsed = downcast<query::query>(
+            *downcast<statement::select_statement>(*(*expect)->statements()[1]).expression());
+    EXPECT_EQ(shifted.region(), parsed.region());
+    EXPECT_EQ(shifted.where()->region(), parsed.where()->region());
+    EXPECT_EQ(shifted.from()[0]->region(), parsed.from()[0]->region());
+}
+
+TEST_F(sql_parser_reparse_test, remove_from_first_statement) {
+    auto previous = parse("SELECT * FROM T0 WHERE C0 = 1; /* a */ SELECT * FROM T1; SELECT * FROM T2 -- b\n");
+    auto const* s1 = previous->statements()[1].get();
+    auto const* s2 = previous->statements()[2].get();
+
+    // removes " WHERE C0 = 1"
+    auto result = parser_.reparse(previous, { 16, 13, "" });
+    check(result);
+    EXPECT_EQ(contents(**result), "SELECT * FROM T0; /* a */ SELECT * FROM T1; SELECT * FROM T2 -- b\n");
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 3);
+    EXPECT_EQ(statements[1].get(), s1);
+    EXPECT_EQ(statements[2].get(), s2);
+    EXPECT_EQ((*result)->comments().size(), 2);
+}
+
+TEST_F(sql_parser_reparse_test, split_statement) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1; SELECT * FROM T2");
+    auto const* s0 = previous->statements()[0].get();
+    auto const* s2 = previous->statements()[2].get();
+
+    auto result = parser_.reparse(previous, { 34, 0, "; DELETE FROM T3" });
+    check(result);
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 4);
+    EXPECT_EQ(statements[0].get(), s0);
+    EXPECT_EQ(statements[3].get(), s2);
+}
+
+TEST_F(sql_parser_reparse_test, comment_out_following) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+
+    // the following statement is no longer available
+    auto result = parser_.reparse(previous, { 16, 0, "; -- " });
+    check(result);
+    EXPECT_EQ((*result)->statements().size(), 1);
+}
+
+TEST_F(sql_parser_reparse_test, remove_separator) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+
+    // removes ";", and the following statement is not separated
+    auto result = parser_.reparse(previous, { 16, 1, "" });
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.diagnostic().code(), sql_parser_code::syntax_error);
+}
+
+TEST_F(sql_parser_reparse_test, unclosed_string) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1; SELECT 'a;' FROM T2");
+
+    // the string literal swallows the following separator
+    auto result = parser_.reparse(previous, { 14, 0, "'" });
+    ASSERT_FALSE(result);
+
+    auto expect = parser_("-", "SELECT * FROM 'T0; SELECT * FROM T1; SELECT 'a;' FROM T2");
+    ASSERT_FALSE(expect);
+    EXPECT_EQ(result.diagnostic().code(), expect.diagnostic().code());
+    EXPECT_EQ(result.diagnostic().region(), expect.diagnostic().region());
+}
+
+TEST_F(sql_parser_reparse_test, head) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+
+    // "SELECT" -> "SELECT DISTINCT"
+    auto result = parser_.reparse(previous, { 6, 0, " DISTINCT" });
+    check(result);
+    EXPECT_EQ(contents(**result), "SELECT DISTINCT * FROM T0; SELECT * FROM T1");
+}
+
+TEST_F(sql_parser_reparse_test, add_statement) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+    auto const* s0 = previous->statements()[0].get();
+
+    auto result = parser_.reparse(previous, { 34, 0, "; DELETE FROM T2" });
+    check(result);
+
+    auto&& statements = (*result)->statements();
+    ASSERT_EQ(statements.size(), 3);
+    EXPECT_EQ(statements[0].get(), s0);
+}
+
+TEST_F(sql_parser_reparse_test, remove_statement) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1; SELECT * FROM T2");
+
+    // removes "; SELECT * FROM T2"
+    auto result = parser_.reparse(previous, { 34, 18, "" });
+    check(result);
+    EXPECT_EQ((*result)->statements().size(), 2);
+}
+
+TEST_F(sql_parser_reparse_test, trailing_semicolon) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1;");
+
+    auto result = parser_.reparse(previous, { 35, 0, "\n" });
+    check(result);
+    EXPECT_EQ((*result)->statements().size(), 2);
+}
+
+TEST_F(sql_parser_reparse_test, comments) {
+    auto previous = parse(
+            "-- a\n"
+            "SELECT * FROM T0; /* b */\n"
+            "-- c\n"
+            "SELECT * FROM T1 -- d\n");
+
+    // "T1" -> "T11"
+    auto result = parser_.reparse(previous, { 52, 0, "1" });
+    check(result);
+    EXPECT_EQ((*result)->comments().size(), 4);
+}
+
+TEST_F(sql_parser_reparse_test, placeholders) {
+    auto previous = parse("SELECT * FROM T0 WHERE a = ?; SELECT * FROM T1 WHERE b = ?");
+
+    // "b" -> "bb"
+    auto result = parser_.reparse(previous, { 53, 0, "b" });
+    check(result);
+}
+
+TEST_F(sql_parser_reparse_test, placeholders_following) {
+    auto previous = parse("SELECT * FROM T0 WHERE a = 1; SELECT * FROM T1 WHERE b = ?");
+    auto const* s1 = previous->statements()[1].get();
+
+    // "a = 1" -> "a = ?", and the following placeholder index is changed
+    auto result = parser_.reparse(previous, { 27, 1, "?" });
+    check(result);
+    EXPECT_NE((*result)->statements()[1].get(), s1);
+}
+
+TEST_F(sql_parser_reparse_test, syntax_error) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+
+    // "T1" -> ""
+    auto result = parser_.reparse(previous, { 32, 2, "" });
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.diagnostic().code(), sql_parser_code::syntax_error);
+}
+
+TEST_F(sql_parser_reparse_test, retry_after_error) {
+    auto previous = parse("SELECT * FROM T0; SELECT * FROM T1");
+    auto const* s0 = previous->statements()[0].get();
+    auto const* s1 = previous->statements()[1].get();
+
+    // "T1" -> "T1 WHERE", which is still incomplete
+    auto error = parser_.reparse(previous, { 34, 0, " WHERE" });
+    ASSERT_FALSE(error);
+
+    // the previous unit is kept as is
+    ASSERT_TRUE(previous);
+    EXPECT_EQ(contents(*previous), "SELECT * FROM T0; SELECT * FROM T1");
+    ASSERT_EQ(previous->statements().size(), 2);
+    EXPECT_EQ(previous->statements()[0].get(), s0);
+    EXPECT_EQ(previous->statements()[1].get(), s1);
+
+    // "T1" -> "T1 WHERE a = 0", relative to the previous unit
+    auto result = parser_.reparse(previous, { 34, 0, " WHERE a = 0" });
+    check(result);
+    EXPECT_FALSE(previous);
+    EXPECT_EQ(contents(**result), "SELECT * FROM T0; SELECT * FROM T1 WHERE a = 0");
+    EXPECT_EQ((*result)->statements()[0].get(), s0);
+}
+
+TEST_F(sql_parser_reparse_test, tree_node_limit) {
+    auto previous = parse("SELECT a FROM T0; SELECT b FROM T1");
+    parser_.options().tree_node_limit() = 20;
+
+    auto const* s0 = previous->statements()[0].get();
+    auto r0 = previous->statements()[0]->region();
+    auto r1 = previous->statements()[1]->region();
+
+    // "b" -> "c, d, e, f, g, h, b"
+    auto result = parser_.reparse(previous, { 25, 0, "c, d, e, f, g, h, " });
+    EXPECT_FALSE(result);
+
+    // the reused statements are handed back to the previous unit
+    ASSERT_TRUE(previous);
+    ASSERT_EQ(previous->statements().size(), 2);
+    ASSERT_TRUE(previous->statements()[0]);
+    EXPECT_EQ(previous->statements()[0].get(), s0);
+    EXPECT_EQ(previous->statements()[0]->region(), r0);
+    ASSERT_TRUE(previous->statements()[1]);
+    EXPECT_EQ(previous->statements()[1]->region(), r1);
+}
+
+TEST_F(sql_parser_reparse_test, session) {
+    auto session = parser_.create_session();
+    auto result = session("-", "SELECT * FROM T0; SELECT * FROM T1");
+    ASSERT_TRUE(result) << diagnostics(result);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        result = session.reparse(result.value(), { 34, 0, "0" });
+        check(result);
+    }
+    EXPECT_EQ(contents(**result), "SELECT * FROM T0; SELECT * FROM T1000");
+}
+
+TEST_F(sql_parser_reparse_test, invalid_edit) {
+    auto previous = parse("SELECT * FROM T0");
+    EXPECT_THROW((void) parser_.reparse(previous, { 16, 1, "" }), std::invalid_argument);
+}
+
+} // namespace mizugaki::parser
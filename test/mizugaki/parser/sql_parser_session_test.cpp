@@ -0,0 +1,115 @@
+#include <mizugaki/parser/sql_parser_session.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+
+#include <mizugaki/parser/sql_parser.h>
+
+#include "utils.h"
+
+namespace mizugaki::parser {
+
+using namespace testing;
+
+class sql_parser_session_test : public ::testing::Test {};
+
+TEST_F(sql_parser_session_test, simple) {
+    sql_parser parser {};
+    auto session = parser.create_session();
+
+    std::array<std::string, 3> sources {
+            "SELECT * FROM T0",
+            "INSERT INTO T0 (a, b) VALUES (1, 'x')",
+            "UPDATE T0 SET a = 1 WHERE b = 2; DELETE FROM T1",
+    };
+    for (std::size_t round = 0; round < 2; ++round) {
+        for (auto&& source : sources) {
+            auto expect = parser("-", source);
+            ASSERT_TRUE(expect) << diagnostics(expect);
+
+            auto result = session("-", source);
+            ASSERT_TRUE(result) << diagnostics(result);
+            EXPECT_EQ(**result, **expect);
+        }
+    }
+}
+
+TEST_F(sql_parser_session_test, comments) {
+    sql_parser_session session {};
+    {
+        auto result = session("-", "-- a\nSELECT * FROM T0 -- b\n");
+        ASSERT_TRUE(result) << diagnostics(result);
+        EXPECT_EQ((*result)->comments().size(), 2);
+    }
+    {
+        auto result = session("-", "SELECT * FROM T0 /* c */");
+        ASSERT_TRUE(result) << diagnostics(result);
+        ASSERT_EQ((*result)->comments().size(), 1);
+        auto r = (*result)->comments()[0];
+        EXPECT_EQ((*result)->document()->contents(r.first(), r.size()), "/* c */");
+    }
+    {
+        auto result = session("-", "SELECT * FROM T0");
+        ASSERT_TRUE(result) << diagnostics(result);
+        EXPECT_EQ((*result)->comments().size(), 0);
+    }
+}
+
+TEST_F(sql_parser_session_test, after_error) {
+    sql_parser_session session {};
+    {
+        auto result = session("-", "SELECT * FROM");
+        EXPECT_FALSE(result);
+    }
+    {
+        auto result = session("-", "SELECT * FROM T0");
+        ASSERT_TRUE(result) << diagnostics(result);
+        EXPECT_EQ((*result)->statements().size(), 1);
+    }
+}
+
+TEST_F(sql_parser_session_test, after_unterminated_comment) {
+    sql_parser_session session {};
+    {
+        auto result = session("-", "SELECT * FROM T0 /* unterminated");
+        EXPECT_FALSE(result);
+    }
+    {
+        auto result = session("-", "SELECT * FROM T0");
+        ASSERT_TRUE(result) << diagnostics(result);
+        EXPECT_EQ((*result)->statements().size(), 1);
+        EXPECT_EQ((*result)->comments().size(), 0);
+    }
+}
+
+TEST_F(sql_parser_session_test, options) {
+    sql_parser_session session {};
+    session.options().tree_node_limit() = 3;
+    {
+        auto result = session("-", "SELECT a, b, c, d FROM T0");
+        EXPECT_FALSE(result);
+    }
+    session.options().tree_node_limit() = 0;
+    {
+        auto result = session("-", "SELECT a, b, c, d FROM T0");
+        ASSERT_TRUE(result) << diagnostics(result);
+    }
+}
+
+TEST_F(sql_parser_session_test, create_session_copies_options) {
+    sql_parser parser {};
+    parser.options().tree_node_limit() = 3;
+    parser.options().element_limits()[sql_parser_element_kind::statement] = 1;
+
+    auto session = parser.create_session();
+    EXPECT_EQ(session.options().tree_node_limit(), 3);
+    EXPECT_EQ(session.options().element_limits()[sql_parser_element_kind::statement], 1);
+
+    // the session has its own copy
+    session.options().element_limits()[sql_parser_element_kind::statement] = 2;
+    EXPECT_EQ(parser.options().element_limits()[sql_parser_element_kind::statement], 1);
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,160 @@
+#include <mizugaki/parser/sql_token_stream.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mizugaki/parser/string_document.h>
+
+namespace mizugaki::parser {
+
+class sql_token_stream_test : public ::testing::Test {
+public:
+    static std::shared_ptr<string_document> document(std::string contents) {
+        return std::make_shared<string_document>("-", std::move(contents));
+    }
+
+    static std::vector<std::pair<sql_token_kind, std::string>> tokens(sql_token_stream& stream) {
+        std::vector<std::pair<sql_token_kind, std::string>> result {};
+        while (true) {
+            auto token = stream.next();
+            if (token.kind() == sql_token_kind::end_of_file) {
+                break;
+            }
+            result.emplace_back(token.kind(), stream.image(token));
+        }
+        return result;
+    }
+
+    static std::vector<std::pair<sql_token_kind, std::string>> tokens(std::string contents) {
+        sql_token_stream stream { document(std::move(contents)) };
+        return tokens(stream);
+    }
+};
+
+using kind = sql_token_kind;
+
+TEST_F(sql_token_stream_test, simple) {
+    auto result = tokens("SELECT * FROM T0");
+    decltype(result) expect {
+            { kind::keyword, "SELECT" },
+            { kind::symbol, "*" },
+            { kind::keyword, "FROM" },
+            { kind::regular_identifier, "T0" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, literals) {
+    auto result = tokens("1 1.5 1.5E3 'a''b' X'0f'");
+    decltype(result) expect {
+            { kind::unsigned_integer, "1" },
+            { kind::exact_numeric_literal, "1.5" },
+            { kind::approximate_numeric_literal, "1.5E3" },
+            { kind::character_string_literal, "'a''b'" },
+            { kind::hex_string_literal, "X'0f'" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, names) {
+    auto result = tokens(R"(a "b" :c ? __d)");
+    decltype(result) expect {
+            { kind::regular_identifier, "a" },
+            { kind::delimited_identifier, R"("b")" },
+            { kind::host_parameter_name, ":c" },
+            { kind::placeholder, "?" },
+            { kind::regular_identifier, "__d" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, symbols) {
+    auto result = tokens("a <= b || c");
+    decltype(result) expect {
+            { kind::regular_identifier, "a" },
+            { kind::symbol, "<=" },
+            { kind::regular_identifier, "b" },
+            { kind::symbol, "||" },
+            { kind::regular_identifier, "c" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, comments) {
+    auto result = tokens("-- a\nSELECT /* b */ 1 -- c");
+    decltype(result) expect {
+            { kind::comment, "-- a" },
+            { kind::keyword, "SELECT" },
+            { kind::comment, "/* b */" },
+            { kind::unsigned_integer, "1" },
+            { kind::comment, "-- c" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, unclosed_comment) {
+    auto result = tokens("SELECT /* a");
+    decltype(result) expect {
+            { kind::keyword, "SELECT" },
+            { kind::unclosed_comment, "/*" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, error) {
+    auto result = tokens("a $ b");
+    decltype(result) expect {
+            { kind::regular_identifier, "a" },
+            { kind::error, "$" },
+            { kind::regular_identifier, "b" },
+    };
+    EXPECT_EQ(result, expect);
+}
+
+TEST_F(sql_token_stream_test, flags) {
+    sql_token_stream stream { document("'a' /* b */") };
+
+    auto t0 = stream.next();
+    EXPECT_TRUE(t0.is_literal());
+    EXPECT_FALSE(t0.is_comment());
+
+    auto t1 = stream.next();
+    EXPECT_FALSE(t1.is_literal());
+    EXPECT_TRUE(t1.is_comment());
+}
+
+TEST_F(sql_token_stream_test, end_of_file) {
+    sql_token_stream stream { document("a") };
+    EXPECT_EQ(stream.next().kind(), kind::regular_identifier);
+
+    auto t0 = stream.next();
+    EXPECT_EQ(t0.kind(), kind::end_of_file);
+    EXPECT_EQ(t0.region(), ast::node_region(1, 1));
+
+    auto t1 = stream.next();
+    EXPECT_EQ(t1.kind(), kind::end_of_file);
+}
+
+TEST_F(sql_token_stream_test, reset) {
+    sql_token_stream stream {};
+    EXPECT_EQ(stream.next().kind(), kind::end_of_file);
+
+    for (std::size_t round = 0; round < 2; ++round) {
+        stream.reset(document("SELECT /* a"));
+        EXPECT_EQ(tokens(stream).size(), 2);
+
+        stream.reset(document("-- b\nx"));
+        auto result = tokens(stream);
+        decltype(result) expect {
+                { kind::comment, "-- b" },
+                { kind::regular_identifier, "x" },
+        };
+        EXPECT_EQ(result, expect);
+    }
+}
+
+} // namespace mizugaki::parser
@@ -0,0 +1,86 @@
+#include <mizugaki/parser/string_document.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <takatori/util/downcast.h>
+
+#include <mizugaki/parser/sql_parser.h>
+
+#include "utils.h"
+
+namespace mizugaki::parser {
+
+class string_document_test : public ::testing::Test {};
+
+TEST_F(string_document_test, simple) {
+    string_document document { "-", "SELECT * FROM T0;" };
+
+    EXPECT_EQ(document.location(), "-");
+    EXPECT_EQ(document.size(), 17);
+    EXPECT_EQ(document.contents(0, 6), "SELECT");
+    EXPECT_EQ(document.contents(14, 100), "T0;");
+    EXPECT_EQ(document.contents(17, 1), "");
+    EXPECT_FALSE(document.lines().is_built());
+}
+
+TEST_F(string_document_test, lines) {
+    string_document document { "-", "SELECT *\r\nFROM T0\n\nWHERE x = 1\n" };
+
+    EXPECT_EQ(document.line(0), "");
+    EXPECT_EQ(document.line(1), "SELECT *");
+    EXPECT_EQ(document.line(2), "FROM T0");
+    EXPECT_EQ(document.line(3), "");
+    EXPECT_EQ(document.line(4), "WHERE x = 1");
+    EXPECT_EQ(document.line(5), "");
+    EXPECT_EQ(document.line(6), "");
+    EXPECT_TRUE(document.lines().is_built());
+}
+
+TEST_F(string_document_test, position) {
+    string_document document { "-", "SELECT *\r\nFROM T0\n\nWHERE x = 1" };
+
+    auto p0 = document.position(0);
+    EXPECT_EQ(p0.line_number(), 1);
+    EXPECT_EQ(p0.column_number(), 1);
+
+    auto p1 = document.position(9);
+    EXPECT_EQ(p1.line_number(), 1);
+    EXPECT_EQ(p1.column_number(), 10);
+
+    auto p2 = document.position(15);
+    EXPECT_EQ(p2.line_number(), 2);
+    EXPECT_EQ(p2.column_number(), 6);
+
+    auto p3 = document.position(18);
+    EXPECT_EQ(p3.line_number(), 3);
+    EXPECT_EQ(p3.column_number(), 1);
+
+    auto p4 = document.position(document.size());
+    EXPECT_EQ(p4.line_number(), 4);
+    EXPECT_EQ(p4.column_number(), 12);
+}
+
+TEST_F(string_document_test, parse_lazy) {
+    sql_parser parser {};
+    auto result = parser("-", "SELECT *\nFROM T0;\n");
+    ASSERT_TRUE(result) << testing::diagnostics(result);
+
+    auto&& document = testing::downcast<string_document>(*(*result)->document());
+    EXPECT_FALSE(document.lines().is_built());
+}
+
+TEST_F(string_document_test, parse_diagnostic) {
+    sql_parser parser {};
+    auto result = parser("-", "SELECT *\nFROM T0\nWHERE;\n");
+    ASSERT_FALSE(result);
+
+    auto&& diagnostic = result.diagnostic();
+    auto&& document = testing::downcast<string_document>(*diagnostic.document());
+    auto position = document.position(diagnostic.region().first());
+    EXPECT_EQ(position.line_number(), 3);
+    EXPECT_TRUE(document.lines().is_built());
+}
+
+} // namespace mizugaki::parser
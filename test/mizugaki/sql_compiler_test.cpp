@@ -0,0 +1,124 @@
+#include <mizugaki/sql_compiler.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include <takatori/type/primitive.h>
+
+#include <yugawara/variable/configurable_provider.h>
+
+#include "analyzer/details/test_parent.h"
+
+namespace mizugaki {
+
+class sql_compiler_test : public analyzer::details::test_parent {
+public:
+    sql_compiler create_compiler() {
+        return sql_compiler {
+                sql_compiler_options {
+                        options_,
+                        ::yugawara::compiler_options {},
+                },
+        };
+    }
+
+    static std::string diagnostics(sql_compiler_result const& result) {
+        std::ostringstream out {};
+        out << result.stage() << ": ";
+        if (result.parser_diagnostic()) {
+            out << result.parser_diagnostic().code() << " " << result.parser_diagnostic().message();
+        }
+        for (auto&& diagnostic : result.analyzer_diagnostics()) {
+            out << diagnostic;
+        }
+        for (auto&& diagnostic : result.compiled().diagnostics()) {
+            out << diagnostic;
+        }
+        return out.str();
+    }
+};
+
+TEST_F(sql_compiler_test, simple) {
+    install_table("t");
+    auto compiler = create_compiler();
+    auto result = compiler.compile("SELECT * FROM t;");
+    ASSERT_TRUE(result) << diagnostics(result);
+    EXPECT_EQ(result.stage(), sql_compiler_stage::compile);
+    ASSERT_TRUE(result.compilation_unit());
+    EXPECT_EQ(result.compilation_unit()->statements().size(), 1);
+
+    auto&& metrics = result.metrics();
+    EXPECT_GE(metrics.total_time(), metrics.parse_time() + metrics.analysis_time() + metrics.compile_time());
+}
+
+TEST_F(sql_compiler_test, reuse) {
+    install_table("t");
+    auto compiler = create_compiler();
+    for (std::size_t i = 0; i < 3; ++i) {
+        auto result = compiler.compile("SELECT k FROM t WHERE k = 1;");
+        ASSERT_TRUE(result) << diagnostics(result);
+    }
+    {
+        auto result = compiler.compile("UPDATE t SET v = 'x' WHERE k = 1;");
+        ASSERT_TRUE(result) << diagnostics(result);
+    }
+}
+
+TEST_F(sql_compiler_test, host_parameters) {
+    install_table("t");
+    auto variables = std::make_shared<::yugawara::variable::configurable_provider>();
+    variables->add({ "p", ::takatori::type::int8 {} });
+
+    sql_compiler compiler {
+            sql_compiler_options {
+                    options_,
+                    ::yugawara::compiler_options {},
+                    {},
+                    variables,
+            },
+    };
+    auto result = compiler.compile("SELECT * FROM t WHERE k = :p;");
+    ASSERT_TRUE(result) << diagnostics(result);
+}
+
+TEST_F(sql_compiler_test, parse_error) {
+    auto compiler = create_compiler();
+    auto result = compiler.compile("SELECT * FROM;");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.stage(), sql_compiler_stage::parse);
+    ASSERT_TRUE(result.parser_diagnostic());
+    EXPECT_FALSE(result.compilation_unit());
+    EXPECT_EQ(result.metrics().analysis_time(), sql_compiler_metrics::duration_type {});
+}
+
+TEST_F(sql_compiler_test, multiple_statements) {
+    install_table("t");
+    auto compiler = create_compiler();
+    auto result = compiler.compile("SELECT * FROM t; SELECT * FROM t;");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.stage(), sql_compiler_stage::parse);
+    EXPECT_EQ(result.parser_diagnostic().code(), parser::sql_parser_code::exceed_number_of_elements);
+}
+
+TEST_F(sql_compiler_test, empty_statement) {
+    auto compiler = create_compiler();
+    auto result = compiler.compile("");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.stage(), sql_compiler_stage::parse);
+    EXPECT_EQ(result.parser_diagnostic().code(), parser::sql_parser_code::unexpected_eof);
+}
+
+TEST_F(sql_compiler_test, analyze_error) {
+    auto compiler = create_compiler();
+    auto result = compiler.compile("SELECT * FROM missing;");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.stage(), sql_compiler_stage::analyze);
+    ASSERT_TRUE(result.compilation_unit());
+    ASSERT_FALSE(result.analyzer_diagnostics().empty());
+    EXPECT_EQ(result.analyzer_diagnostics()[0].code(), analyzer::sql_analyzer_code::table_not_found);
+    EXPECT_EQ(result.metrics().compile_time(), sql_compiler_metrics::duration_type {});
+}
+
+} // namespace mizugaki
@@ -0,0 +1,190 @@
+#include <mizugaki/statement_statistics.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mizugaki {
+
+using namespace std::chrono_literals;
+
+class statement_statistics_test : public ::testing::Test {
+public:
+    static statement_statistics_entry const* find(
+            std::vector<statement_statistics_entry> const& entries,
+            statement_statistics::fingerprint_type fingerprint) {
+        for (auto&& entry : entries) {
+            if (entry.fingerprint() == fingerprint) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(statement_statistics_test, latency) {
+    statement_latency latency {};
+    EXPECT_EQ(latency.count(), 0);
+    EXPECT_EQ(latency.p99(), 0ns);
+
+    for (std::size_t i = 1; i <= 100; ++i) {
+        latency.add(std::chrono::microseconds { i });
+    }
+    EXPECT_EQ(latency.count(), 100);
+    EXPECT_EQ(latency.total(), 5050us);
+    EXPECT_EQ(latency.min(), 1us);
+    EXPECT_EQ(latency.max(), 100us);
+    EXPECT_EQ(latency.mean(), 50500ns);
+
+    // approximated within about 25% of relative error
+    EXPECT_GE(latency.p99(), 99us);
+    EXPECT_LE(latency.p99(), 100us);
+    EXPECT_GE(latency.percentile(50), 50us);
+    EXPECT_LE(latency.percentile(50), 63us);
+    EXPECT_GE(latency.percentile(0), 1us);
+    EXPECT_LE(latency.percentile(0), 1280ns);
+    EXPECT_EQ(latency.percentile(100), 100us);
+}
+
+TEST_F(statement_statistics_test, latency_merge) {
+    statement_latency a {};
+    a.add(10ns);
+    a.add(20ns);
+
+    statement_latency b {};
+    b.add(5ns);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 3);
+    EXPECT_EQ(a.total(), 35ns);
+    EXPECT_EQ(a.min(), 5ns);
+    EXPECT_EQ(a.max(), 20ns);
+}
+
+TEST_F(statement_statistics_test, record) {
+    statement_statistics statistics {};
+    statistics.record_parse(1, "SELECT 1", 10us, 5, 3, 0);
+    statistics.record_parse(1, "SELECT 2", 20us, 7, 4, 0);
+    statistics.record_analysis(1, "SELECT 1", 30us, 1);
+    statistics.record_parse(2, "SELECT", 5us, 0, 0, 1);
+
+    auto entries = statistics.snapshot();
+    ASSERT_EQ(entries.size(), 2);
+
+    auto e1 = find(entries, 1);
+    ASSERT_TRUE(e1);
+    EXPECT_EQ(e1->text_sample(), "SELECT 1");
+    EXPECT_EQ(e1->calls(), 2);
+    EXPECT_EQ(e1->parse_time().count(), 2);
+    EXPECT_EQ(e1->parse_time().total(), 30us);
+    EXPECT_EQ(e1->analysis_time().count(), 1);
+    EXPECT_EQ(e1->total_tree_node_count(), 12);
+    EXPECT_EQ(e1->max_tree_node_count(), 7);
+    EXPECT_EQ(e1->max_tree_depth(), 4);
+    EXPECT_EQ(e1->parse_diagnostic_count(), 0);
+    EXPECT_EQ(e1->analysis_diagnostic_count(), 1);
+
+    auto e2 = find(entries, 2);
+    ASSERT_TRUE(e2);
+    EXPECT_EQ(e2->calls(), 1);
+    EXPECT_EQ(e2->parse_diagnostic_count(), 1);
+}
+
+TEST_F(statement_statistics_test, text_sample_truncated) {
+    statement_statistics statistics {};
+    std::string text(statement_statistics_entry::max_text_sample_length * 2, 'x');
+    statistics.record_analysis(1, text, 1us, 0);
+
+    auto entries = statistics.snapshot();
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].text_sample().size(), statement_statistics_entry::max_text_sample_length);
+}
+
+TEST_F(statement_statistics_test, bounded) {
+    statement_statistics statistics { 2 };
+    statistics.record_analysis(1, "a", 1us, 0);
+    statistics.record_analysis(2, "b", 1us, 0);
+    statistics.flush();
+    statistics.record_analysis(3, "c", 1us, 0);
+    statistics.record_analysis(3, "c", 1us, 0);
+    statistics.flush();
+    statistics.record_analysis(1, "a", 1us, 0);
+
+    auto entries = statistics.snapshot();
+    EXPECT_EQ(entries.size(), 2);
+    EXPECT_EQ(statistics.dropped_count(), 2);
+    ASSERT_TRUE(find(entries, 1));
+    EXPECT_EQ(find(entries, 1)->calls(), 2);
+}
+
+TEST_F(statement_statistics_test, flush_threshold) {
+    statement_statistics statistics { statement_statistics::default_max_entries, 2 };
+    std::promise<void> recorded {};
+    std::promise<void> checked {};
+    std::thread worker {
+            [&] {
+                statistics.record_analysis(1, "a", 1us, 0);
+                statistics.record_analysis(1, "a", 1us, 0);
+                statistics.record_analysis(1, "a", 1us, 0);
+                recorded.set_value();
+                checked.get_future().wait();
+            },
+    };
+    recorded.get_future().wait();
+    {
+        // only the first two records are merged
+        auto entries = statistics.snapshot();
+        ASSERT_EQ(entries.size(), 1);
+        EXPECT_EQ(entries[0].calls(), 2);
+    }
+    checked.set_value();
+    worker.join();
+    {
+        // the rest is merged at thread exit
+        auto entries = statistics.snapshot();
+        ASSERT_EQ(entries.size(), 1);
+        EXPECT_EQ(entries[0].calls(), 3);
+    }
+}
+
+TEST_F(statement_statistics_test, threads) {
+    statement_statistics statistics {};
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t record_count = 1'000;
+
+    std::vector<std::thread> workers {};
+    workers.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back([&] {
+            for (std::size_t j = 0; j < record_count; ++j) {
+                statistics.record_parse(j % 3, "x", 1us, 1, 1, 0);
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+
+    // pending records are merged at thread exit
+    auto entries = statistics.snapshot();
+    ASSERT_EQ(entries.size(), 3);
+    std::size_t calls = 0;
+    for (auto&& entry : entries) {
+        calls += entry.calls();
+    }
+    EXPECT_EQ(calls, thread_count * record_count);
+}
+
+TEST_F(statement_statistics_test, clear) {
+    statement_statistics statistics {};
+    statistics.record_analysis(1, "a", 1us, 0);
+    statistics.flush();
+    statistics.clear();
+    EXPECT_TRUE(statistics.snapshot().empty());
+}
+
+} // namespace mizugaki